@@ -0,0 +1,433 @@
+#include "Broaden.hpp"
+#include "Fft.hpp"
+#include "Parallel.hpp"
+#include "TextPlot.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+// --- Parsing ---
+
+static bool read_file(const std::string &path, std::string &out) {
+  FILE *f = std::fopen(path.c_str(), "rb");
+  if (!f)
+    return false;
+  out.clear();
+  char buf[1 << 16];
+  size_t n;
+  while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0)
+    out.append(buf, n);
+  std::fclose(f);
+  return true;
+}
+
+static bool parse_number(std::string_view s, double &value) {
+  if (!s.empty() && s.front() == '+')
+    s.remove_prefix(1);
+  const char *end = s.data() + s.size();
+  auto result = std::from_chars(s.data(), end, value);
+  return !s.empty() && result.ec == std::errc() && result.ptr == end;
+}
+
+// Number starting at line[pos] after blanks, advancing pos past it
+static bool number_at(std::string_view line, size_t &pos, double &value) {
+  while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t'))
+    ++pos;
+  if (pos < line.size() && line[pos] == '+')
+    ++pos;
+  auto result =
+      std::from_chars(line.data() + pos, line.data() + line.size(), value);
+  if (result.ec != std::errc())
+    return false;
+  pos = result.ptr - line.data();
+  return true;
+}
+
+// Value after "<key>" and '=' or ':' (blanks and a closing parenthesis
+// allowed in between)
+static bool value_after(std::string_view line, size_t pos, double &value) {
+  while (pos < line.size() &&
+         (line[pos] == ' ' || line[pos] == '\t' || line[pos] == ')'))
+    ++pos;
+  if (pos >= line.size() || (line[pos] != '=' && line[pos] != ':'))
+    return false;
+  return number_at(line, ++pos, value);
+}
+
+static bool word_start(std::string_view line, size_t pos) {
+  return pos == 0 || !std::isalnum(static_cast<unsigned char>(line[pos - 1]));
+}
+
+static bool word_end(std::string_view line, size_t pos) {
+  return pos >= line.size() ||
+         !std::isalnum(static_cast<unsigned char>(line[pos]));
+}
+
+// "f = 0.05" / "f=0.05" / "f: 0.05" in a lower-cased line
+static bool find_strength(std::string_view line, double &f) {
+  for (size_t pos = line.find('f'); pos != std::string_view::npos;
+       pos = line.find('f', pos + 1))
+    if (word_start(line, pos) && word_end(line, pos + 1) &&
+        value_after(line, pos + 1, f))
+      return true;
+  return false;
+}
+
+// "8.748 ev" or "w(ev) = 8.748" in a lower-cased line
+static bool find_energy(std::string_view line, double &energy) {
+  for (size_t pos = line.find("ev"); pos != std::string_view::npos;
+       pos = line.find("ev", pos + 1)) {
+    if (!word_start(line, pos) || !word_end(line, pos + 2))
+      continue;
+    if (value_after(line, pos + 2, energy))
+      return true;
+    size_t end = pos;
+    while (end > 0 && (line[end - 1] == ' ' || line[end - 1] == '\t'))
+      --end;
+    size_t start = end;
+    while (start > 0 && (std::isdigit(static_cast<unsigned char>(
+                             line[start - 1])) ||
+                         line[start - 1] == '.' || line[start - 1] == '-'))
+      --start;
+    if (start < end && parse_number(line.substr(start, end - start), energy))
+      return true;
+  }
+  return false;
+}
+
+// Fields of a line at commas and whitespace, trailing ':' dropped ("1:")
+static void split_fields(std::string_view line,
+                         std::vector<std::string_view> &fields) {
+  fields.clear();
+  size_t i = 0;
+  auto separator = [](char c) {
+    return c == ',' || c == ' ' || c == '\t' || c == '\r';
+  };
+  while (i < line.size()) {
+    while (i < line.size() && separator(line[i]))
+      ++i;
+    size_t j = i;
+    while (j < line.size() && !separator(line[j]))
+      ++j;
+    std::string_view field = line.substr(i, j - i);
+    if (!field.empty() && field.back() == ':')
+      field.remove_suffix(1);
+    if (!field.empty())
+      fields.push_back(field);
+    i = j;
+  }
+}
+
+// Columns of the energy (eV) and strength in a table header, or false.
+// "W (eV)" split at whitespace: units belong to the name before them.
+static bool parse_header(const std::vector<std::string_view> &fields,
+                         size_t &columns, int &energy_col,
+                         int &strength_col) {
+  std::vector<std::string> names;
+  for (auto field : fields) {
+    std::string name(field);
+    if (!names.empty() && name.front() == '(')
+      names.back() += name;
+    else
+      names.push_back(name);
+  }
+  int energy = -1, strength = -1;
+  for (size_t c = 0; c < names.size(); ++c) {
+    const std::string &name = names[c];
+    const size_t ev = name.find("ev");
+    if (energy < 0 && ev != std::string::npos && word_start(name, ev) &&
+        word_end(name, ev + 2))
+      energy = static_cast<int>(c);
+    else if (strength < 0 &&
+             (name == "f" || name.rfind("f(", 0) == 0 ||
+              name.rfind("osc", 0) == 0))
+      strength = static_cast<int>(c);
+  }
+  if (energy < 0 || strength < 0)
+    return false;
+  columns = names.size();
+  energy_col = energy;
+  strength_col = strength;
+  return true;
+}
+
+bool read_excitations(const std::string &path, std::vector<Excitation> &roots,
+                      std::string &error) {
+  std::string text;
+  if (!read_file(path, text)) {
+    error = "cannot open file";
+    return false;
+  }
+  std::transform(text.begin(), text.end(), text.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+
+  roots.clear();
+  std::vector<Excitation> pairs; // Two-column rows, used if nothing else is
+  std::vector<std::string_view> fields;
+  std::vector<double> row;
+  size_t columns = 0; // Of the current table, 0 outside one
+  int energy_col = -1, strength_col = -1;
+
+  const std::string_view all(text);
+  for (size_t pos = 0; pos < all.size();) {
+    size_t eol = all.find('\n', pos);
+    if (eol == std::string_view::npos)
+      eol = all.size();
+    const std::string_view line = all.substr(pos, eol - pos);
+    pos = eol + 1;
+
+    double energy, strength;
+    if (find_energy(line, energy) && find_strength(line, strength)) {
+      roots.push_back({energy, strength});
+      columns = 0;
+      continue;
+    }
+
+    split_fields(line, fields);
+    if (fields.empty() || fields[0].find_first_not_of("-=") ==
+                              std::string_view::npos)
+      continue; // Blank or a rule under a header
+    row.resize(fields.size());
+    bool numeric = true;
+    for (size_t c = 0; numeric && c < fields.size(); ++c)
+      numeric = parse_number(fields[c], row[c]);
+    if (!numeric) {
+      if (!parse_header(fields, columns, energy_col, strength_col))
+        columns = 0;
+      continue;
+    }
+    if (columns > 0 && row.size() == columns)
+      roots.push_back({row[energy_col], row[strength_col]});
+    else if (row.size() == 2)
+      pairs.push_back({row[0], row[1]});
+  }
+
+  if (roots.empty())
+    roots = pairs;
+  roots.erase(std::remove_if(roots.begin(), roots.end(),
+                             [](const Excitation &r) {
+                               return !(r.energy > 0) ||
+                                      !std::isfinite(r.strength);
+                             }),
+              roots.end());
+  if (roots.empty()) {
+    error = "no excitation energies (eV) with oscillator strengths found";
+    return false;
+  }
+  return true;
+}
+
+// --- Broadening ---
+
+static double gaussian_sigma(double fwhm) {
+  return fwhm / (2.0 * std::sqrt(2.0 * std::log(2.0)));
+}
+
+// Unit-area line shape at offset x (eV)
+static double line_shape(LineShape shape, double fwhm, double x) {
+  if (shape == LineShape::GAUSSIAN) {
+    const double sigma = gaussian_sigma(fwhm);
+    return std::exp(-0.5 * x * x / (sigma * sigma)) /
+           (sigma * std::sqrt(2.0 * M_PI));
+  }
+  const double gamma = 0.5 * fwhm;
+  return gamma / (M_PI * (x * x + gamma * gamma));
+}
+
+std::vector<std::vector<double>>
+broaden(const std::vector<std::vector<Excitation>> &sets, double lo, double hi,
+        size_t points, LineShape shape, double fwhm) {
+  std::vector<std::vector<double>> curves(sets.size(),
+                                          std::vector<double>(points, 0.0));
+  if (points < 2 || !(hi > lo) || sets.empty())
+    return curves;
+  const double step = (hi - lo) / (points - 1);
+
+  // A Gaussian is negligible beyond 8σ; a Lorentzian reaches across the grid
+  size_t reach = points - 1;
+  if (shape == LineShape::GAUSSIAN)
+    reach = std::min(reach, static_cast<size_t>(std::ceil(
+                                8.0 * gaussian_sigma(fwhm) / step)));
+  // Sticks are binned on the grid padded by `reach` on both sides, so roots
+  // just outside the window still add their tails to it; the transform is
+  // long enough that no stick wraps around onto an output point
+  const size_t padded = points + 2 * reach;
+  const size_t n = fft_size(padded + reach);
+  const auto twiddles = fft_twiddles(n);
+
+  std::vector<std::complex<double>> kernel(n);
+  for (size_t d = 0; d <= reach; ++d) {
+    const double g = line_shape(shape, fwhm, d * step);
+    kernel[d] = g;
+    if (d > 0)
+      kernel[n - d] = g;
+  }
+  fft_forward(kernel.data(), n, twiddles.data());
+
+  // Pairs of sets: real and imaginary part of one transform
+  parallel_for((sets.size() + 1) / 2, [&](size_t pair) {
+    std::vector<std::complex<double>> data(n);
+    for (size_t part = 0; part < 2; ++part) {
+      const size_t s = 2 * pair + part;
+      if (s >= sets.size())
+        break;
+      for (const auto &root : sets[s]) {
+        const double x = (root.energy - lo) / step + reach;
+        if (!(x >= 0) || x > padded - 1)
+          continue;
+        const size_t j = std::min(static_cast<size_t>(x), padded - 2);
+        const double frac = x - j;
+        auto *bins = reinterpret_cast<double *>(data.data());
+        bins[2 * j + part] += (1.0 - frac) * root.strength;
+        bins[2 * (j + 1) + part] += frac * root.strength;
+      }
+    }
+    fft_forward(data.data(), n, twiddles.data());
+    for (size_t j = 0; j < n; ++j)
+      data[j] *= kernel[j].real();
+    fft_inverse(data.data(), n, twiddles.data());
+    for (size_t part = 0; part < 2; ++part) {
+      const size_t s = 2 * pair + part;
+      if (s >= sets.size())
+        break;
+      for (size_t j = 0; j < points; ++j)
+        curves[s][j] =
+            (part ? data[j + reach].imag() : data[j + reach].real()) / n;
+    }
+  });
+  return curves;
+}
+
+// --- Broaden mode ---
+
+static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+int run_broaden(const std::vector<std::string> &files,
+                const BroadenOptions &options) {
+  const auto start = std::chrono::steady_clock::now();
+  const size_t count = files.size();
+  std::vector<std::vector<Excitation>> sets(count);
+  std::vector<std::string> errors(count);
+  std::vector<char> ok(count);
+  parallel_for(count, [&](size_t i) {
+    ok[i] = read_excitations(files[i], sets[i], errors[i]);
+  });
+  for (size_t i = 0; i < count; ++i)
+    if (!ok[i]) {
+      std::cerr << "Cannot read " << files[i] << ": " << errors[i]
+                << std::endl;
+      return 2;
+    }
+
+  // Grid: the requested range, or the roots with room for the line shape
+  double lo = options.min_energy, hi = options.max_energy;
+  double first = INFINITY, last = -INFINITY;
+  for (const auto &set : sets)
+    for (const auto &root : set) {
+      first = std::min(first, root.energy);
+      last = std::max(last, root.energy);
+    }
+  if (std::isnan(lo))
+    lo = std::max(0.0, first - 5.0 * options.fwhm);
+  if (std::isnan(hi))
+    hi = last + 5.0 * options.fwhm;
+  if (!(hi > lo)) {
+    std::cerr << "Empty energy range " << lo << " - " << hi << " eV"
+              << std::endl;
+    return 2;
+  }
+  const size_t points = std::max<size_t>(options.points, 2);
+  const double step = (hi - lo) / (points - 1);
+  if (options.fwhm < 2.0 * step)
+    std::fprintf(stderr,
+                 "Note: FWHM %.3g eV spans less than two grid steps (%.3g "
+                 "eV); raise -points for smooth lines\n",
+                 options.fwhm, step);
+
+  const auto curves =
+      broaden(sets, lo, hi, points, options.shape, options.fwhm);
+
+  // Legend, plot and strongest root of each file
+  const bool color = isatty(STDERR_FILENO);
+  static const char *PALETTE[] = {"\033[36m", "\033[33m", "\033[35m",
+                                  "\033[32m", "\033[31m", "\033[34m"};
+  std::vector<std::string> colors;
+  for (size_t i = 0; i < count && color; ++i)
+    colors.push_back(PALETTE[i % 6]);
+  for (size_t i = 0; i < count; ++i) {
+    const auto strongest = std::max_element(
+        sets[i].begin(), sets[i].end(),
+        [](const Excitation &a, const Excitation &b) {
+          return a.strength < b.strength;
+        });
+    std::fprintf(stderr,
+                 "%s━━%s %s: %zu roots, strongest %.3f eV (f = %.4f)\n",
+                 color ? colors[i].c_str() : "", color ? "\033[0m" : "",
+                 files[i].c_str(), sets[i].size(), strongest->energy,
+                 strongest->strength);
+  }
+
+  struct winsize ws {};
+  int columns = 80;
+  if (ioctl(STDERR_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 0)
+    columns = ws.ws_col;
+  const int width = std::max(std::min(columns, 120) - 10, 20);
+  // Largest value under each dot column, so narrow lines are not skipped
+  std::vector<std::vector<double>> shown(
+      count, std::vector<double>(2 * width, 0.0));
+  for (size_t i = 0; i < count; ++i)
+    for (size_t j = 0; j < points; ++j) {
+      const size_t x = j * shown[i].size() / points;
+      shown[i][x] = std::max(shown[i][x], curves[i][j]);
+    }
+  std::fprintf(stderr, "\n%s broadening, FWHM %g eV (f per eV)\n",
+               options.shape == LineShape::GAUSSIAN ? "Gaussian"
+                                                    : "Lorentzian",
+               options.fwhm);
+  for (const auto &line : plot_overlay(shown, width, 12, colors))
+    std::fprintf(stderr, "%s\n", line.c_str());
+  char left[32], right[32];
+  std::snprintf(left, sizeof(left), "%g", lo);
+  std::snprintf(right, sizeof(right), "%g eV", hi);
+  std::fprintf(stderr, "%8s%-*s%s\n", "", width + 1 - static_cast<int>(
+                                              std::strlen(right)),
+               left, right);
+  std::fprintf(stderr, "%zu points in %.1f ms\n", points, elapsed_ms(start));
+
+  if (!isatty(STDOUT_FILENO)) {
+    std::string out = "energy_eV";
+    for (const auto &file : files)
+      out += "," + file;
+    out += '\n';
+    // to_chars: a million rows through snprintf take longer than the
+    // broadening itself
+    char buf[32];
+    auto append = [&](double value, std::chars_format format, int precision) {
+      auto end =
+          std::to_chars(buf, buf + sizeof(buf), value, format, precision);
+      out.append(buf, end.ptr);
+    };
+    for (size_t j = 0; j < points; ++j) {
+      append(lo + j * step, std::chars_format::fixed, 6);
+      for (size_t i = 0; i < count; ++i) {
+        out += ',';
+        append(curves[i][j], std::chars_format::scientific, 6);
+      }
+      out += '\n';
+    }
+    std::fwrite(out.data(), 1, out.size(), stdout);
+  }
+  return 0;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// One root of a linear-response job
+struct Excitation {
+  double energy;   ///< eV
+  double strength; ///< Oscillator strength f
+};
+
+enum class LineShape { LORENTZIAN, GAUSSIAN };
+
+struct BroadenOptions {
+  LineShape shape = LineShape::LORENTZIAN;
+  double fwhm = 0.3;             ///< eV
+  double min_energy = NAN;       ///< eV; NaN spans the roots
+  double max_energy = NAN;       ///< eV; NaN spans the roots
+  size_t points = 4000;
+};
+
+/**
+ * \brief Read excitation energies and oscillator strengths from the output of
+ *        a response job.
+ *
+ * Three layouts are recognized: lines carrying both an energy in eV and an
+ * "f =" value ("W(eV) = 8.7481 ... f = 0.0520", "8.7481 eV ... f=0.0520"),
+ * tables under a header naming an eV column and an f (or "osc") column, and
+ * plain two-column files of energy (eV) and f.
+ *
+ * \returns false with `error` set if the file cannot be read or holds no
+ *          roots
+ */
+bool read_excitations(const std::string &path, std::vector<Excitation> &roots,
+                      std::string &error);
+
+/**
+ * \brief Broaden stick spectra onto the grid lo, lo + step, ..., hi as
+ *        Σ f_i g(E - E_i) with g of unit area (f per eV).
+ *
+ * Sticks are spread over their two nearest grid points and convolved with
+ * the sampled line shape by FFT, so the cost is O(points log points) whatever
+ * the number of roots. Two sets share each transform (one in the real part,
+ * one in the imaginary part; the kernel's transform is real). Sticks outside
+ * the grid still add their tails to it, as far out as the line shape is
+ * sampled (8σ for a Gaussian, the width of the grid for a Lorentzian).
+ *
+ * \returns One curve of `points` values per set
+ */
+std::vector<std::vector<double>>
+broaden(const std::vector<std::vector<Excitation>> &sets, double lo, double hi,
+        size_t points, LineShape shape, double fwhm);
+
+/**
+ * \brief Broaden the roots of each output file and plot the curves over each
+ *        other; when stdout is not a terminal, also write them to it as CSV.
+ *
+ * \returns Exit status: 0 on success, 2 if a file cannot be read
+ */
+int run_broaden(const std::vector<std::string> &files,
+                const BroadenOptions &options);
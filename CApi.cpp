@@ -0,0 +1,185 @@
+#include "qsee.h"
+#include "InputFile.hpp"
+#include "Render.hpp"
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+// The C handle owns the parsed file and the strings handed out for it
+struct qsee_file {
+  InputFileData data;
+  std::string formula;
+};
+
+// --- Errors ---
+
+static thread_local std::string last_error;
+
+static void set_error(const std::string &message) { last_error = message; }
+
+static std::string upper(const char *s) {
+  std::string out = s ? s : "";
+  for (char &c : out)
+    if (c >= 'a' && c <= 'z')
+      c -= 'a' - 'A';
+  return out;
+}
+
+// --- API ---
+
+extern "C" {
+
+int qsee_api_version(void) { return QSEE_API_VERSION; }
+
+const char *qsee_last_error(void) { return last_error.c_str(); }
+
+qsee_file *qsee_open(const char *path) {
+  if (!path) {
+    set_error("qsee_open: path is NULL");
+    return nullptr;
+  }
+  try {
+    std::unique_ptr<qsee_file> file(new qsee_file);
+    file->data = parse_inp_file(path);
+    if (!file->data.error.empty()) {
+      set_error(std::string(path) + ": " + file->data.error);
+      return nullptr;
+    }
+    file->formula = file->data.get_formula();
+    last_error.clear();
+    return file.release();
+  } catch (const std::exception &e) {
+    // Nothing may propagate through the C boundary
+    set_error(std::string(path) + ": " + e.what());
+    return nullptr;
+  }
+}
+
+void qsee_close(qsee_file *file) { delete file; }
+
+size_t qsee_atom_count(const qsee_file *file) {
+  return file ? file->data.atoms.size() : 0;
+}
+
+int qsee_atom(const qsee_file *file, size_t index, int *z, double xyz[3]) {
+  if (!file || index >= file->data.atoms.size())
+    return -1;
+  const Atom &atom = file->data.atoms[index];
+  if (z)
+    *z = atom.element;
+  if (xyz) {
+    xyz[0] = atom.x;
+    xyz[1] = atom.y;
+    xyz[2] = atom.z;
+  }
+  return 0;
+}
+
+int qsee_charge(const qsee_file *file) { return file ? file->data.charge : 0; }
+
+int qsee_multiplicity(const qsee_file *file) {
+  return file ? file->data.multiplicity : 1;
+}
+
+const char *qsee_formula(const qsee_file *file) {
+  return file ? file->formula.c_str() : "";
+}
+
+const char *qsee_title(const qsee_file *file) {
+  return file ? file->data.title.c_str() : "";
+}
+
+const char *qsee_get(const qsee_file *file, const char *section,
+                     const char *key) {
+  if (!file || !section || !key)
+    return nullptr;
+  const std::string s = upper(section), k = upper(key);
+  for (const auto &param : file->data.parameters)
+    if (param.section == s && param.key == k)
+      return param.value.c_str();
+  return nullptr;
+}
+
+size_t qsee_key_count(const qsee_file *file) {
+  return file ? file->data.parameters.size() : 0;
+}
+
+int qsee_key(const qsee_file *file, size_t index, const char **section,
+             const char **key, const char **value) {
+  if (!file || index >= file->data.parameters.size())
+    return -1;
+  const InputParameter &param = file->data.parameters[index];
+  if (section)
+    *section = param.section.c_str();
+  if (key)
+    *key = param.key.c_str();
+  if (value)
+    *value = param.value.c_str();
+  return 0;
+}
+
+void qsee_render_defaults(qsee_render_options *options) {
+  if (!options)
+    return;
+  std::memset(options, 0, sizeof(*options));
+  options->size = sizeof(*options);
+  options->view = QSEE_VIEW_ISOMETRIC;
+  options->zoom = 1.0;
+  options->antialias = 1;
+  options->supersample = 1;
+}
+
+int qsee_render(const qsee_file *file, const qsee_render_options *options,
+                uint8_t *rgba, int width, int height, size_t stride) {
+  if (!file || !rgba || width <= 0 || height <= 0 ||
+      stride < static_cast<size_t>(width) * 4) {
+    set_error("qsee_render: bad file, buffer or size");
+    return -1;
+  }
+
+  // Fields past what the caller's struct has keep their defaults
+  qsee_render_options o;
+  qsee_render_defaults(&o);
+  if (options)
+    std::memcpy(&o, options, std::min(options->size, sizeof(o)));
+  o.size = sizeof(o);
+  if (o.view < QSEE_VIEW_ISOMETRIC || o.view > QSEE_VIEW_YZ ||
+      (o.supersample != 1 && o.supersample != 2 && o.supersample != 4) ||
+      !(o.zoom > 0)) {
+    set_error("qsee_render: bad options");
+    return -1;
+  }
+
+  StillOptions still;
+  still.view = static_cast<ViewMode>(o.view); // Same order as ViewMode
+  still.angle = o.angle;
+  still.zoom = o.zoom;
+  still.antialias = o.antialias != 0;
+  still.supersample = o.supersample;
+  still.ambient_occlusion = o.ambient_occlusion != 0;
+  try {
+    std::vector<uint8_t> frame;
+    render_still(file->data.atoms, width, height, still, frame);
+    for (int y = 0; y < height; ++y)
+      std::memcpy(rgba + y * stride, &frame[(size_t)y * width * 4],
+                  (size_t)width * 4);
+  } catch (const std::bad_alloc &) {
+    set_error("qsee_render: out of memory");
+    return -1;
+  } catch (const std::exception &e) {
+    // Nothing may propagate through the C boundary (a frame too large for
+    // a vector, threads that cannot start)
+    set_error(std::string("qsee_render: ") + e.what());
+    return -1;
+  } catch (...) {
+    set_error("qsee_render: unknown error");
+    return -1;
+  }
+  return 0;
+}
+
+} // extern "C"
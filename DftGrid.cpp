@@ -0,0 +1,590 @@
+#include "DftGrid.hpp"
+#include "Elements.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <sstream>
+
+static constexpr double BOHR_PER_ANGSTROM = 1.0 / 0.52917721092;
+
+// --- Lebedev rules ---
+
+// One octahedral orbit of a Lebedev rule, in the generator notation of
+// Lebedev & Laikov (1999):
+//   1: (1, 0, 0)          6 points     4: (a, a, b)    24 points
+//   2: (0, s, s), s=1/√2  12 points    5: (a, b, 0)    24 points
+//   3: (s, s, s), s=1/√3  8 points     6: (a, b, c)    48 points
+// with b (and c) fixed by the point lying on the unit sphere.
+struct LebedevOrbit {
+  int code;
+  double a, b;
+  double weight; ///< Per point; a rule's weights sum to 1
+};
+
+static const LebedevOrbit LEBEDEV_6[] = {{1, 0, 0, 1.0 / 6.0}};
+
+static const LebedevOrbit LEBEDEV_14[] = {{1, 0, 0, 1.0 / 15.0},
+                                          {3, 0, 0, 3.0 / 40.0}};
+
+static const LebedevOrbit LEBEDEV_26[] = {
+    {1, 0, 0, 1.0 / 21.0}, {2, 0, 0, 4.0 / 105.0}, {3, 0, 0, 9.0 / 280.0}};
+
+static const LebedevOrbit LEBEDEV_38[] = {
+    {1, 0, 0, 1.0 / 105.0},
+    {3, 0, 0, 9.0 / 280.0},
+    {5, 4.5970084338098305e-01, 0, 1.0 / 35.0}};
+
+static const LebedevOrbit LEBEDEV_50[] = {
+    {1, 0, 0, 4.0 / 315.0},
+    {2, 0, 0, 64.0 / 2835.0},
+    {3, 0, 0, 27.0 / 1280.0},
+    {4, 3.0151134457776363e-01, 0, 14641.0 / 725760.0}};
+
+static const LebedevOrbit LEBEDEV_110[] = {
+    {1, 0, 0, 3.8282704949374720e-03},
+    {3, 0, 0, 9.7937375124874347e-03},
+    {4, 1.8511563534473835e-01, 0, 8.2117372831911131e-03},
+    {4, 3.9568947305594310e-01, 0, 9.5954713360709223e-03},
+    {4, 6.9042104838229224e-01, 0, 9.9428148911780874e-03},
+    {5, 4.7836902881215038e-01, 0, 9.6949963616630302e-03}};
+
+static const LebedevOrbit LEBEDEV_302[] = {
+    {1, 0, 0, 8.5459117251281505e-04},
+    {3, 0, 0, 3.5991192850255717e-03},
+    {4, 3.5156403455701052e-01, 0, 3.4497884243058830e-03},
+    {4, 6.5663294102196124e-01, 0, 3.6048226014198824e-03},
+    {4, 4.7290541325810048e-01, 0, 3.5767296617433674e-03},
+    {4, 9.6183085226147852e-02, 0, 2.3521014136891642e-03},
+    {4, 2.2196452362941779e-01, 0, 3.1089531224136749e-03},
+    {4, 7.0117664160895454e-01, 0, 3.6500458076772556e-03},
+    {5, 2.6441528870606629e-01, 0, 2.9823449631718041e-03},
+    {5, 5.7189558918789607e-01, 0, 3.6008209322164605e-03},
+    {6, 2.5100347517704674e-01, 8.0007274940739515e-01, 3.5715405542733870e-03},
+    {6, 1.2335485325833273e-01, 4.1277240831685308e-01, 3.3923122050061698e-03}};
+
+static const LebedevOrbit LEBEDEV_590[] = {
+    {1, 0, 0, 3.0951212953061872e-04},
+    {3, 0, 0, 1.8523796985974892e-03},
+    {4, 7.0409549382274694e-01, 0, 1.8717906392777439e-03},
+    {4, 6.8077440664552435e-01, 0, 1.8588125854383170e-03},
+    {4, 6.3725469392587519e-01, 0, 1.8520288282962130e-03},
+    {4, 5.0444197078003583e-01, 0, 1.8467159561512420e-03},
+    {4, 4.2157617840109668e-01, 0, 1.8184717781627689e-03},
+    {4, 3.3179207364721230e-01, 0, 1.7495646572811541e-03},
+    {4, 2.3847367014218870e-01, 0, 1.6172106472544111e-03},
+    {4, 1.4590364491577629e-01, 0, 1.3847372348516919e-03},
+    {4, 6.0950341155071974e-02, 0, 9.7643311650510501e-04},
+    {5, 6.1168434420098750e-01, 0, 1.8571611967740779e-03},
+    {5, 3.9647553481998582e-01, 0, 1.7051539963958641e-03},
+    {5, 1.7247820099077241e-01, 0, 1.3003216858860479e-03},
+    {6, 5.6102638086220602e-01, 3.5182809277335192e-01, 1.8428664729052860e-03},
+    {6, 4.7423928425519801e-01, 2.6347166559379498e-01, 1.8026589343774510e-03},
+    {6, 5.9841264978853803e-01, 1.8166408403602091e-01, 1.8498305604436600e-03},
+    {6, 3.7910354076955632e-01, 1.7207952256568781e-01, 1.7139045071067091e-03},
+    {6, 2.7786731905862438e-01, 8.2130215819325142e-02, 1.5552136033968079e-03},
+    {6, 5.0335642710751172e-01, 8.9992058420748755e-02, 1.8022391280085250e-03}};
+
+template <size_t N>
+static void expand_orbits(const LebedevOrbit (&orbits)[N],
+                          std::vector<double> &out) {
+  static const int perms[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2},
+                                  {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+  for (const LebedevOrbit &o : orbits) {
+    double g[3];
+    switch (o.code) {
+    case 1: g[0] = 1; g[1] = 0; g[2] = 0; break;
+    case 2: g[0] = 0; g[1] = g[2] = std::sqrt(0.5); break;
+    case 3: g[0] = g[1] = g[2] = std::sqrt(1.0 / 3.0); break;
+    case 4:
+      g[0] = g[1] = o.a;
+      g[2] = std::sqrt(1.0 - 2.0 * o.a * o.a);
+      break;
+    case 5: g[0] = o.a; g[1] = std::sqrt(1.0 - o.a * o.a); g[2] = 0; break;
+    default:
+      g[0] = o.a;
+      g[1] = o.b;
+      g[2] = std::sqrt(1.0 - o.a * o.a - o.b * o.b);
+    }
+
+    // Distinct permutations of the generator, then every sign of its
+    // non-zero components
+    double seen[6][3];
+    int distinct = 0;
+    for (const auto &p : perms) {
+      const double v[3] = {g[p[0]], g[p[1]], g[p[2]]};
+      bool repeat = false;
+      for (int k = 0; k < distinct; ++k)
+        repeat |= seen[k][0] == v[0] && seen[k][1] == v[1] && seen[k][2] == v[2];
+      if (repeat)
+        continue;
+      std::copy(v, v + 3, seen[distinct++]);
+      for (int signs = 0; signs < 8; ++signs) {
+        bool skip = false;
+        double s[3];
+        for (int d = 0; d < 3; ++d) {
+          const bool flip = signs >> d & 1;
+          skip |= flip && v[d] == 0.0;
+          s[d] = flip ? -v[d] : v[d];
+        }
+        if (skip)
+          continue;
+        out.insert(out.end(), {s[0], s[1], s[2], o.weight});
+      }
+    }
+  }
+}
+
+std::vector<double> lebedev_rule(int n) {
+  std::vector<double> rule;
+  rule.reserve(4 * static_cast<size_t>(std::max(n, 0)));
+  switch (n) {
+  case 6: expand_orbits(LEBEDEV_6, rule); break;
+  case 14: expand_orbits(LEBEDEV_14, rule); break;
+  case 26: expand_orbits(LEBEDEV_26, rule); break;
+  case 38: expand_orbits(LEBEDEV_38, rule); break;
+  case 50: expand_orbits(LEBEDEV_50, rule); break;
+  case 110: expand_orbits(LEBEDEV_110, rule); break;
+  case 302: expand_orbits(LEBEDEV_302, rule); break;
+  case 590: expand_orbits(LEBEDEV_590, rule); break;
+  }
+  return rule;
+}
+
+// --- Radial quadratures ---
+
+// Size-adjusting radius of an element in Bohr. The covalent radius stands in
+// for the Bragg-Slater radius (they differ by ~10% for the light elements).
+static double atomic_radius(uint8_t z) {
+  return elements::get(z).covalent_radius * BOHR_PER_ANGSTROM;
+}
+
+// (r, weight) pairs on (0, inf); the weights include the r^2 Jacobian
+static std::vector<std::pair<double, double>>
+radial_rule(const std::string &scheme, int n, uint8_t z) {
+  std::vector<std::pair<double, double>> rule;
+  rule.reserve(n);
+  if (scheme == "MURAKNOWLES") {
+    // Mura & Knowles (1996): r = -alpha ln(1 - x^3), alpha = 7 (5 for the
+    // alkali and alkaline earth metals)
+    const bool s_block = z == 3 || z == 4 || z == 11 || z == 12 ||
+                         z == 19 || z == 20 || z == 37 || z == 38 ||
+                         z == 55 || z == 56;
+    const double alpha = s_block ? 5.0 : 7.0;
+    for (int i = 1; i <= n; ++i) {
+      const double x = (i - 0.5) / n;
+      const double x3 = x * x * x;
+      const double r = -alpha * std::log(1.0 - x3);
+      const double dr = 3.0 * alpha * x * x / (1.0 - x3) / n;
+      rule.emplace_back(r, dr * r * r);
+    }
+  } else if (scheme == "TREUTLERALDRICHS") {
+    // Treutler & Ahlrichs (1995) M4 mapping of Chebyshev (second kind)
+    // nodes, alpha = 0.6 and xi = 1
+    const double xi = 1.0, alpha = 0.6;
+    for (int i = 1; i <= n; ++i) {
+      const double t = i * M_PI / (n + 1);
+      const double x = std::cos(t);
+      const double w = M_PI / (n + 1) * std::sin(t);
+      const double r =
+          xi / M_LN2 * std::pow(1.0 + x, alpha) * std::log(2.0 / (1.0 - x));
+      const double dr =
+          xi / M_LN2 *
+          (alpha * std::pow(1.0 + x, alpha - 1.0) * std::log(2.0 / (1.0 - x)) +
+           std::pow(1.0 + x, alpha) / (1.0 - x));
+      rule.emplace_back(r, w * dr * r * r);
+    }
+    std::reverse(rule.begin(), rule.end()); // Innermost first
+  } else {
+    // Murray, Handy & Laming (1993) Euler-Maclaurin: r = R x^2 / (1 - x)^2
+    const double R = atomic_radius(z);
+    for (int i = 1; i <= n; ++i) {
+      const double x = static_cast<double>(i) / (n + 1);
+      const double r = R * x * x / ((1.0 - x) * (1.0 - x));
+      const double dr = 2.0 * R * x / std::pow(1.0 - x, 3) / (n + 1);
+      rule.emplace_back(r, dr * r * r);
+    }
+  }
+  return rule;
+}
+
+// Angular size of radial shell i (of n) at radius r. TREUTLER follows
+// Treutler & Ahlrichs (inner third 14 points, up to half 50); ROBUST prunes
+// by distance from the nucleus relative to the atomic radius R.
+static int pruned_angular(const std::string &pruning, int angular, int i,
+                          int n, double r, double R) {
+  int size = angular;
+  if (pruning == "TREUTLER") {
+    if (3 * i < n)
+      size = 14;
+    else if (2 * i < n)
+      size = 50;
+  } else if (pruning == "ROBUST") {
+    if (r < 0.25 * R)
+      size = 26;
+    else if (r < 0.5 * R)
+      size = 50;
+  }
+  return std::min(size, angular);
+}
+
+// --- Partition weights ---
+
+static inline double becke_cell(double mu) {
+  for (int k = 0; k < 3; ++k)
+    mu = 1.5 * mu - 0.5 * mu * mu * mu;
+  return 0.5 * (1.0 - mu);
+}
+
+// Stratmann, Scuseria & Frisch (1996) step function, exactly 0 or 1 outside
+// |mu| < a
+static constexpr double SSF_A = 0.64;
+
+static inline double ssf_cell(double mu) {
+  if (mu <= -SSF_A)
+    return 1.0;
+  if (mu >= SSF_A)
+    return 0.0;
+  const double x = mu / SSF_A, x2 = x * x;
+  const double g =
+      x * (35.0 + x2 * (-35.0 + x2 * (21.0 - 5.0 * x2))) / 16.0;
+  return 0.5 * (1.0 - g);
+}
+
+// Product of the cell functions of atom c against `others`, given each
+// atom's distance to the point
+template <typename Cell>
+static double cell_product(const std::vector<Atom> &nuclei, uint32_t c,
+                           const std::vector<uint32_t> &others,
+                           const std::vector<double> &dist, Cell cell) {
+  const Atom &ac = nuclei[c];
+  double product = 1.0;
+  for (uint32_t d : others) {
+    if (d == c)
+      continue;
+    const Atom &ad = nuclei[d];
+    const double dx = ac.x - ad.x, dy = ac.y - ad.y, dz = ac.z - ad.z;
+    const double mu =
+        (dist[c] - dist[d]) / std::sqrt(dx * dx + dy * dy + dz * dz);
+    product *= cell(mu);
+    if (product == 0.0)
+      break;
+  }
+  return product;
+}
+
+// --- Batching ---
+
+// Split points[begin, end) into octants around the center of its bounding
+// box until each piece holds at most `limit` points
+static void octree_batches(std::vector<DftGridPoint> &points, uint32_t atom,
+                           size_t begin, size_t end, size_t limit, int depth,
+                           std::vector<DftGridBatch> &out) {
+  if (begin == end)
+    return;
+  double lo[3] = {points[begin].x, points[begin].y, points[begin].z};
+  double hi[3] = {lo[0], lo[1], lo[2]};
+  for (size_t i = begin; i < end; ++i) {
+    const double v[3] = {points[i].x, points[i].y, points[i].z};
+    for (int d = 0; d < 3; ++d) {
+      lo[d] = std::min(lo[d], v[d]);
+      hi[d] = std::max(hi[d], v[d]);
+    }
+  }
+  const double extent =
+      std::max({hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]});
+  if (end - begin <= limit || depth >= 64 || extent == 0.0) {
+    out.push_back({atom, begin, end, extent});
+    return;
+  }
+
+  const double mid[3] = {(lo[0] + hi[0]) / 2, (lo[1] + hi[1]) / 2,
+                         (lo[2] + hi[2]) / 2};
+  auto octant = [&](const DftGridPoint &q) {
+    return (q.x >= mid[0]) | (q.y >= mid[1]) << 1 | (q.z >= mid[2]) << 2;
+  };
+  std::sort(points.begin() + begin, points.begin() + end,
+            [&](const DftGridPoint &a, const DftGridPoint &b) {
+              return octant(a) < octant(b);
+            });
+  size_t start = begin;
+  for (size_t i = begin + 1; i <= end; ++i)
+    if (i == end || octant(points[i]) != octant(points[start])) {
+      octree_batches(points, atom, start, i, limit, depth + 1, out);
+      start = i;
+    }
+}
+
+// --- Grid ---
+
+// (radial, angular) per GAUXC.GRID, as GauXC's AtomicGridSizeDefault
+static bool grid_size(const std::string &name, int &radial, int &angular) {
+  if (name == "FINE")
+    radial = 75, angular = 302;
+  else if (name == "ULTRAFINE")
+    radial = 99, angular = 590;
+  else if (name == "SUPERFINE")
+    radial = 250, angular = 974;
+  else if (name == "GM3")
+    radial = 35, angular = 110;
+  else if (name == "GM5")
+    radial = 50, angular = 302;
+  else
+    return false;
+  return true;
+}
+
+DftGrid build_dft_grid(const std::vector<Atom> &atoms,
+                       const DftGridOptions &options) {
+  const auto start = std::chrono::steady_clock::now();
+  DftGrid grid;
+  if (!grid_size(options.grid, grid.radial, grid.angular)) {
+    grid.notes.push_back("unknown GAUXC.GRID " + options.grid +
+                         ", using ULTRAFINE");
+    grid_size("ULTRAFINE", grid.radial, grid.angular);
+  }
+  if (lebedev_rule(grid.angular).empty()) {
+    grid.notes.push_back("no " + std::to_string(grid.angular) +
+                         "-point Lebedev rule here, using 590 (counts are low)");
+    grid.angular = 590;
+  }
+  const bool ssf = options.weights != "BECKE";
+  if (options.weights == "LKO")
+    grid.notes.push_back("LKO weights are approximated by SSF");
+
+  std::vector<Atom> nuclei = atoms;
+  for (Atom &a : nuclei) {
+    a.x *= BOHR_PER_ANGSTROM;
+    a.y *= BOHR_PER_ANGSTROM;
+    a.z *= BOHR_PER_ANGSTROM;
+  }
+  const size_t natoms = nuclei.size();
+  grid.atoms.resize(natoms);
+
+  // Raw atomic grids: radial x pruned Lebedev shells around each nucleus
+  std::map<int, std::vector<double>> angular_rules;
+  auto angular_rule = [&](int n) -> const std::vector<double> & {
+    std::vector<double> &rule = angular_rules[n];
+    if (rule.empty())
+      rule = lebedev_rule(n);
+    return rule;
+  };
+  std::vector<DftGridPoint> &points = grid.points;
+  std::vector<size_t> atom_begin(natoms + 1, 0);
+  for (size_t a = 0; a < natoms; ++a) {
+    const Atom &nucleus = nuclei[a];
+    const double R = atomic_radius(nucleus.element);
+    const auto radial = radial_rule(options.radial, grid.radial,
+                                    nucleus.element);
+    for (size_t i = 0; i < radial.size(); ++i) {
+      const auto [r, wr] = radial[i];
+      const std::vector<double> &ang = angular_rule(pruned_angular(
+          options.pruning, grid.angular, (int)i, grid.radial, r, R));
+      for (size_t k = 0; k < ang.size(); k += 4)
+        points.push_back({nucleus.x + r * ang[k], nucleus.y + r * ang[k + 1],
+                          nucleus.z + r * ang[k + 2],
+                          4.0 * M_PI * wr * ang[k + 3], (uint32_t)a});
+    }
+    grid.atoms[a].radial = grid.radial;
+    grid.atoms[a].raw = points.size() - atom_begin[a];
+    atom_begin[a + 1] = points.size();
+  }
+  grid.raw_points = points.size();
+
+  // Distance from each atom to its nearest neighbor, for the SSF test
+  const CellList cells(nuclei, 4.0);
+  std::vector<double> nearest(natoms, HUGE_VAL);
+  parallel_for(natoms, [&](size_t a) {
+    std::vector<uint32_t> near;
+    for (double radius = 8.0; near.size() < 2 && radius < 1e4; radius *= 4)
+      cells.query(nuclei[a].x, nuclei[a].y, nuclei[a].z, radius, near,
+                  nuclei);
+    for (uint32_t b : near)
+      if (b != a) {
+        const double dx = nuclei[a].x - nuclei[b].x,
+                     dy = nuclei[a].y - nuclei[b].y,
+                     dz = nuclei[a].z - nuclei[b].z;
+        nearest[a] = std::min(nearest[a], std::sqrt(dx * dx + dy * dy + dz * dz));
+      }
+  });
+
+  // Partition weights. With SSF, cell functions are exactly 1 or 0 beyond
+  // |mu| >= a, so only atoms within r_A (1 + a) / (1 - a) of the point can
+  // own part of it, and only atoms within that factor squared can change
+  // their cell products.
+  std::vector<uint32_t> all(natoms);
+  for (size_t a = 0; a < natoms; ++a)
+    all[a] = (uint32_t)a;
+  const double reach = (1.0 + SSF_A) / (1.0 - SSF_A);
+  const size_t chunk = 4096;
+  std::vector<uint8_t> settled(points.size(), 0);
+  parallel_for((points.size() + chunk - 1) / chunk, [&](size_t c) {
+    std::vector<uint32_t> owners, neighbors;
+    std::vector<double> dist(natoms, 0.0);
+    const size_t end = std::min(points.size(), (c + 1) * chunk);
+    for (size_t i = c * chunk; i < end; ++i) {
+      DftGridPoint &q = points[i];
+      const Atom &own = nuclei[q.atom];
+      const double p[3] = {q.x, q.y, q.z};
+      auto distance = [&](uint32_t b) {
+        const double dx = p[0] - nuclei[b].x, dy = p[1] - nuclei[b].y,
+                     dz = p[2] - nuclei[b].z;
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+      };
+      const double r_own =
+          std::sqrt((p[0] - own.x) * (p[0] - own.x) +
+                    (p[1] - own.y) * (p[1] - own.y) +
+                    (p[2] - own.z) * (p[2] - own.z));
+
+      double partition;
+      if (ssf) {
+        if (r_own < 0.5 * (1.0 - SSF_A) * nearest[q.atom]) {
+          settled[i] = 1; // Inside the atom's own sphere: weight 1
+          continue;
+        }
+        cells.query(p[0], p[1], p[2], r_own * reach, owners, nuclei);
+        for (uint32_t b : owners)
+          dist[b] = distance(b);
+        const double own_cell =
+            cell_product(nuclei, q.atom, owners, dist, ssf_cell);
+        if (own_cell == 0.0) {
+          settled[i] = 1;
+          q.weight = 0.0;
+          continue;
+        }
+        cells.query(p[0], p[1], p[2], r_own * reach * reach, neighbors,
+                    nuclei);
+        for (uint32_t b : neighbors)
+          dist[b] = distance(b);
+        double total = 0.0;
+        for (uint32_t b : owners)
+          total += b == q.atom
+                       ? own_cell
+                       : cell_product(nuclei, b, neighbors, dist, ssf_cell);
+        partition = own_cell / total;
+      } else {
+        for (uint32_t b : all)
+          dist[b] = distance(b);
+        double total = 0.0, own_cell = 0.0;
+        for (uint32_t b : all) {
+          const double cell = cell_product(nuclei, b, all, dist, becke_cell);
+          total += cell;
+          if (b == q.atom)
+            own_cell = cell;
+        }
+        partition = total > 0.0 ? own_cell / total : 0.0;
+      }
+      q.weight *= partition;
+    }
+  });
+  grid.screened_points = std::count(settled.begin(), settled.end(), 1);
+
+  // Drop vanishing points, then batch each atom's remainder
+  size_t kept = 0;
+  std::vector<size_t> kept_begin(natoms + 1, 0);
+  for (size_t a = 0; a < natoms; ++a) {
+    kept_begin[a] = kept;
+    for (size_t i = atom_begin[a]; i < atom_begin[a + 1]; ++i)
+      if (std::fabs(points[i].weight) > 1e-15)
+        points[kept++] = points[i];
+    grid.atoms[a].kept = kept - kept_begin[a];
+  }
+  kept_begin[natoms] = kept;
+  points.resize(kept);
+
+  std::vector<std::vector<DftGridBatch>> atom_batches(natoms);
+  parallel_for(natoms, [&](size_t a) {
+    octree_batches(points, (uint32_t)a, kept_begin[a], kept_begin[a + 1],
+                   std::max<size_t>(1, options.batch_size), 0,
+                   atom_batches[a]);
+  });
+  for (const auto &batches : atom_batches)
+    grid.batches.insert(grid.batches.end(), batches.begin(), batches.end());
+
+  // Accuracy check: a unit Gaussian on every nucleus integrates to pi^3/2
+  std::vector<double> partial((points.size() + chunk - 1) / chunk, 0.0);
+  parallel_for(partial.size(), [&](size_t c) {
+    std::vector<uint32_t> near;
+    const size_t end = std::min(points.size(), (c + 1) * chunk);
+    for (size_t i = c * chunk; i < end; ++i) {
+      const DftGridPoint &q = points[i];
+      cells.query(q.x, q.y, q.z, 6.5, near, nuclei); // exp(-42) is below eps
+      double value = 0.0;
+      for (uint32_t b : near) {
+        const double dx = q.x - nuclei[b].x, dy = q.y - nuclei[b].y,
+                     dz = q.z - nuclei[b].z;
+        value += std::exp(-(dx * dx + dy * dy + dz * dz));
+      }
+      partial[c] += q.weight * value;
+    }
+  });
+  double integral = 0.0;
+  for (double p : partial)
+    integral += p;
+  const double exact = natoms * std::pow(M_PI, 1.5);
+  grid.check_error = natoms ? std::fabs(integral - exact) / exact : 0.0;
+
+  grid.seconds = std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+  return grid;
+}
+
+std::string describe_dft_grid(const DftGrid &grid,
+                              const std::vector<Atom> &atoms,
+                              const DftGridOptions &options) {
+  std::ostringstream out;
+  char line[160];
+  std::snprintf(line, sizeof(line),
+                "Grid:      %s (%d radial x %d angular), %s pruning\n"
+                "Weights:   %s, %s radial quadrature\n",
+                options.grid.c_str(), grid.radial, grid.angular,
+                options.pruning.c_str(), options.weights.c_str(),
+                options.radial.c_str());
+  out << line;
+  for (const auto &note : grid.notes)
+    out << "! " << note << "\n";
+
+  out << "\n  Atom  El   Radial      Points        Kept\n";
+  for (size_t a = 0; a < atoms.size(); ++a) {
+    std::snprintf(line, sizeof(line), "  %4zu  %-3s  %6d  %10zu  %10zu\n",
+                  a + 1, elements::get(atoms[a].element).symbol,
+                  grid.atoms[a].radial, grid.atoms[a].raw,
+                  grid.atoms[a].kept);
+    out << line;
+  }
+  std::snprintf(line, sizeof(line), "  Total            %12zu  %10zu\n\n",
+                grid.raw_points, grid.points.size());
+  out << line;
+
+  size_t smallest = grid.batches.empty() ? 0 : SIZE_MAX, largest = 0;
+  std::vector<double> edges;
+  for (const auto &b : grid.batches) {
+    smallest = std::min(smallest, b.end - b.begin);
+    largest = std::max(largest, b.end - b.begin);
+    edges.push_back(b.extent);
+  }
+  std::nth_element(edges.begin(), edges.begin() + edges.size() / 2,
+                   edges.end());
+  const double n_batches = std::max<size_t>(1, grid.batches.size());
+  std::snprintf(line, sizeof(line),
+                "Batches:   %zu (limit %zu): %zu min, %.0f mean, %zu max "
+                "points, %.2f bohr median edge\n",
+                grid.batches.size(), options.batch_size, smallest,
+                grid.points.size() / n_batches, largest,
+                edges.empty() ? 0.0 : edges[edges.size() / 2]);
+  out << line;
+  std::snprintf(line, sizeof(line),
+                "Screening: %zu of %zu points settled without a full "
+                "partition product\n",
+                grid.screened_points, grid.raw_points);
+  out << line;
+  std::snprintf(line, sizeof(line),
+                "Check:     %.1e relative error on a unit Gaussian per atom\n"
+                "Built in:  %.3f s\n",
+                grid.check_error, grid.seconds);
+  out << line;
+  return out.str();
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Geometry.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Grid settings, named as in the GAUXC section
+ *        (input/gauxcopts.cxx) and defaulted the same way.
+ */
+struct DftGridOptions {
+  std::string grid = "ULTRAFINE";          ///< FINE, ULTRAFINE, SUPERFINE, GM3, GM5
+  std::string pruning = "UNPRUNED";        ///< UNPRUNED, ROBUST, TREUTLER
+  std::string radial = "MURRAYHANDYLAMING"; ///< or MURAKNOWLES, TREUTLERALDRICHS
+  std::string weights = "SSF";             ///< SSF or BECKE (LKO is run as SSF)
+  size_t batch_size = 512;                 ///< Max points per batch
+};
+
+struct DftGridPoint {
+  double x, y, z; ///< Bohr
+  double weight;  ///< Radial x angular x partition weight
+  uint32_t atom;  ///< Atom the point was generated around
+};
+
+struct DftGridAtom {
+  int radial = 0;      ///< Radial points
+  size_t raw = 0;      ///< Points after pruning, before partitioning
+  size_t kept = 0;     ///< Points with non-negligible partition weight
+};
+
+struct DftGridBatch {
+  uint32_t atom;
+  size_t begin, end; ///< Range in DftGrid::points
+  double extent;     ///< Longest edge of the bounding box (Bohr)
+};
+
+/**
+ * \brief Atom-centered molecular integration grid.
+ *
+ * Points are grouped by atom and, within an atom, by batch.
+ */
+struct DftGrid {
+  int radial = 0, angular = 0; ///< Nominal (unpruned) sizes per atom
+  std::vector<DftGridPoint> points;
+  std::vector<DftGridAtom> atoms;
+  std::vector<DftGridBatch> batches;
+  size_t raw_points = 0;      ///< Before partition screening
+  size_t screened_points = 0; ///< Weights settled without a full product
+  double check_error = 0;     ///< Relative error on sum_A exp(-|r - R_A|^2)
+  double seconds = 0;         ///< Wall time of the build
+  std::vector<std::string> notes;
+};
+
+/**
+ * \brief Angular rule with `n` points on the unit sphere (6, 14, 26, 38, 50,
+ *        110, 302 or 590), expanded from its octahedral orbits.
+ *
+ * \returns x, y, z, weight per point (weights sum to 1); empty if `n` is not
+ *          one of the tabulated sizes
+ */
+std::vector<double> lebedev_rule(int n);
+
+/**
+ * \brief Build the molecular grid for a geometry (Angstrom).
+ *
+ * Each atom gets a radial x Lebedev product grid, pruned per region, and
+ * every point is given its Becke or SSF partition weight. Weights are
+ * computed on all cores; for SSF, the atoms that can affect a point are
+ * found with a CellList, and points close to their own atom are settled by
+ * the Stratmann-Scuseria-Frisch screening test without any product. Points
+ * whose weight vanishes are dropped, and the rest of each atom is cut into
+ * octree batches of at most `batch_size` points.
+ */
+DftGrid build_dft_grid(const std::vector<Atom> &atoms,
+                       const DftGridOptions &options);
+
+// Multi-line summary: settings, per-atom counts and batch statistics
+std::string describe_dft_grid(const DftGrid &grid,
+                              const std::vector<Atom> &atoms,
+                              const DftGridOptions &options);
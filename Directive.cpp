@@ -0,0 +1,845 @@
+#include "Directive.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <regex>
+
+// Femtoseconds per atomic unit of time (physcon.hpp)
+static const double FS_PER_AU_TIME = 2.418884326505e-2;
+
+std::string Directive::get(const std::string &key) const {
+  for (const auto &kv : keys)
+    if (kv.first == key)
+      return kv.second;
+  return "";
+}
+
+// --- Helpers ---
+
+namespace {
+
+char upper_char(char c) { return (c >= 'a' && c <= 'z') ? c - ('a' - 'A') : c; }
+
+std::string upper(std::string_view s) {
+  std::string out(s);
+  for (char &c : out)
+    c = upper_char(c);
+  return out;
+}
+
+bool iequals(std::string_view a, std::string_view b) {
+  if (a.size() != b.size())
+    return false;
+  for (size_t i = 0; i < a.size(); ++i)
+    if (upper_char(a[i]) != upper_char(b[i]))
+      return false;
+  return true;
+}
+
+bool istarts_with(std::string_view s, std::string_view prefix) {
+  return s.size() >= prefix.size() && iequals(s.substr(0, prefix.size()), prefix);
+}
+
+std::string_view trim(std::string_view s) {
+  size_t first = s.find_first_not_of(" \t\r\n");
+  if (first == std::string_view::npos)
+    return s.substr(0, 0);
+  size_t last = s.find_last_not_of(" \t\r\n");
+  return s.substr(first, last - first + 1);
+}
+
+bool is_separator(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ',' || c == ';';
+}
+
+// Same digits as doubleToString in freeparsers.cxx (max_digits10)
+std::string format_double(double value) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.17g", value);
+  return buf;
+}
+
+// NUMBER UNIT, converted to atomic units of time
+bool parse_time(std::string_view s, double &au) {
+  double value;
+  auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+  if (ec != std::errc())
+    return false;
+  std::string_view unit = trim(s.substr(end - s.data()));
+  if (iequals(unit, "AS") || iequals(unit, "ATTOSECOND"))
+    au = value / (FS_PER_AU_TIME * 1.e3);
+  else if (iequals(unit, "FS") || iequals(unit, "FEMTOSECOND"))
+    au = value / FS_PER_AU_TIME;
+  else if (iequals(unit, "AU"))
+    au = value;
+  else
+    return false;
+  return true;
+}
+
+bool parse_count(std::string_view s, long &n) {
+  auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), n);
+  return ec == std::errc() && end == s.data() + s.size() && n >= 0;
+}
+
+// RT propagator names as spelled in the directive; nullptr if unknown
+const char *rt_algorithm(const std::string &name, bool allow_rk4) {
+  if (name == "MMUT" || name == "MODIFIEDMIDPOINT")
+    return "MMUT";
+  if (name == "FORWARDEULER" || name == "EULER")
+    return "FORWARDEULER";
+  if (name == "MAGNUS2" || name == "MAGNUSTWO" || name == "EXPLICITMAGNUS2" ||
+      name == "EXPLICITMAGNUSTWO")
+    return "MAGNUS2";
+  if (allow_rk4 && (name == "RK4" || name == "RUNGEKUTTAFOURTHORDER"))
+    return "RK4";
+  return nullptr;
+}
+
+// Reference functionals accepted by QM.REFERENCE (singleslateropts.cxx)
+const char *const METHODS[] = {"HF",       "SLATER", "B88",   "LSDA",
+                               "SVWN5",    "BLYP",   "PBEXPBEC", "B3LYP",
+                               "B3PW91",   "PBE0",   "BHANDHLYP", "BHANDH"};
+const char *const REFERENCE_PREFIXES[] = {"", "X2C", "RO", "2C", "4C", "R", "U", "G"};
+const char *const CI_METHODS[] = {"CASSCF", "RASSCF", "DASSCF",
+                                  "CASCI",  "RASCI",  "DASCI"};
+
+// Split METHOD into its relativistic/spin prefix and the bare method name.
+// CCSD variants are returned as-is for the caller to map onto HF + CC.
+bool split_method(std::string_view method, std::string &prefix,
+                  std::string &name) {
+  const std::string u = upper(method);
+  for (const char *p : REFERENCE_PREFIXES) {
+    std::string_view rest(u);
+    if (!istarts_with(rest, p))
+      continue;
+    rest.remove_prefix(std::char_traits<char>::length(p));
+    if (*p && !rest.empty() && rest.front() == '-')
+      rest.remove_prefix(1);
+    if (rest == "PBE") // PBE exchange + PBE correlation
+      rest = "PBEXPBEC";
+    bool known = rest == "CCSD" || rest == "CCSDT" || rest == "CCSD(T)";
+    for (const char *m : METHODS)
+      known = known || rest == m;
+    if (known) {
+      prefix = p;
+      name = std::string(rest);
+      return true;
+    }
+  }
+  return false;
+}
+
+// CD- and RI- only select the two-electron integral scheme
+std::string_view strip_density_fitting(std::string_view basis) {
+  if (basis.size() > 3 && (istarts_with(basis, "CD-") || istarts_with(basis, "RI-")))
+    basis.remove_prefix(3);
+  return basis;
+}
+
+bool looks_like_basis(std::string_view word) {
+  word = strip_density_fitting(word);
+  for (const char *p : {"STO-", "3-21", "6-31", "CC-P", "AUG-", "DEF2-", "ANO-"})
+    if (istarts_with(word, p))
+      return true;
+  return false;
+}
+
+struct Option {
+  std::string name;       ///< Upper-case word before '='
+  std::string_view text;  ///< Whole option, for messages
+  std::string_view value; ///< After '=', empty if none
+  bool has_value;
+};
+
+// Options inside a group, split at top-level ',', ';' and ':'
+std::vector<Option> split_options(std::string_view body) {
+  std::vector<Option> options;
+  int depth = 0;
+  size_t start = 0;
+  for (size_t i = 0; i <= body.size(); ++i) {
+    char c = i < body.size() ? body[i] : ',';
+    if (c == '(')
+      ++depth;
+    else if (c == ')')
+      depth = std::max(0, depth - 1);
+    if (depth || (c != ',' && c != ';' && c != ':'))
+      continue;
+    std::string_view text = trim(body.substr(start, i - start));
+    start = i + 1;
+    if (text.empty())
+      continue;
+    size_t eq = text.find('=');
+    Option opt;
+    opt.text = text;
+    opt.has_value = eq != std::string_view::npos;
+    opt.name = upper(trim(text.substr(0, eq)));
+    if (opt.has_value)
+      opt.value = trim(text.substr(eq + 1));
+    options.push_back(std::move(opt));
+  }
+  return options;
+}
+
+// --- Parser ---
+
+class Parser {
+
+public:
+  Parser(std::string_view text, Directive &out) : text_(text), out_(out) {}
+
+  void parse() {
+    const size_t n = text_.size();
+    size_t i = 0;
+    while (i < n) {
+      if (is_separator(text_[i])) {
+        ++i;
+        continue;
+      }
+      if (text_[i] == ')') {
+        issue(text_.substr(i, 1), "unmatched ')'");
+        ++i;
+        continue;
+      }
+
+      const size_t start = i;
+      while (i < n && !is_separator(text_[i]) && text_[i] != '(' && text_[i] != ')')
+        ++i;
+      std::string_view word = text_.substr(start, i - start);
+
+      if (i == n || text_[i] != '(') {
+        model(word);
+        continue;
+      }
+
+      // CCSD(T) is a method name, not a group
+      if (word.size() >= 4 && iequals(word.substr(word.size() - 4), "CCSD") &&
+          istarts_with(text_.substr(i), "(T)")) {
+        i += 3;
+        while (i < n && !is_separator(text_[i]) && text_[i] != '(')
+          ++i;
+        model(text_.substr(start, i - start));
+        continue;
+      }
+
+      const size_t open = i;
+      int depth = 0;
+      for (; i < n; ++i) {
+        if (text_[i] == '(')
+          ++depth;
+        else if (text_[i] == ')' && --depth == 0)
+          break;
+      }
+      std::string_view body;
+      if (i == n) {
+        issue(text_.substr(open, 1), "unclosed '(' after '" + std::string(word) + "'");
+        body = text_.substr(open + 1);
+      } else {
+        body = text_.substr(open + 1, i - open - 1);
+        ++i;
+      }
+      group(word, body);
+    }
+  }
+
+private:
+  std::string_view text_;
+  Directive &out_;
+
+  void issue(std::string_view at, std::string message) {
+    out_.issues.push_back(
+        {static_cast<size_t>(at.data() - text_.data()), std::move(message)});
+  }
+
+  // Later settings replace earlier ones, as addData does
+  void set(const std::string &key, std::string value) {
+    for (auto &kv : out_.keys)
+      if (kv.first == key) {
+        kv.second = std::move(value);
+        return;
+      }
+    out_.keys.emplace_back(key, std::move(value));
+  }
+
+  void unknown(const Option &opt, const char *group) {
+    issue(opt.text, std::string("unrecognized ") + group + " option '" +
+                        std::string(opt.text) + "'");
+  }
+
+  bool time_option(const Option &opt, double &au) {
+    if (parse_time(opt.value, au))
+      return true;
+    issue(opt.text, opt.name + " needs a time with a unit (as, fs or au)");
+    return false;
+  }
+
+  bool count_option(const Option &opt, long &n) {
+    if (parse_count(opt.value, n))
+      return true;
+    issue(opt.text, opt.name + " needs a whole number");
+    return false;
+  }
+
+  // METHOD[/BASIS], or either one alone
+  void model(std::string_view word) {
+    size_t slash = word.find('/');
+    std::string_view method = word.substr(0, slash);
+    std::string prefix, name;
+
+    if (slash == std::string_view::npos) {
+      if (split_method(method, prefix, name))
+        reference(prefix, name);
+      else if (iequals(word, "NEO"))
+        set("SCF.NEO", "TRUE");
+      else if (looks_like_basis(word))
+        set("BASIS.BASIS", std::string(strip_density_fitting(word)));
+      else
+        issue(word, "unrecognized '" + std::string(word) + "'");
+      return;
+    }
+
+    if (split_method(method, prefix, name))
+      reference(prefix, name);
+    else if (!method.empty())
+      issue(method, "unknown method '" + std::string(method) + "'");
+    std::string_view basis = strip_density_fitting(word.substr(slash + 1));
+    if (!basis.empty())
+      set("BASIS.BASIS", std::string(basis));
+  }
+
+  void reference(const std::string &prefix, const std::string &name) {
+    if (name.compare(0, 4, "CCSD") == 0) {
+      set("QM.REFERENCE", prefix + "HF");
+      set("QM.JOB", "CC");
+      set("CC.TYPE", name);
+    } else {
+      set("QM.REFERENCE", prefix + name);
+    }
+  }
+
+  void group(std::string_view word, std::string_view body) {
+    const std::string name = upper(word);
+    if (name.empty())
+      issue(body, "'(' without a group name");
+    else if (name == "SCF")
+      scf(body);
+    else if (name == "GUESS")
+      guess(body, false);
+    else if (name == "NEOGUESS")
+      guess(body, true);
+    else if (name == "RT" || name == "REALTIME")
+      rt(body);
+    else if (name == "FIELD")
+      field(body);
+    else if (name == "NEO")
+      neo(body);
+    else if (!is_ci(name))
+      issue(word, "unknown group '" + std::string(word) + "(...)'");
+  }
+
+  // [prefix-]CASSCF(...) and friends: accepted, no keys
+  static bool is_ci(const std::string &name) {
+    std::string_view rest(name);
+    for (const char *p : {"X2C", "2C", "4C", "G"})
+      if (istarts_with(rest, p)) {
+        rest.remove_prefix(std::char_traits<char>::length(p));
+        break;
+      }
+    if (!rest.empty() && rest.front() == '-')
+      rest.remove_prefix(1);
+    for (const char *m : CI_METHODS)
+      if (rest == m)
+        return true;
+    return false;
+  }
+
+  void scf(std::string_view body) {
+    std::string accuracy, diis, alg, maxiter;
+    bool energy_only = false;
+    for (const auto &opt : split_options(body)) {
+      const std::string &n = opt.name;
+      if (!opt.has_value) {
+        if (n == "ENERGYONLY" || n == "SKIP")
+          energy_only = true;
+        else if (n == "DIIS" || n == "CDIIS")
+          diis = "CDIIS";
+        else if (n == "NODIIS")
+          diis = "NONE";
+        else if (n == "EDIIS")
+          diis = "EDIIS";
+        else if (n == "QC")
+          alg = "NR";
+        else
+          unknown(opt, "SCF");
+      } else if (n == "ACCURACY") {
+        double value;
+        auto [end, ec] = std::from_chars(
+            opt.value.data(), opt.value.data() + opt.value.size(), value);
+        if (ec == std::errc() && end == opt.value.data() + opt.value.size())
+          accuracy = std::string(opt.value);
+        else
+          issue(opt.text, "ACCURACY needs a number");
+      } else if (n == "MAXSTEP" || n == "MAXSTEPS" || n == "MAXITERATION" ||
+                 n == "MAXITERATIONS" || n == "MAXCYCLE" || n == "MAXCYCLES" ||
+                 n == "MAXITER") {
+        long steps;
+        if (count_option(opt, steps))
+          maxiter = std::to_string(steps);
+      } else {
+        unknown(opt, "SCF");
+      }
+    }
+    if (!accuracy.empty())
+      set("SCF.ACCURACY", accuracy);
+    if (energy_only)
+      set("SCF.ENERGYONLY", "SKIP");
+    if (!diis.empty())
+      set("SCF.DIISALG", diis);
+    if (!alg.empty())
+      set("SCF.ALG", alg);
+    if (!maxiter.empty())
+      set("SCF.MAXITER", maxiter);
+  }
+
+  // [a|b]N-[a|b]M, homo-lumo or lumo-homo
+  static bool parse_swap(std::string_view v, char &spin, long &from, long &to) {
+    if (iequals(v, "HOMO-LUMO") || iequals(v, "LUMO-HOMO")) {
+      spin = 'A';
+      from = to = 0;
+      return true;
+    }
+    spin = 0;
+    if (!v.empty() && (upper_char(v[0]) == 'A' || upper_char(v[0]) == 'B')) {
+      spin = upper_char(v[0]);
+      v.remove_prefix(1);
+    }
+    size_t dash = v.find('-');
+    if (dash == std::string_view::npos || !parse_count(v.substr(0, dash), from))
+      return false;
+    std::string_view second = v.substr(dash + 1);
+    if (spin) {
+      if (second.empty() || upper_char(second[0]) != spin)
+        return false;
+      second.remove_prefix(1);
+    }
+    if (!spin)
+      spin = 'A';
+    return parse_count(second, to);
+  }
+
+  void guess(std::string_view body, bool neo) {
+    const char *type = nullptr;
+    std::vector<std::array<long, 2>> alpha, beta;
+    for (const auto &opt : split_options(body)) {
+      const std::string &n = opt.name;
+      if (!opt.has_value) {
+        if (n == "SAD" || n == "CORE")
+          type = n == "SAD" ? "SAD" : "CORE";
+        else if (n == "READ" || n == "READMO")
+          type = "READMO";
+        else if (n == "FCHK" || n == "FCHKMO")
+          type = "FCHKMO";
+        else if (neo && n == "CLASSICAL")
+          type = "CLASSICAL";
+        else
+          unknown(opt, neo ? "NEOGUESS" : "GUESS");
+      } else if (n == "SWAP") {
+        char spin;
+        long from, to;
+        if (!parse_swap(opt.value, spin, from, to))
+          issue(opt.text, "SWAP needs N-M, aN-aM, bN-bM or homo-lumo");
+        else
+          (spin == 'B' ? beta : alpha).push_back({from, to});
+      } else {
+        unknown(opt, neo ? "NEOGUESS" : "GUESS");
+      }
+    }
+
+    if (type)
+      set(neo ? "SCF.PROT_GUESS" : "SCF.GUESS", type);
+    if (neo) // Protonic swaps are checked but have no keys
+      return;
+    for (size_t i = 0; i < alpha.size(); ++i)
+      for (size_t j = 0; j < 2; ++j)
+        set("SCF.GUESS.ALPHASWAP[" + std::to_string(i) + "][" +
+                std::to_string(j) + "]",
+            std::to_string(alpha[i][j]));
+    for (size_t i = 0; i < beta.size(); ++i)
+      for (size_t j = 0; j < 2; ++j)
+        set("SCF.GUESS.BETASWAP[" + std::to_string(i) + "][" +
+                std::to_string(j) + "]",
+            std::to_string(beta[i][j]));
+  }
+
+  void rt(std::string_view body) {
+    std::optional<double> step, max_time;
+    std::optional<long> nsteps, save, print, irestart, restart_from;
+    std::optional<long> gaunt, gauge, breit, printden, popfreq;
+    const char *int_alg = nullptr, *restart_alg = nullptr;
+
+    for (const auto &opt : split_options(body)) {
+      const std::string &n = opt.name;
+      long count;
+      double t;
+      if (!opt.has_value) {
+        if (const char *alg = rt_algorithm(n, true))
+          int_alg = alg;
+        else if (n == "RESTART")
+          restart_from = -1;
+        else
+          unknown(opt, "RT");
+      } else if (n == "STEPSIZE" || n == "TIMESTEP") {
+        if (time_option(opt, t))
+          step = t;
+      } else if (n == "MAXTIME") {
+        if (time_option(opt, t))
+          max_time = t;
+      } else if (n == "NSTEPS" || n == "MAXSTEPS" || n == "MAXITERATIONS" ||
+                 n == "MAXITER") {
+        if (count_option(opt, count))
+          nsteps = count;
+      } else if (n == "RESTARTALGORITHM" || n == "RESTARTALG") {
+        restart_alg = rt_algorithm(upper(opt.value), false);
+        if (!restart_alg)
+          issue(opt.text, n + " must be MMUT, FORWARDEULER or MAGNUS2");
+      } else if (n == "INTALG" || n == "ALGORITHM") {
+        int_alg = rt_algorithm(upper(opt.value), true);
+        if (!int_alg)
+          issue(opt.text, n + " must be MMUT, FORWARDEULER, MAGNUS2 or RK4");
+      } else if (n == "ISAVE" || n == "AUTOSAVE") {
+        if (count_option(opt, count))
+          save = count;
+      } else if (n == "IPRINT" || n == "AUTOPRINT") {
+        if (count_option(opt, count))
+          print = count;
+      } else if (n == "IRESTART" || n == "AUTORESTART") {
+        if (count_option(opt, count))
+          irestart = count;
+      } else if (n == "RESTART") {
+        if (count_option(opt, count))
+          restart_from = count;
+      } else if (n == "RTGAUNT" || n == "RTGAUGE" || n == "RTBREIT" ||
+                 n == "RTPRINTDEN" || n == "ORBITALPOPFREQ") {
+        if (!count_option(opt, count))
+          continue;
+        if (n == "RTGAUNT")
+          gaunt = count;
+        else if (n == "RTGAUGE")
+          gauge = count;
+        else if (n == "RTBREIT")
+          breit = count;
+        else if (n == "RTPRINTDEN")
+          printden = count;
+        else
+          popfreq = count;
+      } else {
+        unknown(opt, "RT");
+      }
+    }
+
+    // Same keys and derived values as parseFreeCQInputRT
+    const double dt = step.value_or(0.0);
+    if (step) {
+      set("RT.DELTAT", format_double(dt));
+      set("RT.UNITS", "AU");
+    }
+    if (nsteps) {
+      set("RT.TMAX", format_double(*nsteps * dt));
+      set("RT.MAXSTEPS", std::to_string(*nsteps));
+    }
+    if (max_time) { // Overrides the step count
+      set("RT.TMAX", format_double(*max_time));
+      if (dt > 0)
+        set("RT.MAXSTEPS",
+            std::to_string(static_cast<long>((*max_time + dt / 4) / dt)));
+    }
+    if (restart_alg)
+      set("RT.RESTARTSTEP", restart_alg);
+    if (int_alg)
+      set("RT.INTALG", int_alg);
+    auto set_count = [&](const char *key, const std::optional<long> &value) {
+      if (value)
+        set(key, std::to_string(*value));
+    };
+    set_count("RT.SAVESTEP", save);
+    set_count("RT.PRINTSTEP", print);
+    set_count("RT.IRSTRT", irestart);
+    if (restart_from) {
+      set("RT.RESTARTFROM", std::to_string(*restart_from));
+      set("RT.RESTART", "TRUE");
+    }
+    set_count("RT.RTGAUNT", gaunt);
+    set_count("RT.RTGAUGE", gauge);
+    set_count("RT.RTBREIT", breit);
+    set_count("RT.RTPRINTDEN", printden);
+    set_count("RT.ORBITALPOPFREQ", popfreq);
+  }
+
+  // field(delta, start = 1.0 as, end = 10 fs, amplitude = 0.001 au)
+  void field(std::string_view body) {
+    for (const auto &opt : split_options(body)) {
+      const std::string &n = opt.name;
+      double t;
+      if (!opt.has_value) {
+        if (n != "DELTA" && n != "STEP" && n != "CONSTANT")
+          unknown(opt, "field");
+      } else if (n == "TON" || n == "TIMEON" || n == "TSTART" ||
+                 n == "START" || n == "STARTTIME") {
+        if (!iequals(opt.value, "ALWAYS"))
+          time_option(opt, t);
+      } else if (n == "TOFF" || n == "TIMEOFF" || n == "TEND" || n == "END" ||
+                 n == "ENDTIME") {
+        if (!iequals(opt.value, "NEVER"))
+          time_option(opt, t);
+      } else if (n == "AMP" || n == "AMPLITUDE") {
+        double amp;
+        auto [end, ec] = std::from_chars(
+            opt.value.data(), opt.value.data() + opt.value.size(), amp);
+        std::string_view unit =
+            ec == std::errc() ? trim(opt.value.substr(end - opt.value.data()))
+                              : std::string_view();
+        if (!iequals(unit, "EV") && !iequals(unit, "MEV") && !iequals(unit, "AU"))
+          issue(opt.text, n + " needs a number with a unit (eV, meV or au)");
+      } else {
+        unknown(opt, "field");
+      }
+    }
+  }
+
+  // neo(EPC17/prot-pb4-d)
+  void neo(std::string_view body) {
+    set("SCF.NEO", "TRUE");
+    body = trim(body);
+    size_t slash = body.find('/');
+    std::string_view method = trim(body.substr(0, slash));
+    std::string u = upper(method);
+    if (!method.empty() && u != "HF" && u.compare(0, 3, "EPC") != 0)
+      issue(method, "unknown NEO method '" + std::string(method) + "'");
+    if (slash != std::string_view::npos) {
+      std::string_view basis = strip_density_fitting(trim(body.substr(slash + 1)));
+      if (!basis.empty())
+        set("PBASIS.BASIS", std::string(basis));
+    }
+  }
+};
+
+} // namespace
+
+Directive parse_chronusq_directive(std::string_view text) {
+  Directive directive;
+  Parser(text, directive).parse();
+  return directive;
+}
+
+// --- Benchmark ---
+
+namespace {
+
+// The regex cascade of input/freeparsers.cxx for the parts that produce keys
+// (model, SCF, guess type, RT), with every pattern built on each call as
+// there. Method prefixes take an optional '-' for all of 2C/X2C/4C/G.
+std::map<std::string, std::string> regex_expand(std::string line) {
+  std::map<std::string, std::string> keys;
+  const auto icase = std::regex_constants::icase;
+
+  // Model
+  auto const freeCQInputHF = std::regex("((2C)|(X2C)|(4C)|(G))?-?HF/?", icase);
+  auto const freeCQInputB3LYP = std::regex("((2C)|(X2C)|(4C)|(G))?-?B3LYP/?", icase);
+  auto const freeCQInputPBE = std::regex("((2C)|(X2C)|(4C)|(G))?-?PBE/?", icase);
+  std::smatch m;
+  if (std::regex_search(line, m, freeCQInputHF)) {
+    keys["QM.REFERENCE"] = upper(m.str(1)) + "HF";
+    line = std::regex_replace(line, freeCQInputHF, "");
+  } else if (std::regex_search(line, m, freeCQInputB3LYP)) {
+    keys["QM.REFERENCE"] = upper(m.str(1)) + "B3LYP";
+    line = std::regex_replace(line, freeCQInputB3LYP, "");
+  } else if (std::regex_search(line, m, freeCQInputPBE)) {
+    keys["QM.REFERENCE"] = upper(m.str(1)) + "PBEXPBEC";
+    line = std::regex_replace(line, freeCQInputPBE, "");
+  }
+  for (const char *basis : {"STO-3G", "3-21G", "6-311G", "6-31G"}) {
+    auto const freeCQInputBasis =
+        std::regex(std::string("((CD)|(RI))?-?(") + basis + ")", icase);
+    if (std::regex_search(line, m, freeCQInputBasis)) {
+      keys["BASIS.BASIS"] = m.str(4);
+      line = std::regex_replace(line, freeCQInputBasis, "");
+      break;
+    }
+  }
+
+  // SCF
+  auto const freeCQInputSCF = std::regex("(SCF)(\\((.*?)\\))", icase);
+  if (std::regex_search(line, m, freeCQInputSCF)) {
+    std::string options = m.str(3);
+    auto const accuracy = std::regex("accuracy\\s*=\\s*((\\d+\\.?\\d*|\\.\\d+)(e[-+]?\\d+)?)\\s*([,;:]|$)", icase);
+    if (std::regex_search(options, m, accuracy))
+      keys["SCF.ACCURACY"] = m.str(1);
+    auto const energy_only = std::regex("energyonly|skip", icase);
+    if (std::regex_search(options, m, energy_only))
+      keys["SCF.ENERGYONLY"] = "SKIP";
+    auto const method = std::regex("(diis)|(nodiis)|(cdiis)|(ediis)|(qc)", icase);
+    if (std::regex_search(options, m, method)) {
+      if (!m.str(1).empty() || !m.str(3).empty())
+        keys["SCF.DIISALG"] = "CDIIS";
+      if (!m.str(2).empty())
+        keys["SCF.DIISALG"] = "NONE";
+      if (!m.str(4).empty())
+        keys["SCF.DIISALG"] = "EDIIS";
+      if (!m.str(5).empty())
+        keys["SCF.ALG"] = "NR";
+    }
+    auto const steps = std::regex("(MAXSTEP|MAXSTEPS|MAXITERATION|MAXITERATIONS|MAXCYCLE|MAXCYCLES)\\s*=\\s*(\\d+)\\s*([,;:]|$)", icase);
+    if (std::regex_search(options, m, steps))
+      keys["SCF.MAXITER"] = m.str(2);
+  }
+
+  // Guess
+  auto const freeCQInputGuess = std::regex("(GUESS)(\\((.*?)\\))?", icase);
+  if (std::regex_search(line, m, freeCQInputGuess) && m.str(3).size()) {
+    std::string options = m.str(3);
+    auto const type = std::regex("(SAD)|(CORE)|(READ)|(FCHK)\\s*([,;:]|$)", icase);
+    if (std::regex_search(options, m, type)) {
+      if (!m.str(1).empty()) keys["SCF.GUESS"] = "SAD";
+      if (!m.str(2).empty()) keys["SCF.GUESS"] = "CORE";
+      if (!m.str(3).empty()) keys["SCF.GUESS"] = "READMO";
+      if (!m.str(4).empty()) keys["SCF.GUESS"] = "FCHKMO";
+    }
+  }
+
+  // RT
+  auto const freeCQInputRT = std::regex("(RT|REALTIME)(\\((.*?)\\))?", icase);
+  if (std::regex_search(line, m, freeCQInputRT) && m.str(3).size()) {
+    std::string options = m.str(3);
+    double dt = 0.0, tmax = 0.0;
+    long steps = 0;
+    auto to_au = [](const std::smatch &t, double value) {
+      if (!t.str(5).empty() || !t.str(6).empty())
+        return value / (FS_PER_AU_TIME * 1.e3);
+      if (!t.str(7).empty() || !t.str(8).empty())
+        return value / FS_PER_AU_TIME;
+      return value;
+    };
+    auto const stepsize = std::regex("(STEPSIZE|TIMESTEP)\\s*=\\s*(\\d+(\\.\\d+)?)\\s*((as)|(attosecond)|(fs)|(femtosecond)|(au))\\s*([,;:]|$)", icase);
+    if (std::regex_search(options, m, stepsize)) {
+      dt = to_au(m, std::stod(m.str(2)));
+      keys["RT.DELTAT"] = format_double(dt);
+      keys["RT.UNITS"] = "AU";
+      options = std::regex_replace(options, stepsize, "");
+    }
+    auto const nsteps = std::regex("(NSTEPS|MAXSTEPS|MAXITERATIONS|MAXITER)\\s*=\\s*(\\d+)\\s*([,;:]|$)", icase);
+    if (std::regex_search(options, m, nsteps)) {
+      steps = std::stol(m.str(2));
+      keys["RT.TMAX"] = format_double(steps * dt);
+      keys["RT.MAXSTEPS"] = std::to_string(steps);
+      options = std::regex_replace(options, nsteps, "");
+    }
+    auto const maxtime = std::regex("(MAXTIME)\\s*=\\s*(\\d+(\\.\\d+)?)\\s*((as)|(attosecond)|(fs)|(femtosecond)|(au))\\s*([,;:]|$)", icase);
+    if (std::regex_search(options, m, maxtime)) {
+      tmax = to_au(m, std::stod(m.str(2)));
+      keys["RT.TMAX"] = format_double(tmax);
+      if (dt > 0)
+        keys["RT.MAXSTEPS"] = std::to_string(static_cast<long>((tmax + dt / 4) / dt));
+      options = std::regex_replace(options, maxtime, "");
+    }
+    auto algorithm = [](const std::smatch &a, size_t first) -> std::string {
+      if (!a.str(first).empty() || !a.str(first + 1).empty()) return "MMUT";
+      if (!a.str(first + 2).empty() || !a.str(first + 3).empty()) return "FORWARDEULER";
+      for (size_t k = first + 4; k < first + 8; ++k)
+        if (!a.str(k).empty()) return "MAGNUS2";
+      return "RK4";
+    };
+    auto const restart_alg = std::regex("(RESTARTALGORITHM|RESTARTALG)\\s*=\\s*((MMUT)|(MODIFIEDMIDPOINT)|(FORWARDEULER)|(EULER)|(EXPLICITMAGNUS2)|(EXPLICITMAGNUSTWO)|(MAGNUS2)|(MAGNUSTWO))\\s*([,;:]|$)", icase);
+    if (std::regex_search(options, m, restart_alg)) {
+      keys["RT.RESTARTSTEP"] = algorithm(m, 3);
+      options = std::regex_replace(options, restart_alg, "");
+    }
+    auto const int_alg = std::regex("(MMUT)|(MODIFIEDMIDPOINT)|(FORWARDEULER)|(EULER)|(EXPLICITMAGNUS2)|(EXPLICITMAGNUSTWO)|(MAGNUS2)|(MAGNUSTWO)|(RK4)|(RUNGEKUTTAFOURTHORDER)\\s*([,;:]|$)", icase);
+    if (std::regex_search(options, m, int_alg)) {
+      keys["RT.INTALG"] = algorithm(m, 1);
+      options = std::regex_replace(options, int_alg, "");
+    }
+    const std::pair<const char *, const char *> counts[] = {
+        {"ISAVE|AUTOSAVE", "RT.SAVESTEP"},   {"IPRINT|AUTOPRINT", "RT.PRINTSTEP"},
+        {"IRESTART|AUTORESTART", "RT.IRSTRT"}};
+    for (const auto &[names, key] : counts) {
+      auto const count = std::regex(std::string("(") + names + ")\\s*=\\s*(\\d+)\\s*([,;:]|$)", icase);
+      if (std::regex_search(options, m, count)) {
+        keys[key] = m.str(2);
+        options = std::regex_replace(options, count, "");
+      }
+    }
+    auto const restart = std::regex("RESTART(\\s*=\\s*(\\d+))?\\s*([,;:]|$)", icase);
+    if (std::regex_search(options, m, restart)) {
+      keys["RT.RESTARTFROM"] = m.str(2).empty() ? "-1" : m.str(2);
+      keys["RT.RESTART"] = "TRUE";
+      options = std::regex_replace(options, restart, "");
+    }
+    for (const char *name : {"RTGAUNT", "RTGAUGE", "RTBREIT", "RTPRINTDEN", "ORBITALPOPFREQ"}) {
+      auto const count = std::regex(std::string("(") + name + ")\\s*=\\s*(\\d+)\\s*([,;:]|$)", icase);
+      if (std::regex_search(options, m, count)) {
+        keys[std::string("RT.") + name] = m.str(2);
+        options = std::regex_replace(options, count, "");
+      }
+    }
+  }
+  return keys;
+}
+
+const char *const BENCH_DIRECTIVES[] = {
+    "realtime(stepsize = 0.05au, maxsteps = 20,  mmut, "
+    "restartalgorithm=magnus2, autosave=1, autorestart=10)",
+    "HF/STO-3G SCF(accuracy=1.e-6, cdiis, maxiteration=100) guess(sad)",
+    "X2C-B3LYP/6-31G RT(stepsize = 1as, maxtime = 1.0fs, magnus2, iprint=10, "
+    "restart)",
+    "G-HF/6-31G guess(core) realtime(timestep=0.5 attosecond, nsteps=400, "
+    "rk4, isave=50, rtgaunt=1)",
+};
+
+} // namespace
+
+int run_directive_bench(size_t iterations) {
+  using clock = std::chrono::steady_clock;
+  const size_t lines = sizeof(BENCH_DIRECTIVES) / sizeof(BENCH_DIRECTIVES[0]);
+  iterations = std::max<size_t>(1, iterations);
+
+  // Both parsers must agree before their speed means anything
+  int status = 0;
+  for (const char *line : BENCH_DIRECTIVES) {
+    Directive directive = parse_chronusq_directive(line);
+    std::map<std::string, std::string> ours(directive.keys.begin(),
+                                            directive.keys.end());
+    if (ours != regex_expand(line) || !directive.issues.empty()) {
+      std::cout << "MISMATCH: " << line << "\n";
+      status = 1;
+    }
+  }
+
+  size_t sink = 0; // Keeps the loops from being optimized away
+  auto start = clock::now();
+  for (size_t it = 0; it < iterations; ++it)
+    for (const char *line : BENCH_DIRECTIVES)
+      sink += regex_expand(line).size();
+  double regex_ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+
+  // The single-pass parser is fast enough to need more rounds to time
+  const size_t rounds = iterations * 100;
+  start = clock::now();
+  for (size_t it = 0; it < rounds; ++it)
+    for (const char *line : BENCH_DIRECTIVES)
+      sink += parse_chronusq_directive(line).keys.size();
+  double parser_ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+
+  regex_ns /= iterations * lines;
+  parser_ns /= rounds * lines;
+  std::printf("chronusq: directives, %zu samples (checksum %zu)\n", lines, sink);
+  std::printf("  regex cascade : %10.0f ns/line (%zu rounds)\n", regex_ns, iterations);
+  std::printf("  single pass   : %10.0f ns/line (%zu rounds)\n", parser_ns, rounds);
+  std::printf("  speedup       : %10.0fx\n", regex_ns / parser_ns);
+  std::printf("  results       : %s\n", status ? "DIFFER" : "identical keys");
+  return status;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct DirectiveIssue {
+  size_t offset; ///< Byte offset into the directive text
+  std::string message;
+};
+
+/**
+ * \brief A `chronusq:` directive expanded into the section keys it stands
+ *        for, e.g. "RT.DELTAT" = "0.05".
+ */
+struct Directive {
+  std::vector<std::pair<std::string, std::string>> keys; ///< SECTION.KEY, value
+  std::vector<DirectiveIssue> issues; ///< Parts that were not understood
+
+  // Value of SECTION.KEY ("" if the directive does not set it)
+  std::string get(const std::string &key) const;
+};
+
+/**
+ * \brief Expand the free-format directive line understood by
+ *        CQInputFile::parseFreeCQInput (input/freeparsers.cxx).
+ *
+ * Grammar (case-insensitive; items separated by blanks, ',' or ';'):
+ *
+ *     item   := MODEL | GROUP "(" option ("," option)* ")"
+ *     MODEL  := [X2C|2C|4C|RO|R|U|G][-]METHOD["/"[CD-|RI-]BASIS]
+ *     GROUP  := scf | guess | neoguess | rt | realtime | field | neo
+ *             | [prefix-](cas|ras|das)(scf|ci)
+ *     option := WORD ["=" VALUE]           e.g. mmut, stepsize = 0.05au
+ *
+ * The text is scanned once, left to right, without building any regular
+ * expressions. Keys come out in the order the regex cascade emits them;
+ * field() and the CI groups are checked but, as there, produce no keys.
+ *
+ * \param [in] text  Directive without the leading "chronusq:" / "cq="
+ */
+Directive parse_chronusq_directive(std::string_view text);
+
+/**
+ * \brief Time parse_chronusq_directive against a std::regex cascade built the
+ *        way input/freeparsers.cxx builds it (per call) and check that both
+ *        expand a set of sample directives to the same keys.
+ *
+ * \returns 0 if the two parsers agree, 1 otherwise
+ */
+int run_directive_bench(size_t iterations);
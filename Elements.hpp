@@ -0,0 +1,224 @@
+#pragma once
+
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <string>
+
+/**
+ * \brief Static per-element data used by the renderer and analysis passes.
+ */
+struct ElementData {
+  const char *symbol;
+  uint8_t r, g, b;        ///< CPK color (Jmol palette)
+  double covalent_radius; ///< Single-bond covalent radius in Angstrom
+  double vdw_radius;      ///< Van der Waals radius in Angstrom
+  double mass;            ///< Standard atomic weight in amu
+};
+
+namespace elements {
+
+constexpr int MAX_Z = 118;
+
+// Indexed by atomic number; entry 0 is the fallback for unknown symbols.
+// Covalent radii: Cordero et al. (2008), 1.50 where no value exists.
+// Van der Waals radii: Bondi (1964) with the usual extensions, 2.00 where no
+// value exists. Masses of radioactive elements are the most stable isotope.
+constexpr ElementData TABLE[MAX_Z + 1] = {
+    {"X",  200, 200, 200, 1.50, 2.00, 0.0}, // 0: unknown / dummy
+    {"H",  255, 255, 255, 0.31, 1.20, 1.008}, // 1
+    {"He", 217, 255, 255, 0.28, 1.40, 4.0026}, // 2
+    {"Li", 204, 128, 255, 1.28, 1.82, 6.94}, // 3
+    {"Be", 194, 255,   0, 0.96, 1.53, 9.0122}, // 4
+    {"B",  255, 181, 181, 0.84, 1.92, 10.81}, // 5
+    {"C",  144, 144, 144, 0.76, 1.70, 12.011}, // 6
+    {"N",   48,  80, 248, 0.71, 1.55, 14.007}, // 7
+    {"O",  255,  13,  13, 0.66, 1.52, 15.999}, // 8
+    {"F",  144, 224,  80, 0.57, 1.47, 18.998}, // 9
+    {"Ne", 179, 227, 245, 0.58, 1.54, 20.18}, // 10
+    {"Na", 171,  92, 242, 1.66, 2.27, 22.99}, // 11
+    {"Mg", 138, 255,   0, 1.41, 1.73, 24.305}, // 12
+    {"Al", 191, 166, 166, 1.21, 1.84, 26.982}, // 13
+    {"Si", 240, 200, 160, 1.11, 2.10, 28.085}, // 14
+    {"P",  255, 128,   0, 1.07, 1.80, 30.974}, // 15
+    {"S",  255, 255,  48, 1.05, 1.80, 32.06}, // 16
+    {"Cl",  31, 240,  31, 1.02, 1.75, 35.45}, // 17
+    {"Ar", 128, 209, 227, 1.06, 1.88, 39.948}, // 18
+    {"K",  143,  64, 212, 2.03, 2.75, 39.098}, // 19
+    {"Ca",  61, 255,   0, 1.76, 2.31, 40.078}, // 20
+    {"Sc", 230, 230, 230, 1.70, 2.30, 44.956}, // 21
+    {"Ti", 191, 194, 199, 1.60, 2.15, 47.867}, // 22
+    {"V",  166, 166, 171, 1.53, 2.05, 50.942}, // 23
+    {"Cr", 138, 153, 199, 1.39, 2.05, 51.996}, // 24
+    {"Mn", 156, 122, 199, 1.39, 2.05, 54.938}, // 25
+    {"Fe", 224, 102,  51, 1.32, 2.05, 55.845}, // 26
+    {"Co", 240, 144, 160, 1.26, 2.00, 58.933}, // 27
+    {"Ni",  80, 208,  80, 1.24, 1.63, 58.693}, // 28
+    {"Cu", 200, 128,  51, 1.32, 1.40, 63.546}, // 29
+    {"Zn", 125, 128, 176, 1.22, 1.39, 65.38}, // 30
+    {"Ga", 194, 143, 143, 1.22, 1.87, 69.723}, // 31
+    {"Ge", 102, 143, 143, 1.20, 2.11, 72.63}, // 32
+    {"As", 189, 128, 227, 1.19, 1.85, 74.922}, // 33
+    {"Se", 255, 161,   0, 1.20, 1.90, 78.971}, // 34
+    {"Br", 166,  41,  41, 1.20, 1.85, 79.904}, // 35
+    {"Kr",  92, 184, 209, 1.16, 2.02, 83.798}, // 36
+    {"Rb", 112,  46, 176, 2.20, 3.03, 85.468}, // 37
+    {"Sr",   0, 255,   0, 1.95, 2.49, 87.62}, // 38
+    {"Y",  148, 255, 255, 1.90, 2.40, 88.906}, // 39
+    {"Zr", 148, 224, 224, 1.75, 2.30, 91.224}, // 40
+    {"Nb", 115, 194, 201, 1.64, 2.15, 92.906}, // 41
+    {"Mo",  84, 181, 181, 1.54, 2.10, 95.95}, // 42
+    {"Tc",  59, 158, 158, 1.47, 2.05, 98.0}, // 43
+    {"Ru",  36, 143, 143, 1.46, 2.05, 101.07}, // 44
+    {"Rh",  10, 125, 140, 1.42, 2.00, 102.91}, // 45
+    {"Pd",   0, 105, 133, 1.39, 1.63, 106.42}, // 46
+    {"Ag", 192, 192, 192, 1.45, 1.72, 107.87}, // 47
+    {"Cd", 255, 217, 143, 1.44, 1.58, 112.41}, // 48
+    {"In", 166, 117, 115, 1.42, 1.93, 114.82}, // 49
+    {"Sn", 102, 128, 128, 1.39, 2.17, 118.71}, // 50
+    {"Sb", 158,  99, 181, 1.39, 2.06, 121.76}, // 51
+    {"Te", 212, 122,   0, 1.38, 2.06, 127.6}, // 52
+    {"I",  148,   0, 148, 1.39, 1.98, 126.9}, // 53
+    {"Xe",  66, 158, 176, 1.40, 2.16, 131.29}, // 54
+    {"Cs",  87,  23, 143, 2.44, 3.43, 132.91}, // 55
+    {"Ba",   0, 201,   0, 2.15, 2.68, 137.33}, // 56
+    {"La", 112, 212, 255, 2.07, 2.50, 138.91}, // 57
+    {"Ce", 255, 255, 199, 2.04, 2.48, 140.12}, // 58
+    {"Pr", 217, 255, 199, 2.03, 2.47, 140.91}, // 59
+    {"Nd", 199, 255, 199, 2.01, 2.45, 144.24}, // 60
+    {"Pm", 163, 255, 199, 1.99, 2.43, 145.0}, // 61
+    {"Sm", 143, 255, 199, 1.98, 2.42, 150.36}, // 62
+    {"Eu",  97, 255, 199, 1.98, 2.40, 151.96}, // 63
+    {"Gd",  69, 255, 199, 1.96, 2.38, 157.25}, // 64
+    {"Tb",  48, 255, 199, 1.94, 2.37, 158.93}, // 65
+    {"Dy",  31, 255, 199, 1.92, 2.35, 162.5}, // 66
+    {"Ho",   0, 255, 156, 1.92, 2.33, 164.93}, // 67
+    {"Er",   0, 230, 117, 1.89, 2.32, 167.26}, // 68
+    {"Tm",   0, 212,  82, 1.90, 2.30, 168.93}, // 69
+    {"Yb",   0, 191,  56, 1.87, 2.28, 173.05}, // 70
+    {"Lu",   0, 171,  36, 1.87, 2.27, 174.97}, // 71
+    {"Hf",  77, 194, 255, 1.75, 2.25, 178.49}, // 72
+    {"Ta",  77, 166, 255, 1.70, 2.20, 180.95}, // 73
+    {"W",   33, 148, 214, 1.62, 2.10, 183.84}, // 74
+    {"Re",  38, 125, 171, 1.51, 2.05, 186.21}, // 75
+    {"Os",  38, 102, 150, 1.44, 2.00, 190.23}, // 76
+    {"Ir",  23,  84, 135, 1.41, 2.00, 192.22}, // 77
+    {"Pt", 208, 208, 224, 1.36, 1.75, 195.08}, // 78
+    {"Au", 255, 209,  35, 1.36, 1.66, 196.97}, // 79
+    {"Hg", 184, 184, 208, 1.32, 1.55, 200.59}, // 80
+    {"Tl", 166,  84,  77, 1.45, 1.96, 204.38}, // 81
+    {"Pb",  87,  89,  97, 1.46, 2.02, 207.2}, // 82
+    {"Bi", 158,  79, 181, 1.48, 2.07, 208.98}, // 83
+    {"Po", 171,  92,   0, 1.40, 1.97, 209.0}, // 84
+    {"At", 117,  79,  69, 1.50, 2.02, 210.0}, // 85
+    {"Rn",  66, 130, 150, 1.50, 2.20, 222.0}, // 86
+    {"Fr",  66,   0, 102, 2.60, 3.48, 223.0}, // 87
+    {"Ra",   0, 125,   0, 2.21, 2.83, 226.0}, // 88
+    {"Ac", 112, 171, 250, 2.15, 2.00, 227.0}, // 89
+    {"Th",   0, 186, 255, 2.06, 2.40, 232.04}, // 90
+    {"Pa",   0, 161, 255, 2.00, 2.00, 231.04}, // 91
+    {"U",    0, 143, 255, 1.96, 1.86, 238.03}, // 92
+    {"Np",   0, 128, 255, 1.90, 2.00, 237.0}, // 93
+    {"Pu",   0, 107, 255, 1.87, 2.00, 244.0}, // 94
+    {"Am",  84,  92, 242, 1.80, 2.00, 243.0}, // 95
+    {"Cm", 120,  92, 227, 1.69, 2.00, 247.0}, // 96
+    {"Bk", 138,  79, 227, 1.50, 2.00, 247.0}, // 97
+    {"Cf", 161,  54, 212, 1.50, 2.00, 251.0}, // 98
+    {"Es", 179,  31, 212, 1.50, 2.00, 252.0}, // 99
+    {"Fm", 179,  31, 186, 1.50, 2.00, 257.0}, // 100
+    {"Md", 179,  13, 166, 1.50, 2.00, 258.0}, // 101
+    {"No", 189,  13, 135, 1.50, 2.00, 259.0}, // 102
+    {"Lr", 199,   0, 102, 1.50, 2.00, 266.0}, // 103
+    {"Rf", 204,   0,  89, 1.50, 2.00, 267.0}, // 104
+    {"Db", 209,   0,  79, 1.50, 2.00, 268.0}, // 105
+    {"Sg", 217,   0,  69, 1.50, 2.00, 269.0}, // 106
+    {"Bh", 224,   0,  56, 1.50, 2.00, 270.0}, // 107
+    {"Hs", 230,   0,  46, 1.50, 2.00, 269.0}, // 108
+    {"Mt", 235,   0,  38, 1.50, 2.00, 278.0}, // 109
+    {"Ds", 235,   0,  38, 1.50, 2.00, 281.0}, // 110
+    {"Rg", 235,   0,  38, 1.50, 2.00, 282.0}, // 111
+    {"Cn", 235,   0,  38, 1.50, 2.00, 285.0}, // 112
+    {"Nh", 235,   0,  38, 1.50, 2.00, 286.0}, // 113
+    {"Fl", 235,   0,  38, 1.50, 2.00, 289.0}, // 114
+    {"Mc", 235,   0,  38, 1.50, 2.00, 290.0}, // 115
+    {"Lv", 235,   0,  38, 1.50, 2.00, 293.0}, // 116
+    {"Ts", 235,   0,  38, 1.50, 2.00, 294.0}, // 117
+    {"Og", 235,   0,  38, 1.50, 2.00, 294.0}, // 118
+
+};
+
+// Symbols are one or two letters, so (first letter, optional second letter)
+// maps collision-free onto 26 * 27 slots. The table is filled at compile
+// time, which makes symbol lookup a single array access.
+constexpr int SYMBOL_SLOTS = 26 * 27;
+
+constexpr char to_upper(char c) {
+  return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+constexpr int symbol_slot(char first, char second) {
+  first = to_upper(first);
+  second = to_upper(second);
+  if (first < 'A' || first > 'Z')
+    return -1;
+  int slot = (first - 'A') * 27;
+  if (second == '\0')
+    return slot;
+  if (second < 'A' || second > 'Z')
+    return -1;
+  return slot + 1 + (second - 'A');
+}
+
+constexpr std::array<uint8_t, SYMBOL_SLOTS> build_symbol_index() {
+  std::array<uint8_t, SYMBOL_SLOTS> index{};
+  for (int z = 1; z <= MAX_Z; ++z) {
+    const char *s = TABLE[z].symbol;
+    index[symbol_slot(s[0], s[1])] = static_cast<uint8_t>(z);
+  }
+  return index;
+}
+
+constexpr std::array<uint8_t, SYMBOL_SLOTS> SYMBOL_INDEX =
+    build_symbol_index();
+
+// Case-insensitive, since the input parser upper-cases geometry blocks
+// ("CL" and "Cl" are the same element). Returns 0 for unknown symbols.
+constexpr uint8_t lookup_symbol(const char *s, size_t len) {
+  if (len == 0 || len > 2)
+    return 0;
+  int slot = symbol_slot(s[0], len == 2 ? s[1] : '\0');
+  return slot < 0 ? 0 : SYMBOL_INDEX[slot];
+}
+
+/**
+ * \brief Resolve a ChronusQ GEOM atom token to an atomic number.
+ *
+ * Accepts plain symbols ("O", "CL"), atomic numbers ("8"), isotope labels
+ * ("H-2") and explicit nuclear charges ("H(1.0)"). Returns 0 if unknown.
+ */
+inline uint8_t atomic_number(const std::string &token) {
+  size_t end = token.find_first_of("-(");
+  std::string base = token.substr(0, end);
+  if (base.empty())
+    return 0;
+  if (std::isdigit(static_cast<unsigned char>(base[0]))) {
+    int z = 0;
+    for (char c : base) {
+      if (!std::isdigit(static_cast<unsigned char>(c)) || z > MAX_Z)
+        return 0;
+      z = z * 10 + (c - '0');
+    }
+    return z <= MAX_Z ? static_cast<uint8_t>(z) : 0;
+  }
+  return lookup_symbol(base.data(), base.size());
+}
+
+constexpr const ElementData &get(uint8_t z) {
+  return TABLE[z <= MAX_Z ? z : 0];
+}
+
+static_assert(lookup_symbol("C", 1) == 6, "symbol index out of sync");
+static_assert(lookup_symbol("CL", 2) == 17, "symbol index out of sync");
+static_assert(lookup_symbol("Og", 2) == MAX_Z, "symbol index out of sync");
+
+} // namespace elements
@@ -0,0 +1,499 @@
+#include "Estimate.hpp"
+#include "Elements.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+// --- Basis library ---
+
+namespace {
+
+const int MAX_L = 6; // s p d f g h
+
+// Contracted shells per angular momentum for elements up to `last`. Rows are
+// in increasing `last` and follow the published contractions through Ar;
+// heavier rows are approximate.
+struct ShellRow {
+  uint8_t last;
+  uint8_t shells[MAX_L];
+};
+
+struct BasisSet {
+  const char *name; // Upper case
+  const ShellRow *rows;
+  size_t count;
+};
+
+const ShellRow STO_3G[] = {{2, {1}},        {10, {2, 1}},    {18, {3, 2}},
+                           {20, {4, 3}},    {36, {4, 3, 1}}, {38, {5, 4, 1}},
+                           {54, {5, 4, 2}}};
+const ShellRow POPLE_3_21G[] = {{2, {2}},        {10, {3, 2}},    {18, {4, 3}},
+                                {20, {5, 4}},    {30, {5, 4, 2}}, {36, {5, 4, 1}},
+                                {38, {6, 5, 1}}, {54, {6, 5, 2}}};
+const ShellRow POPLE_6_31G[] = {{2, {2}},    {10, {3, 2}},    {18, {4, 3}},
+                                {20, {5, 4}}, {30, {5, 4, 2}}, {36, {5, 4, 1}}};
+const ShellRow POPLE_6_311G[] = {{2, {3}},    {10, {4, 3}},    {18, {6, 5}},
+                                 {20, {8, 7}}, {30, {8, 6, 4}}, {36, {8, 7, 2}}};
+const ShellRow CC_PVDZ[] = {{2, {2, 1}},       {10, {3, 2, 1}},
+                            {18, {4, 3, 1}},   {20, {5, 4, 2}},
+                            {30, {6, 5, 3, 1}}, {36, {5, 4, 2}}};
+const ShellRow CC_PVTZ[] = {{2, {3, 2, 1}},       {10, {4, 3, 2, 1}},
+                            {18, {5, 4, 2, 1}},   {20, {6, 5, 3, 1}},
+                            {30, {7, 6, 4, 2, 1}}, {36, {6, 5, 3, 1}}};
+const ShellRow CC_PVQZ[] = {{2, {4, 3, 2, 1}},       {10, {5, 4, 3, 2, 1}},
+                            {18, {6, 5, 3, 2, 1}},   {20, {7, 6, 4, 2, 1}},
+                            {30, {8, 7, 5, 3, 2, 1}}, {36, {7, 6, 4, 2, 1}}};
+const ShellRow CC_PV5Z[] = {{2, {5, 4, 3, 2, 1}},
+                            {10, {6, 5, 4, 3, 2, 1}},
+                            {18, {7, 6, 5, 3, 2, 1}}};
+const ShellRow DEF2_SVP[] = {{2, {2, 1}},    {4, {3, 2}},        {10, {3, 2, 1}},
+                             {18, {4, 3, 1}}, {20, {5, 3, 2}},   {30, {5, 3, 2, 1}},
+                             {36, {5, 4, 2}}};
+const ShellRow DEF2_TZVP[] = {{2, {3, 1}},       {4, {5, 3}},
+                              {10, {5, 3, 2, 1}}, {18, {5, 5, 2, 1}},
+                              {20, {6, 4, 2}},    {30, {6, 4, 4, 1}},
+                              {36, {6, 5, 3, 1}}};
+const ShellRow DEF2_TZVPP[] = {{2, {3, 2, 1}},       {4, {5, 3, 2, 1}},
+                               {10, {5, 3, 2, 1}},   {18, {5, 5, 3, 1}},
+                               {20, {6, 4, 3, 1}},   {30, {6, 5, 4, 2, 1}},
+                               {36, {6, 5, 3, 1}}};
+const ShellRow DEF2_QZVP[] = {{2, {4, 3, 2, 1}},
+                              {10, {7, 4, 3, 2, 1}},
+                              {18, {9, 6, 4, 2, 1}}};
+
+#define BASIS_ENTRY(name, rows) {name, rows, sizeof(rows) / sizeof(rows[0])}
+const BasisSet LIBRARY[] = {
+    BASIS_ENTRY("STO-3G", STO_3G),          BASIS_ENTRY("3-21G", POPLE_3_21G),
+    BASIS_ENTRY("6-31G", POPLE_6_31G),      BASIS_ENTRY("6-311G", POPLE_6_311G),
+    BASIS_ENTRY("CC-PVDZ", CC_PVDZ),        BASIS_ENTRY("CC-PVTZ", CC_PVTZ),
+    BASIS_ENTRY("CC-PVQZ", CC_PVQZ),        BASIS_ENTRY("CC-PV5Z", CC_PV5Z),
+    BASIS_ENTRY("DEF2-SVP", DEF2_SVP),      BASIS_ENTRY("DEF2-TZVP", DEF2_TZVP),
+    BASIS_ENTRY("DEF2-TZVPP", DEF2_TZVPP),  BASIS_ENTRY("DEF2-QZVP", DEF2_QZVP),
+};
+#undef BASIS_ENTRY
+
+const BasisSet *find_basis(const std::string &name) {
+  for (const auto &b : LIBRARY)
+    if (name == b.name)
+      return &b;
+  return nullptr;
+}
+
+std::string upper(std::string s) {
+  for (char &c : s)
+    c = std::toupper(static_cast<unsigned char>(c));
+  return s;
+}
+
+// Name with whitespace and the density-fitting prefix removed, upper case
+std::string normalize_basis(const std::string &basis) {
+  std::string u;
+  for (char c : basis)
+    if (c != ' ' && c != '\t')
+      u += std::toupper(static_cast<unsigned char>(c));
+  if (u.size() > 3 && (u.compare(0, 3, "CD-") == 0 || u.compare(0, 3, "RI-") == 0))
+    u.erase(0, 3);
+  return u;
+}
+
+// Shells of a named set after Pople ('+', '*', "(2DF,P)") and Dunning
+// ("AUG-") modifiers. False if the name or element is not known.
+struct Shells {
+  int count[MAX_L] = {};
+};
+
+bool add_polarization(const std::string &spec, Shells &shells) {
+  static const char LETTERS[] = "SPDFGH";
+  int multiplier = 0;
+  for (char c : spec) {
+    if (c >= '0' && c <= '9') {
+      multiplier = multiplier * 10 + (c - '0');
+      continue;
+    }
+    const char *l = std::strchr(LETTERS, c);
+    if (!l || !c)
+      return false;
+    shells.count[l - LETTERS] += multiplier ? multiplier : 1;
+    multiplier = 0;
+  }
+  return multiplier == 0;
+}
+
+bool lookup_shells(const std::string &name, uint8_t z, Shells &shells) {
+  auto from_rows = [&](const BasisSet *set) {
+    for (size_t i = 0; i < set->count; ++i)
+      if (z <= set->rows[i].last) {
+        for (int l = 0; l < MAX_L; ++l)
+          shells.count[l] = set->rows[i].shells[l];
+        return true;
+      }
+    return false;
+  };
+
+  if (const BasisSet *set = find_basis(name))
+    return from_rows(set);
+
+  // aug-cc-pVXZ: one extra diffuse shell per angular momentum present
+  if (name.compare(0, 4, "AUG-") == 0) {
+    const BasisSet *set = find_basis(name.substr(4));
+    if (!set || name.compare(4, 5, "CC-PV") != 0 || !from_rows(set))
+      return false;
+    for (int l = 0; l < MAX_L; ++l)
+      shells.count[l] += shells.count[l] > 0;
+    return true;
+  }
+
+  // Pople: BASE[+[+]]G[*[*] | (HEAVY[,LIGHT])]
+  size_t g = name.find('G');
+  if (g == std::string::npos)
+    return false;
+  size_t plus = name.find('+');
+  std::string base = name.substr(0, std::min(plus, g)) + "G";
+  const BasisSet *set = find_basis(base);
+  if (!set || base == "STO-3G" || !from_rows(set))
+    return false;
+  const int diffuse = plus < g ? static_cast<int>(g - plus) : 0;
+  if (diffuse > 2 || name.find_first_not_of('+', std::min(plus, g)) != g)
+    return false;
+
+  std::string heavy, light, suffix = name.substr(g + 1);
+  if (suffix == "*" || suffix == "**") {
+    heavy = "D";
+    light = suffix == "**" ? "P" : "";
+  } else if (suffix.size() > 2 && suffix.front() == '(' && suffix.back() == ')') {
+    suffix = suffix.substr(1, suffix.size() - 2);
+    size_t comma = suffix.find(',');
+    heavy = suffix.substr(0, comma);
+    if (comma != std::string::npos)
+      light = suffix.substr(comma + 1);
+  } else if (!suffix.empty()) {
+    return false;
+  }
+
+  const bool hydrogenic = z <= 2;
+  Shells extra;
+  if (!add_polarization(hydrogenic ? light : heavy, extra))
+    return false;
+  // First-row transition metals take f where main-group atoms take d
+  if (z >= 21 && z <= 30)
+    for (int l = MAX_L - 1; l > 2; --l) {
+      extra.count[l] += extra.count[l - 1];
+      extra.count[l - 1] = 0;
+    }
+  for (int l = 0; l < MAX_L; ++l)
+    shells.count[l] += extra.count[l];
+  if (!hydrogenic && diffuse >= 1) {
+    shells.count[0] += 1;
+    shells.count[1] += 1;
+  }
+  if (hydrogenic && diffuse == 2)
+    shells.count[0] += 1;
+  return true;
+}
+
+} // namespace
+
+bool basis_is_cartesian(const std::string &basis) {
+  std::string u = normalize_basis(basis);
+  return !u.empty() && (std::isdigit(static_cast<unsigned char>(u[0])) ||
+                        u.compare(0, 4, "STO-") == 0);
+}
+
+int basis_function_count(const std::string &basis, uint8_t z, bool cartesian) {
+  Shells shells;
+  if (!lookup_shells(normalize_basis(basis), z, shells))
+    return -1;
+  int n = 0;
+  for (int l = 0; l < MAX_L; ++l)
+    n += shells.count[l] * (cartesian ? (l + 1) * (l + 2) / 2 : 2 * l + 1);
+  return n;
+}
+
+// --- Estimate ---
+
+namespace {
+
+// Typical iteration counts; the MAXITER keywords are only upper bounds
+const double SCF_ITERATIONS = 20;
+const double CC_ITERATIONS = 20;
+const double CI_ITERATIONS = 30;
+const double RESPONSE_BUILDS_PER_ROOT = 30;
+const size_t DEFAULT_DIIS_KEEP = 10;
+
+double choose(int n, int k) {
+  if (k < 0 || k > n)
+    return 0;
+  double r = 1;
+  for (int i = 1; i <= k; ++i)
+    r = r * (n - k + i) / i;
+  return r;
+}
+
+int to_int(const std::string &s, int fallback) {
+  try {
+    return s.empty() ? fallback : std::stoi(s);
+  } catch (...) {
+    return fallback;
+  }
+}
+
+double to_double(const std::string &s, double fallback) {
+  try {
+    return s.empty() ? fallback : std::stod(s);
+  } catch (...) {
+    return fallback;
+  }
+}
+
+// MISC.MEM as ChronusQ reads it: a number with optional KB/MB/GB
+double parse_memory(std::string s) {
+  double scale = 1;
+  for (auto [unit, factor] : {std::pair<const char *, double>{"KB", 1e3},
+                              {"MB", 1e6},
+                              {"GB", 1e9}}) {
+    size_t pos = s.find(unit);
+    if (pos != std::string::npos) {
+      s.erase(pos, 2);
+      scale = factor;
+      break;
+    }
+  }
+  return to_double(s, 0) * scale;
+}
+
+// Fock builds per time step of each RT integrator
+double builds_per_step(const std::string &alg) {
+  if (alg == "MAGNUS2")
+    return 2;
+  if (alg == "RK4")
+    return 4;
+  return 1; // MMUT, FORWARDEULER
+}
+
+// An RHF/6-31G(d) SCF on water: 19 Cartesian functions
+const double WATER_SCF_WORK = SCF_ITERATIONS * std::pow(19.0, 4) / 8;
+
+} // namespace
+
+JobEstimate estimate_job(
+    const std::vector<Atom> &atoms, int charge, int mult,
+    const std::function<std::string(const std::string &, const std::string &)>
+        &parameter) {
+  JobEstimate e;
+  e.job = parameter("QM", "JOB").empty() ? "SCF" : parameter("QM", "JOB");
+  e.basis = parameter("BASIS", "BASIS");
+
+  // Basis functions
+  const std::string force_cart = upper(parameter("BASIS", "FORCECART"));
+  e.cartesian = basis_is_cartesian(e.basis) || force_cart == "TRUE";
+  std::vector<int> unknown(elements::MAX_Z + 1, 0);
+  for (const auto &atom : atoms) {
+    e.electrons += atom.element;
+    int n = basis_function_count(e.basis, atom.element, e.cartesian);
+    if (n < 0)
+      unknown[atom.element]++;
+    else
+      e.basis_functions += n;
+  }
+  e.electrons -= charge;
+  if (e.basis.empty())
+    e.notes.push_back("no BASIS.BASIS");
+  for (int z = 0; z <= elements::MAX_Z; ++z)
+    if (unknown[z] && !e.basis.empty())
+      e.notes.push_back(std::string(elements::get(z).symbol) +
+                        " not in the basis library for " + e.basis + " (" +
+                        std::to_string(unknown[z]) + " atoms left out)");
+
+  // Reference: [REAL|COMPLEX] [R|U|RO|G|2C|X2C|4C]METHOD
+  std::istringstream ref_tokens(parameter("QM", "REFERENCE"));
+  std::string token, field;
+  std::vector<std::string> tokens;
+  while (ref_tokens >> token)
+    tokens.push_back(upper(token));
+  std::string ref = tokens.empty() ? "HF" : tokens.back();
+  if (tokens.size() == 2)
+    field = tokens.front();
+
+  std::string kind;
+  for (const char *p : {"X2C", "2C", "4C", "RO", "R", "U", "G"})
+    if (ref.compare(0, std::strlen(p), p) == 0) {
+      kind = p;
+      break;
+    }
+  if (kind.empty()) { // AUTO: restricted for singlets
+    kind = mult == 1 ? "R" : "U";
+    ref = kind + ref;
+  }
+  e.reference = ref;
+  e.components = kind == "4C" ? 4 : (kind == "G" || kind == "2C" || kind == "X2C") ? 2 : 1;
+
+  const bool rt = e.job == "RT" || e.job == "EHRENFEST";
+  e.complex = field == "COMPLEX" || (field != "REAL" && (e.components > 1 || rt));
+  const double element_bytes = e.complex ? 16 : 8;
+
+  // 4C adds a kinetically balanced small-component basis of about twice the
+  // large one; 2C/X2C work with spinors of twice the scalar dimension
+  const double n = e.basis_functions;
+  const double n_ao = e.components == 4 ? 3 * n : n;
+  e.dimension = static_cast<size_t>(e.components == 1 ? n : 2 * n_ao);
+  const double spin_blocks = kind == "R" ? 1 : e.components == 1 ? 2 : 1;
+  const double dim2 = static_cast<double>(e.dimension) * e.dimension;
+
+  // AO matrices: overlap/core/orthogonalizer plus, per spin block, Fock,
+  // density, their orthonormal copies, MO coefficients and DIIS history
+  size_t keep = static_cast<size_t>(to_int(parameter("SCF", "NKEEP"), DEFAULT_DIIS_KEEP));
+  double per_block = 5 + 2.0 * std::max<size_t>(1, keep);
+  if (rt)
+    per_block += 6; // Previous density/Fock, propagator, dipole-coupled Fock
+  e.matrix_bytes = 4 * n_ao * n_ao * 8 + spin_blocks * per_block * dim2 * element_bytes;
+
+  // Two-electron integrals
+  const std::string ints_alg = upper(parameter("INTS", "ALG"));
+  const bool density_fitted =
+      !parameter("INTS", "RI").empty() ||
+      upper(e.basis).compare(0, 3, "CD-") == 0 || upper(e.basis).compare(0, 3, "RI-") == 0;
+  if (density_fitted) {
+    e.integral_bytes = 4 * n_ao * n_ao * n_ao * 8; // ~4N auxiliary functions
+  } else if (ints_alg == "INCORE") {
+    e.integral_bytes = n_ao * n_ao * n_ao * n_ao / 8 * 8;
+  }
+
+  // Fock-build work, relative to one RHF build
+  const double build_work =
+      std::pow(n_ao, 4) / 8 * (e.components == 1 ? spin_blocks : 4.0);
+  e.fock_builds = SCF_ITERATIONS;
+  e.scaling = density_fitted ? "N^3 (fitted)" : "N^4";
+  double work = 0;
+
+  if (e.job == "RT" || e.job == "EHRENFEST") {
+    const std::string section = e.job == "RT" ? "RT" : "DYNAMICS";
+    double dt = to_double(parameter(section, "DELTAT"), 0);
+    double steps = to_double(parameter(section, "MAXSTEPS"), 0);
+    double tmax = to_double(parameter(section, "TMAX"), 0);
+    if (steps <= 0 && dt > 0)
+      steps = std::floor((tmax + dt / 4) / dt);
+    if (steps <= 0)
+      e.notes.push_back("no " + section + ".MAXSTEPS or TMAX/DELTAT; "
+                        "propagation not counted");
+    e.fock_builds += steps * builds_per_step(upper(parameter("RT", "INTALG")));
+  } else if (e.job == "BOMD") {
+    double dt = to_double(parameter("DYNAMICS", "DELTAT"), 0);
+    double tmax = to_double(parameter("DYNAMICS", "TMAX"), 0);
+    double steps = dt > 0 ? std::floor((tmax + dt / 4) / dt) : 0;
+    e.fock_builds += steps * SCF_ITERATIONS / 2; // Warm-started SCF per step
+    e.notes.push_back("nuclear gradients not counted");
+  } else if (e.job == "RESP") {
+    double roots = to_int(parameter("RESPONSE", "NROOTS"), 3);
+    e.fock_builds += roots * RESPONSE_BUILDS_PER_ROOT;
+  } else if (e.job == "CC" || e.job == "EOMCC") {
+    // Spin-orbital CCSD: <ab||cd> and friends dominate memory, o^2 v^4 work
+    const double so = e.components == 1 ? 2 * n : static_cast<double>(e.dimension) / (e.components == 4 ? 3 : 1);
+    const double o = e.electrons, v = std::max(0.0, so - o);
+    e.correlated_bytes = (std::pow(v, 4) / 4 + std::pow(v, 3) * o / 2 +
+                          4 * v * v * o * o + std::pow(o, 3) * v) *
+                         element_bytes;
+    work += CC_ITERATIONS * o * o * std::pow(v, 4) / 4;
+    e.scaling = "o^2 v^4";
+    if (e.job == "EOMCC")
+      e.notes.push_back("EOM roots not counted beyond one CCSD solve");
+  } else if (e.job == "MCSCF") {
+    std::istringstream nacto(parameter("MCSCF", "NACTO"));
+    int orbitals = 0, part;
+    while (nacto >> part) // RAS lists three spaces
+      orbitals += part;
+    const int active_electrons = to_int(parameter("MCSCF", "NACTE"), 0);
+    const int roots = std::max(1, to_int(parameter("MCSCF", "NROOTS"), 1));
+    double dets;
+    if (e.components == 1) {
+      int beta = (active_electrons - (mult - 1)) / 2;
+      dets = choose(orbitals, active_electrons - beta) * choose(orbitals, beta);
+    } else {
+      dets = choose(2 * orbitals, active_electrons);
+    }
+    if (orbitals == 0)
+      e.notes.push_back("no MCSCF.NACTO; CI space not counted");
+    const double subspace = std::max(10, 4 * roots);
+    e.correlated_bytes = 2 * subspace * dets * element_bytes;
+    work += CI_ITERATIONS * dets * std::pow(orbitals, 4) * roots;
+    e.scaling = "CI space (" + std::to_string(static_cast<long long>(dets)) + " dets)";
+  } else if (e.job != "SCF") {
+    e.notes.push_back("job " + e.job + " not modelled beyond its SCF");
+  }
+
+  work += e.fock_builds * build_work;
+  if (e.complex)
+    work *= 2;
+  e.relative_cost = work / WATER_SCF_WORK;
+  e.total_bytes = e.matrix_bytes + e.integral_bytes + e.correlated_bytes;
+  e.requested_bytes = parse_memory(upper(parameter("MISC", "MEM")));
+  if (e.requested_bytes > 0 && e.total_bytes > e.requested_bytes)
+    e.notes.push_back("needs " + format_bytes(e.total_bytes) + " but MISC.MEM is " +
+                      format_bytes(e.requested_bytes));
+  return e;
+}
+
+// --- Output ---
+
+std::string format_bytes(double bytes) {
+  static const char *const UNITS[] = {"B", "KB", "MB", "GB", "TB", "PB"};
+  int unit = 0;
+  while (bytes >= 1000 && unit < 5) {
+    bytes /= 1000;
+    ++unit;
+  }
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), unit ? "%.1f %s" : "%.0f %s", bytes, UNITS[unit]);
+  return buf;
+}
+
+static std::string json_string(const std::string &s) {
+  std::string out = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buf[8];
+      std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+      out += buf;
+    } else {
+      out += c;
+    }
+  }
+  return out + "\"";
+}
+
+static std::string json_number(double v) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.6g", v);
+  return buf;
+}
+
+std::string estimate_json(const JobEstimate &e, const std::string &filename,
+                          size_t atoms) {
+  std::ostringstream o;
+  o << "{\"file\": " << json_string(filename) << ", \"job\": " << json_string(e.job)
+    << ", \"atoms\": " << atoms << ", \"electrons\": " << e.electrons
+    << ", \"basis\": " << json_string(e.basis)
+    << ", \"basis_functions\": " << e.basis_functions
+    << ", \"cartesian\": " << (e.cartesian ? "true" : "false")
+    << ", \"reference\": " << json_string(e.reference)
+    << ", \"components\": " << e.components
+    << ", \"complex\": " << (e.complex ? "true" : "false")
+    << ", \"dimension\": " << e.dimension
+    << ", \"fock_builds\": " << json_number(e.fock_builds)
+    << ", \"memory_bytes\": {\"matrices\": " << json_number(e.matrix_bytes)
+    << ", \"integrals\": " << json_number(e.integral_bytes)
+    << ", \"correlated\": " << json_number(e.correlated_bytes)
+    << ", \"total\": " << json_number(e.total_bytes)
+    << ", \"requested\": " << json_number(e.requested_bytes) << "}"
+    << ", \"scaling\": " << json_string(e.scaling)
+    << ", \"relative_cost\": " << json_number(e.relative_cost) << ", \"notes\": [";
+  for (size_t i = 0; i < e.notes.size(); ++i)
+    o << (i ? ", " : "") << json_string(e.notes[i]);
+  o << "]}";
+  return o.str();
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Geometry.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Projected size and cost of one ChronusQ job, derived from the parsed
+ *        input only (nothing is run).
+ *
+ * Memory counts the AO matrices the job keeps (Fock, density, DIIS history,
+ * propagation), stored two-electron integrals and the correlated amplitudes or
+ * CI vectors. Cost is the formal operation count of the dominant step,
+ * reported relative to an RHF/6-31G(d) SCF on water so jobs can be ranked.
+ */
+struct JobEstimate {
+  std::string job;       ///< QM.JOB (SCF when unset)
+  std::string basis;     ///< BASIS.BASIS as written
+  std::string reference; ///< QM.REFERENCE after AUTO resolution
+  int basis_functions = 0;
+  bool cartesian = false;
+  int components = 1;    ///< 1, 2 (G/2C/X2C) or 4 (4C)
+  bool complex = false;  ///< Complex matrices (relativistic or RT)
+  int electrons = 0;
+  size_t dimension = 0;  ///< Order of the Fock matrix
+  double fock_builds = 0;
+
+  double matrix_bytes = 0;     ///< Fock/density/DIIS/propagator matrices
+  double integral_bytes = 0;   ///< Stored ERIs (0 for INTS.ALG = DIRECT)
+  double correlated_bytes = 0; ///< CC amplitudes/integrals or CI vectors
+  double total_bytes = 0;
+  double requested_bytes = 0;  ///< MISC.MEM (0 if unset)
+
+  std::string scaling; ///< Dominant formal scaling, e.g. "N^4"
+  double relative_cost = 0;
+  std::vector<std::string> notes; ///< Unknown elements, unmodelled parts
+};
+
+/**
+ * \brief Contracted basis functions of element Z in a named basis set from the
+ *        embedded library (Pople, Dunning cc-pVXZ/aug-cc-pVXZ, Karlsruhe
+ *        def2). A leading CD- or RI- is ignored.
+ *
+ * \returns The function count, or -1 if the basis or element is not known
+ */
+int basis_function_count(const std::string &basis, uint8_t z, bool cartesian);
+
+// Pople sets are Cartesian in ChronusQ's basis library, the others spherical
+bool basis_is_cartesian(const std::string &basis);
+
+/**
+ * \brief Estimate the job described by an input file.
+ *
+ * \param [in] atoms      Geometry (only element numbers are used)
+ * \param [in] charge     MOLECULE.CHARGE
+ * \param [in] mult       MOLECULE.MULT
+ * \param [in] parameter  Value of SECTION.KEY ("" if unset)
+ */
+JobEstimate estimate_job(
+    const std::vector<Atom> &atoms, int charge, int mult,
+    const std::function<std::string(const std::string &, const std::string &)>
+        &parameter);
+
+// One JSON object (no trailing newline) describing the estimate
+std::string estimate_json(const JobEstimate &estimate,
+                          const std::string &filename, size_t atoms);
+
+// Bytes as "1.2 GB"
+std::string format_bytes(double bytes);
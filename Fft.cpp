@@ -0,0 +1,76 @@
+#include "Fft.hpp"
+#include <cmath>
+
+std::vector<std::complex<double>> fft_twiddles(size_t n) {
+  // Computed directly rather than by recurrence, for accuracy at millions
+  // of points
+  std::vector<std::complex<double>> w(n / 2);
+  for (size_t k = 0; k < n / 2; ++k)
+    w[k] = std::polar(1.0, -2.0 * M_PI * k / n);
+  return w;
+}
+
+// Both directions recurse depth first, so once a half fits in cache all its
+// stages run there instead of streaming the whole array once per stage. `w`
+// holds the twiddles of the full transform and `stride` is full size / n.
+// Products are written out: std::complex's operator* checks for NaN/inf.
+
+// Decimation in frequency: natural order in, bit-reversed out
+static void forward(std::complex<double> *a, size_t n,
+                    const std::complex<double> *w, size_t stride) {
+  const size_t half = n / 2;
+  for (size_t k = 0; k < half; ++k) {
+    const std::complex<double> u = a[k], v = a[k + half], t = w[k * stride];
+    const double re = u.real() - v.real(), im = u.imag() - v.imag();
+    a[k] = u + v;
+    a[k + half] = {re * t.real() - im * t.imag(),
+                   re * t.imag() + im * t.real()};
+  }
+  if (half > 1) {
+    forward(a, half, w, 2 * stride);
+    forward(a + half, half, w, 2 * stride);
+  }
+}
+
+// Decimation in time with conjugate twiddles: bit-reversed in, natural out
+static void inverse(std::complex<double> *a, size_t n,
+                    const std::complex<double> *w, size_t stride) {
+  const size_t half = n / 2;
+  if (half > 1) {
+    inverse(a, half, w, 2 * stride);
+    inverse(a + half, half, w, 2 * stride);
+  }
+  for (size_t k = 0; k < half; ++k) {
+    const std::complex<double> u = a[k], x = a[k + half], t = w[k * stride];
+    const std::complex<double> v(x.real() * t.real() + x.imag() * t.imag(),
+                                 x.imag() * t.real() - x.real() * t.imag());
+    a[k] = u + v;
+    a[k + half] = u - v;
+  }
+}
+
+void fft_forward(std::complex<double> *data, size_t n,
+                 const std::complex<double> *twiddles) {
+  if (n > 1)
+    forward(data, n, twiddles, 1);
+}
+
+void fft_inverse(std::complex<double> *data, size_t n,
+                 const std::complex<double> *twiddles) {
+  if (n > 1)
+    inverse(data, n, twiddles, 1);
+}
+
+size_t fft_bin(size_t j, size_t n) {
+  size_t r = 0;
+  for (size_t bit = 1; bit < n; bit <<= 1, j >>= 1)
+    r = (r << 1) | (j & 1);
+  return r;
+}
+
+size_t fft_size(size_t n) {
+  size_t size = 1;
+  while (size < n)
+    size <<= 1;
+  return size;
+}
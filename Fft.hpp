@@ -0,0 +1,27 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+// Radix-2 FFTs for power-of-2 sizes. The forward transform leaves its output
+// in bit-reversed order and the inverse takes its input in that order, so a
+// convolution (forward, multiply, inverse) never permutes; look single bins
+// up with fft_bin().
+
+// exp(-2πik/n) for k < n/2
+std::vector<std::complex<double>> fft_twiddles(size_t n);
+
+// X_j = Σ x_k exp(-2πijk/n) in place, X_j landing at fft_bin(j, n)
+void fft_forward(std::complex<double> *data, size_t n,
+                 const std::complex<double> *twiddles);
+
+// x_k = Σ X_j exp(2πijk/n) (not divided by n) from bit-reversed input
+void fft_inverse(std::complex<double> *data, size_t n,
+                 const std::complex<double> *twiddles);
+
+// Index of bin j in the output of fft_forward
+size_t fft_bin(size_t j, size_t n);
+
+// Smallest power of 2 >= n
+size_t fft_size(size_t n);
@@ -0,0 +1,386 @@
+#include "Fleet.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/inotify.h>
+#endif
+
+namespace fs = std::filesystem;
+
+// Iterations fitted when extrapolating an SCF's convergence
+static const size_t ETA_FIT = 5;
+
+// --- Progress ---
+
+void ProgressRate::add(std::chrono::steady_clock::time_point t,
+                       double value) {
+  if (std::isnan(v0) || value < v1) { // First sample, or the job restarted
+    t0 = t;
+    v0 = value;
+  }
+  t1 = t;
+  v1 = value;
+}
+
+double ProgressRate::per_second() const {
+  const double seconds = std::chrono::duration<double>(t1 - t0).count();
+  return seconds > 0 && v1 > v0 ? (v1 - v0) / seconds : NAN;
+}
+
+JobStatus FleetJob::status() const {
+  if (log.rt_step >= 0)
+    return total_steps > 0 && log.rt_step >= total_steps ? JobStatus::DONE
+                                                         : JobStatus::RT;
+  switch (log.state) {
+  case ScfState::RUNNING:
+    return JobStatus::SCF;
+  case ScfState::FAILED:
+    return JobStatus::FAILED;
+  case ScfState::CONVERGED:
+    // Anything but a single point goes on after the SCF
+    return data.get_parameter("QM", "JOB") == "SCF" ? JobStatus::DONE
+                                                    : JobStatus::CONVERGED;
+  default:
+    return JobStatus::WAITING;
+  }
+}
+
+double FleetJob::eta() const {
+  const JobStatus s = status();
+  if (s == JobStatus::RT && total_steps > 0)
+    return (total_steps - log.rt_step) / rt_rate.per_second();
+  if (s != JobStatus::SCF || log.iterations.size() < 2)
+    return NAN;
+
+  // Fit log10 |ΔE| and |ΔP| over the last iterations and extrapolate each
+  // to its threshold (ΔE converges at 100x the accuracy, as in describe_scf)
+  double iterations = 0.0;
+  auto remaining = [&](double ScfIteration::*member, double threshold) {
+    const size_t n = std::min(ETA_FIT, log.iterations.size());
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    size_t count = 0;
+    for (size_t i = log.iterations.size() - n; i < log.iterations.size();
+         ++i) {
+      const double v = std::fabs(log.iterations[i].*member);
+      if (!(v > 0))
+        continue;
+      const double x = log.iterations[i].iteration, y = std::log10(v);
+      sx += x;
+      sy += y;
+      sxx += x * x;
+      sxy += x * y;
+      ++count;
+    }
+    const double den = count * sxx - sx * sx;
+    if (count < 2 || den <= 0)
+      return;
+    const double slope = (count * sxy - sx * sy) / den;
+    const double last = std::log10(std::fabs(log.iterations.back().*member));
+    if (slope < 0 && std::isfinite(last))
+      iterations = std::max(
+          iterations, (last - std::log10(threshold)) / -slope);
+  };
+  remaining(&ScfIteration::delta_energy, 100 * accuracy);
+  remaining(&ScfIteration::delta_density, accuracy);
+  return iterations > 0 ? iterations / scf_rate.per_second() : NAN;
+}
+
+// --- Watching ---
+
+Fleet::Fleet() {
+#if defined(__linux__)
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  notify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.fd = notify_fd_;
+  if (epoll_fd_ < 0 || notify_fd_ < 0 ||
+      epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, notify_fd_, &event) != 0) {
+    if (notify_fd_ >= 0)
+      close(notify_fd_);
+    notify_fd_ = -1;
+  }
+#endif
+}
+
+Fleet::~Fleet() {
+  jobs.clear(); // Followers close their files first
+  if (notify_fd_ >= 0)
+    close(notify_fd_);
+  if (epoll_fd_ >= 0)
+    close(epoll_fd_);
+}
+
+void Fleet::add_job(const std::string &input) {
+  FleetJob job;
+  job.input = input;
+  const fs::path path(input);
+  fs::path output = path;
+  job.output = output.replace_extension(".out").string();
+  const std::string dir =
+      path.has_parent_path() ? path.parent_path().string() : ".";
+  job.name = (path.has_parent_path()
+                  ? path.parent_path().filename() / path.stem()
+                  : path.stem())
+                 .string();
+
+  job.data = parse_inp_file(input);
+  job.accuracy = scf_accuracy(job.data.get_parameter("SCF", "ACCURACY"));
+  if (job.data.get_parameter("QM", "JOB") == "RT") {
+    auto number = [&](const char *key) {
+      return std::atof(job.data.get_parameter("RT", key).c_str());
+    };
+    const double dt = number("DELTAT");
+    job.total_steps = static_cast<long>(number("MAXSTEPS"));
+    if (job.total_steps <= 0 && dt > 0)
+      job.total_steps = static_cast<long>((number("TMAX") + dt / 4) / dt);
+  }
+
+  // One watch per directory, shared by its jobs; without one a job follows
+  // its output on its own
+  int wd = -1;
+#if defined(__linux__)
+  if (notify_fd_ >= 0) {
+    auto it = directories_.find(dir);
+    wd = it != directories_.end()
+             ? it->second
+             : inotify_add_watch(notify_fd_, dir.c_str(),
+                                 IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE |
+                                     IN_MOVED_TO);
+    if (wd >= 0)
+      directories_[dir] = wd;
+  }
+#endif
+  job.follower = std::make_unique<OutputFollower>(job.output, wd < 0);
+  if (wd >= 0)
+    watches_[wd][job.follower->name()].push_back(jobs.size());
+  else
+    unwatched_.push_back(jobs.size());
+  jobs.push_back(std::move(job));
+}
+
+void Fleet::add_wakeup(int fd) {
+  wakeups_.push_back(fd);
+#if defined(__linux__)
+  if (notify_fd_ >= 0) {
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+  }
+#endif
+}
+
+bool Fleet::update(size_t index) {
+  FleetJob &job = jobs[index];
+  if (!job.follower->poll(job.log))
+    return false;
+  const auto now = std::chrono::steady_clock::now();
+  struct stat st;
+  if (stat(job.output.c_str(), &st) == 0)
+    job.modified = st.st_mtime;
+  if (job.log.rt_step >= 0)
+    job.rt_rate.add(now, static_cast<double>(job.log.rt_step));
+  if (!job.log.iterations.empty()) {
+    if (job.scf_seen != job.log.scf_count) {
+      job.scf_rate = ProgressRate();
+      job.scf_seen = job.log.scf_count;
+    }
+    job.scf_rate.add(now, job.log.iterations.back().iteration);
+  }
+  return true;
+}
+
+size_t Fleet::refresh() {
+  size_t changed = 0;
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    jobs[i].follower->notify();
+    changed += update(i);
+  }
+  return changed;
+}
+
+size_t Fleet::wait(int timeout_ms) {
+  if (notify_fd_ < 0) {
+    // Sleep on the wakeup descriptors, then stat every output
+    std::vector<pollfd> fds;
+    for (int fd : wakeups_)
+      fds.push_back({fd, POLLIN, 0});
+    ::poll(fds.data(), fds.size(), timeout_ms);
+    size_t changed = 0;
+    for (size_t i = 0; i < jobs.size(); ++i)
+      changed += update(i);
+    return changed;
+  }
+
+  std::vector<size_t> touched = unwatched_;
+#if defined(__linux__)
+  epoll_event events[8];
+  const int n = epoll_wait(epoll_fd_, events, 8, timeout_ms);
+  for (int e = 0; e < n; ++e) {
+    if (events[e].data.fd != notify_fd_)
+      continue;
+    alignas(inotify_event) char buf[16384];
+    for (ssize_t len; (len = read(notify_fd_, buf, sizeof(buf))) > 0;)
+      for (ssize_t pos = 0; pos < len;) {
+        const auto *event = reinterpret_cast<const inotify_event *>(buf + pos);
+        pos += sizeof(inotify_event) + event->len;
+        if (event->mask & IN_Q_OVERFLOW) { // Events were lost: check all
+          for (size_t i = 0; i < jobs.size(); ++i)
+            touched.push_back(i);
+          continue;
+        }
+        auto dir = watches_.find(event->wd);
+        if (!event->len || dir == watches_.end())
+          continue;
+        auto name = dir->second.find(event->name);
+        if (name != dir->second.end())
+          touched.insert(touched.end(), name->second.begin(),
+                         name->second.end());
+      }
+  }
+#endif
+  std::sort(touched.begin(), touched.end());
+  touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+  size_t changed = 0;
+  for (size_t i : touched) {
+    jobs[i].follower->notify();
+    changed += update(i);
+  }
+  return changed;
+}
+
+std::vector<std::string>
+find_job_inputs(const std::vector<std::string> &paths) {
+  std::vector<std::string> inputs;
+  auto is_input = [](const fs::path &p) { return p.extension() == ".inp"; };
+  for (const auto &path : paths) {
+    std::error_code ec;
+    if (!fs::is_directory(path, ec)) {
+      if (is_input(path))
+        inputs.push_back(path);
+      continue;
+    }
+    for (fs::directory_iterator it(path, ec), end; it != end;
+         it.increment(ec)) {
+      if (ec)
+        break;
+      if (it->is_directory(ec)) {
+        for (fs::directory_iterator sub(it->path(), ec); sub != end;
+             sub.increment(ec)) {
+          if (ec)
+            break;
+          if (is_input(sub->path()) && sub->is_regular_file(ec))
+            inputs.push_back(sub->path().string());
+        }
+      } else if (is_input(it->path())) {
+        inputs.push_back(it->path().string());
+      }
+    }
+  }
+  std::sort(inputs.begin(), inputs.end());
+  inputs.erase(std::unique(inputs.begin(), inputs.end()), inputs.end());
+  return inputs;
+}
+
+// --- Description ---
+
+const char *job_status_name(JobStatus status) {
+  switch (status) {
+  case JobStatus::SCF:
+    return "SCF     ";
+  case JobStatus::RT:
+    return "RT      ";
+  case JobStatus::CONVERGED:
+    return "post-SCF";
+  case JobStatus::FAILED:
+    return "FAILED  ";
+  case JobStatus::DONE:
+    return "done    ";
+  default:
+    return "waiting ";
+  }
+}
+
+// "42s", "3m12s", "2h05m", "3d04h"
+static std::string format_duration(double seconds) {
+  char buf[32];
+  const long s = static_cast<long>(seconds + 0.5);
+  if (s < 60)
+    std::snprintf(buf, sizeof(buf), "%lds", s);
+  else if (s < 3600)
+    std::snprintf(buf, sizeof(buf), "%ldm%02lds", s / 60, s % 60);
+  else if (s < 86400)
+    std::snprintf(buf, sizeof(buf), "%ldh%02ldm", s / 3600, s / 60 % 60);
+  else
+    std::snprintf(buf, sizeof(buf), "%ldd%02ldh", s / 86400, s / 3600 % 24);
+  return buf;
+}
+
+static std::string fit(std::string text, size_t width) {
+  if (text.size() > width)
+    text.resize(width);
+  return text;
+}
+
+std::vector<std::string> describe_job(const FleetJob &job, int width) {
+  const JobStatus status = job.status();
+  const ScfLog &log = job.log;
+  char buf[160];
+  std::string progress;
+  if (status == JobStatus::RT || (status == JobStatus::DONE &&
+                                  log.rt_step >= 0)) {
+    std::snprintf(buf, sizeof(buf), "step %ld", log.rt_step);
+    progress = buf;
+    if (job.total_steps > 0)
+      progress += "/" + std::to_string(job.total_steps);
+    if (std::isfinite(log.rt_time)) {
+      std::snprintf(buf, sizeof(buf), " t=%.2f", log.rt_time);
+      progress += buf;
+    }
+  } else if (!log.iterations.empty()) {
+    const ScfIteration &last = log.iterations.back();
+    std::snprintf(buf, sizeof(buf), "it %d E=%.8f", last.iteration,
+                  last.energy);
+    progress = buf;
+    if (status == JobStatus::SCF && std::isfinite(last.delta_energy)) {
+      std::snprintf(buf, sizeof(buf), " dE=%.1e",
+                    std::fabs(last.delta_energy));
+      progress += buf;
+    }
+  } else {
+    progress = job.modified ? "started" : "no output yet";
+  }
+  const double eta = job.eta();
+  const std::string eta_text =
+      std::isfinite(eta) && eta >= 0 ? "ETA " + format_duration(eta) : "";
+
+  const int name_width = std::clamp(width / 4, 8, 28);
+  std::snprintf(buf, sizeof(buf), "%-*.*s %s ", name_width, name_width,
+                job.name.c_str(), job_status_name(status));
+  std::string first = buf + progress;
+  const int room = width - static_cast<int>(eta_text.size()) - 1;
+  if (!eta_text.empty() && room > static_cast<int>(first.size()))
+    first += std::string(room - first.size(), ' ') + eta_text;
+
+  const std::string reference = job.data.get_parameter("QM", "REFERENCE");
+  const std::string basis = job.data.get_parameter("BASIS", "BASIS");
+  const std::string kind = job.data.get_parameter("QM", "JOB");
+  std::string second = std::string(name_width + 1, ' ') +
+                       job.data.get_formula() +
+                       (kind.empty() ? "" : " " + kind) +
+                       (reference.empty() ? "" : " " + reference) +
+                       (basis.empty() ? "" : "/" + basis);
+  if (job.modified) {
+    const double age = std::difftime(std::time(nullptr), job.modified);
+    second += ", written " + format_duration(std::max(0.0, age)) + " ago";
+  }
+  return {fit(first, width), fit(second, width)};
+}
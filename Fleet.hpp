@@ -0,0 +1,100 @@
+#pragma once
+
+#include "InputFile.hpp"
+#include "ScfMonitor.hpp"
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class JobStatus { WAITING, SCF, RT, CONVERGED, FAILED, DONE };
+
+// Progress per second between the first and the latest change seen
+struct ProgressRate {
+  std::chrono::steady_clock::time_point t0, t1;
+  double v0 = NAN, v1 = NAN;
+
+  void add(std::chrono::steady_clock::time_point t, double value);
+  double per_second() const; ///< NaN until progress was seen twice
+};
+
+/**
+ * \brief One ChronusQ job of a fleet: its input, the output next to it
+ *        (same stem, .out) and what has been parsed of that output.
+ */
+struct FleetJob {
+  std::string input, output, name;
+  InputFileData data;
+  double accuracy = 0.0;  ///< SCF.ACCURACY
+  long total_steps = 0;   ///< RT.MAXSTEPS (or TMAX / DELTAT), 0 if not RT
+
+  ScfLog log;
+  std::unique_ptr<OutputFollower> follower;
+  std::time_t modified = 0;   ///< Output mtime, 0 before it exists
+  ProgressRate rt_rate;       ///< Steps per second
+  ProgressRate scf_rate;      ///< Iterations per second
+  size_t scf_seen = 0;        ///< SCFs counted when scf_rate started
+
+  JobStatus status() const;
+  // Seconds until the run (RT) or the current SCF finishes, NaN if unknown
+  double eta() const;
+};
+
+/**
+ * \brief Watches the outputs of many jobs with one inotify instance and one
+ *        epoll set, reading only the bytes appended to files that changed.
+ *
+ * Each directory holding a job is watched once. wait() sleeps until an
+ * output changes (or another added descriptor, such as stdin, is readable)
+ * and then polls only the jobs named by the events. Without inotify every
+ * wait() stats all outputs after sleeping.
+ */
+class Fleet {
+  int epoll_fd_ = -1, notify_fd_ = -1;
+  // Watch descriptor -> output name -> jobs
+  std::unordered_map<int, std::unordered_map<std::string, std::vector<size_t>>>
+      watches_;
+  std::unordered_map<std::string, int> directories_;
+  std::vector<size_t> unwatched_; ///< Jobs polled on every wait()
+  std::vector<int> wakeups_;
+
+  bool update(size_t job);
+
+public:
+  std::vector<FleetJob> jobs;
+
+  Fleet();
+  ~Fleet();
+  Fleet(const Fleet &) = delete;
+  Fleet &operator=(const Fleet &) = delete;
+
+  void add_job(const std::string &input);
+  // Also return from wait() when fd is readable
+  void add_wakeup(int fd);
+  // Read every output from where it was left; returns the jobs that changed
+  size_t refresh();
+
+  /**
+   * \returns Number of jobs whose output changed (0 on a timeout or when an
+   *          added descriptor woke the wait)
+   */
+  size_t wait(int timeout_ms);
+};
+
+/**
+ * \brief The .inp files of each argument: a file as given, a directory's
+ *        inputs and those of its immediate subdirectories, sorted by path.
+ */
+std::vector<std::string> find_job_inputs(const std::vector<std::string> &paths);
+
+/**
+ * \brief Two table lines for a job, `width` columns wide: name, status,
+ *        progress and ETA, then formula, method and the output's age.
+ */
+std::vector<std::string> describe_job(const FleetJob &job, int width);
+
+// Status as a word, padded to a fixed width
+const char *job_status_name(JobStatus status);
@@ -0,0 +1,247 @@
+#include "Geometry.hpp"
+#include "Elements.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Cell along one axis for a position in cell units, clamped to the grid
+static int cell_coord(double c, int dim) {
+  return c >= 0.0 ? (c < dim ? static_cast<int>(c) : dim - 1) : 0;
+}
+
+CellList::CellList(const std::vector<Atom> &atoms, double cell_size)
+    : cell_size_(cell_size > 0.0 ? cell_size : 1.0) {
+  // Non-finite positions (a corrupt log, a failed step) are left out of the
+  // grid; they would otherwise blow up the bounding box
+  auto finite = [](const Atom &a) {
+    return std::isfinite(a.x) && std::isfinite(a.y) && std::isfinite(a.z);
+  };
+  auto first = std::find_if(atoms.begin(), atoms.end(), finite);
+  if (first == atoms.end()) {
+    cell_start_.assign(2, 0);
+    return;
+  }
+
+  double lo[3] = {first->x, first->y, first->z};
+  double hi[3] = {lo[0], lo[1], lo[2]};
+  for (const auto &a : atoms) {
+    if (!finite(a))
+      continue;
+    const double p[3] = {a.x, a.y, a.z};
+    for (int d = 0; d < 3; ++d) {
+      lo[d] = std::min(lo[d], p[d]);
+      hi[d] = std::max(hi[d], p[d]);
+    }
+  }
+
+  // Keep the grid at most a few cells per atom so sparse systems with a
+  // large bounding box do not allocate a huge empty grid
+  const double max_cells = std::max<double>(64.0, 4.0 * atoms.size());
+  for (int grow = 0;; ++grow) {
+    double cells = 1.0;
+    for (int d = 0; d < 3; ++d)
+      cells *= std::floor((hi[d] - lo[d]) / cell_size_) + 1.0;
+    if (cells <= max_cells)
+      break;
+    if (grow == 100) { // Absurd extents: a single cell
+      cell_size_ = INFINITY;
+      break;
+    }
+    cell_size_ *= 1.5;
+  }
+  for (int d = 0; d < 3; ++d) {
+    origin_[d] = lo[d];
+    const double n = std::floor((hi[d] - lo[d]) / cell_size_) + 1.0;
+    dims_[d] = n >= 1.0 && n <= max_cells ? static_cast<int>(n) : 1;
+  }
+
+  // Counting sort of atoms into cells
+  const size_t ncells = static_cast<size_t>(dims_[0]) * dims_[1] * dims_[2];
+  std::vector<uint32_t> atom_cell(atoms.size());
+  cell_start_.assign(ncells + 1, 0);
+  size_t indexed = 0;
+  for (size_t i = 0; i < atoms.size(); ++i) {
+    if (!finite(atoms[i])) {
+      atom_cell[i] = UINT32_MAX;
+      continue;
+    }
+    int ix = cell_coord((atoms[i].x - origin_[0]) / cell_size_, dims_[0]);
+    int iy = cell_coord((atoms[i].y - origin_[1]) / cell_size_, dims_[1]);
+    int iz = cell_coord((atoms[i].z - origin_[2]) / cell_size_, dims_[2]);
+    atom_cell[i] = static_cast<uint32_t>(cell_index(ix, iy, iz));
+    cell_start_[atom_cell[i] + 1]++;
+    ++indexed;
+  }
+  for (size_t c = 0; c < ncells; ++c)
+    cell_start_[c + 1] += cell_start_[c];
+  items_.resize(indexed);
+  std::vector<uint32_t> fill(cell_start_.begin(), cell_start_.end() - 1);
+  for (size_t i = 0; i < atoms.size(); ++i)
+    if (atom_cell[i] != UINT32_MAX)
+      items_[fill[atom_cell[i]]++] = static_cast<uint32_t>(i);
+}
+
+void CellList::query(double x, double y, double z, double radius,
+                     std::vector<uint32_t> &out,
+                     const std::vector<Atom> &atoms) const {
+  out.clear();
+  if (items_.empty())
+    return;
+  const double p[3] = {x, y, z};
+  int lo[3], hi[3];
+  for (int d = 0; d < 3; ++d) {
+    const double a = std::floor((p[d] - radius - origin_[d]) / cell_size_);
+    const double b = std::floor((p[d] + radius - origin_[d]) / cell_size_);
+    if (!(a < dims_[d] && b >= 0.0)) // Outside the grid, or not finite
+      return;
+    lo[d] = cell_coord(a, dims_[d]);
+    hi[d] = cell_coord(b, dims_[d]);
+  }
+  const double r2 = radius * radius;
+  for (int iz = lo[2]; iz <= hi[2]; ++iz)
+    for (int iy = lo[1]; iy <= hi[1]; ++iy)
+      for (int ix = lo[0]; ix <= hi[0]; ++ix) {
+        size_t c = cell_index(ix, iy, iz);
+        for (uint32_t k = cell_start_[c]; k < cell_start_[c + 1]; ++k) {
+          const Atom &a = atoms[items_[k]];
+          double dx = a.x - x, dy = a.y - y, dz = a.z - z;
+          if (dx * dx + dy * dy + dz * dz <= r2)
+            out.push_back(items_[k]);
+        }
+      }
+}
+
+AtomColumns::AtomColumns(const std::vector<Atom> &atoms) {
+  x.reserve(atoms.size());
+  y.reserve(atoms.size());
+  z.reserve(atoms.size());
+  element.reserve(atoms.size());
+  for (const auto &a : atoms) {
+    x.push_back(a.x);
+    y.push_back(a.y);
+    z.push_back(a.z);
+    element.push_back(a.element);
+  }
+}
+
+std::vector<uint32_t> find_fragments(const std::vector<Atom> &atoms,
+                                     double tolerance) {
+  const size_t n = atoms.size();
+  std::vector<uint32_t> parent(n);
+  for (size_t i = 0; i < n; ++i)
+    parent[i] = static_cast<uint32_t>(i);
+  auto find = [&](uint32_t i) {
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]]; // Path halving
+      i = parent[i];
+    }
+    return i;
+  };
+
+  double max_radius = 0.0;
+  for (const auto &a : atoms)
+    max_radius =
+        std::max(max_radius, elements::get(a.element).covalent_radius);
+  const double cutoff = 2.0 * max_radius * tolerance;
+  CellList grid(atoms, cutoff);
+
+  std::vector<uint32_t> neighbors;
+  for (size_t i = 0; i < n; ++i) {
+    const Atom &a = atoms[i];
+    const double ri = elements::get(a.element).covalent_radius;
+    grid.query(a.x, a.y, a.z, cutoff, neighbors, atoms);
+    for (uint32_t j : neighbors) {
+      if (j <= i)
+        continue;
+      const Atom &b = atoms[j];
+      const double bond =
+          tolerance * (ri + elements::get(b.element).covalent_radius);
+      const double dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+      if (dx * dx + dy * dy + dz * dz <= bond * bond) {
+        uint32_t ra = find(static_cast<uint32_t>(i)), rb = find(j);
+        if (ra != rb)
+          parent[std::max(ra, rb)] = std::min(ra, rb);
+      }
+    }
+  }
+
+  // Compact root ids to 0..k-1 in order of first appearance
+  std::vector<uint32_t> fragment(n), label(n, UINT32_MAX);
+  uint32_t next = 0;
+  for (size_t i = 0; i < n; ++i) {
+    uint32_t root = find(static_cast<uint32_t>(i));
+    if (label[root] == UINT32_MAX)
+      label[root] = next++;
+    fragment[i] = label[root];
+  }
+  return fragment;
+}
+
+void compute_ambient_occlusion(std::vector<Atom> &atoms, int samples,
+                               double max_distance) {
+  if (atoms.empty() || samples <= 0)
+    return;
+
+  // Evenly spread ray directions (Fibonacci sphere)
+  std::vector<Vec3> dirs(samples);
+  const double golden = M_PI * (3.0 - std::sqrt(5.0));
+  for (int k = 0; k < samples; ++k) {
+    double y = 1.0 - 2.0 * (k + 0.5) / samples;
+    double r = std::sqrt(1.0 - y * y);
+    dirs[k] = {r * std::cos(golden * k), y, r * std::sin(golden * k)};
+  }
+
+  double max_radius = 0.0;
+  for (const auto &a : atoms)
+    max_radius = std::max(max_radius, elements::get(a.element).vdw_radius);
+
+  // Any occluder must lie within this distance of the atom center
+  const double reach = 2.0 * max_radius + max_distance;
+  CellList grid(atoms, reach);
+
+  auto worker = [&](size_t begin, size_t end) {
+    std::vector<uint32_t> neighbors;
+    for (size_t i = begin; i < end; ++i) {
+      Atom &atom = atoms[i];
+      const double ri = elements::get(atom.element).vdw_radius;
+      grid.query(atom.x, atom.y, atom.z, reach, neighbors, atoms);
+
+      int open = 0;
+      for (const auto &d : dirs) {
+        // Ray segment from the atom surface outwards
+        const double ox = atom.x + d.x * ri, oy = atom.y + d.y * ri,
+                     oz = atom.z + d.z * ri;
+        bool hit = false;
+        for (uint32_t j : neighbors) {
+          if (j == i)
+            continue;
+          const Atom &b = atoms[j];
+          const double rj = elements::get(b.element).vdw_radius;
+          const double lx = b.x - ox, ly = b.y - oy, lz = b.z - oz;
+          const double c = lx * lx + ly * ly + lz * lz - rj * rj;
+          if (c <= 0.0) { // Surface point already buried in neighbor
+            hit = true;
+            break;
+          }
+          const double t = lx * d.x + ly * d.y + lz * d.z;
+          if (t <= 0.0)
+            continue;
+          const double disc = t * t - c;
+          if (disc >= 0.0 && t - std::sqrt(disc) <= max_distance) {
+            hit = true;
+            break;
+          }
+        }
+        if (!hit)
+          ++open;
+      }
+      atom.ao = static_cast<float>(open) / samples;
+    }
+  };
+
+  // Blocks of atoms on the shared pool
+  const size_t block = 256;
+  parallel_for((atoms.size() + block - 1) / block, [&](size_t b) {
+    worker(b * block, std::min(atoms.size(), (b + 1) * block));
+  });
+}
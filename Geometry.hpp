@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- Data Structures ---
+struct Atom {
+  uint8_t element; // Atomic number (0 = unknown), resolved once at parse time
+  double x, y, z;
+  float ao = 1.0f; // Unoccluded fraction, see compute_ambient_occlusion()
+};
+
+struct Vec3 {
+  double x, y, z;
+};
+
+/**
+ * \brief Orthographic camera: rotation, uniform scale and a screen offset.
+ *
+ * Built once per frame so every atom costs one 3x3 multiply instead of
+ * re-evaluating the trig of each rotation step.
+ */
+struct ViewTransform {
+  double m[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}; ///< World -> view
+  double scale = 1.0;                               ///< Pixels per Angstrom
+  double ox = 0.0, oy = 0.0; ///< Screen position of the view-space origin
+
+  Vec3 rotate(double x, double y, double z) const {
+    return {m[0][0] * x + m[0][1] * y + m[0][2] * z,
+            m[1][0] * x + m[1][1] * y + m[1][2] * z,
+            m[2][0] * x + m[2][1] * y + m[2][2] * z};
+  }
+
+  // Screen x/y in pixels (y flipped); z is view depth, larger = nearer
+  Vec3 project(double x, double y, double z) const {
+    Vec3 v = rotate(x, y, z);
+    return {ox + v.x * scale, oy - v.y * scale, v.z};
+  }
+};
+
+/**
+ * \brief Uniform grid over atom positions for fixed-radius neighbor queries.
+ *
+ * Atoms are bucketed by cell with a counting sort (CSR layout), so building
+ * is O(N) and a query only visits the cells overlapping its search sphere.
+ */
+class CellList {
+
+  double cell_size_ = 1.0;
+  double origin_[3] = {0.0, 0.0, 0.0};
+  int dims_[3] = {1, 1, 1};
+  std::vector<uint32_t> cell_start_; ///< Offset of each cell in items_
+  std::vector<uint32_t> items_;      ///< Atom indices sorted by cell
+
+  size_t cell_index(int ix, int iy, int iz) const {
+    return (static_cast<size_t>(iz) * dims_[1] + iy) * dims_[0] + ix;
+  }
+
+public:
+  /**
+   * \param [in] atoms     Atom positions to index
+   * \param [in] cell_size Requested edge length; grown if the bounding box
+   *                       would otherwise need an unreasonable number of cells
+   */
+  CellList(const std::vector<Atom> &atoms, double cell_size);
+
+  /**
+   * \brief Collect indices of atoms within `radius` of (x, y, z).
+   *        `out` is cleared first.
+   */
+  void query(double x, double y, double z, double radius,
+             std::vector<uint32_t> &out,
+             const std::vector<Atom> &atoms) const;
+
+  double cell_size() const { return cell_size_; }
+};
+
+/**
+ * \brief Column-wise (SoA) copy of atom data for bulk scans.
+ *
+ * Predicates such as "z > 3" touch one contiguous column instead of striding
+ * through Atom structs.
+ */
+struct AtomColumns {
+  std::vector<double> x, y, z;
+  std::vector<uint8_t> element;
+
+  explicit AtomColumns(const std::vector<Atom> &atoms);
+  size_t size() const { return element.size(); }
+};
+
+/**
+ * \brief Label bonded fragments (connected components of the bond graph).
+ *
+ * Two atoms are bonded when closer than `tolerance` times the sum of their
+ * covalent radii. Neighbors come from a CellList, so this is O(N).
+ *
+ * \returns Fragment id per atom, numbered from 0 in order of first atom
+ */
+std::vector<uint32_t> find_fragments(const std::vector<Atom> &atoms,
+                                     double tolerance = 1.2);
+
+/**
+ * \brief One-time per-atom ambient occlusion.
+ *
+ * Casts `samples` rays from each atom's van der Waals surface and stores the
+ * unoccluded fraction in Atom::ao. Occluders come from a CellList, and atoms
+ * are split across hardware threads. The result only depends on the
+ * geometry, so renderers can modulate shading with it at no per-frame cost.
+ */
+void compute_ambient_occlusion(std::vector<Atom> &atoms, int samples = 48,
+                               double max_distance = 4.0);
@@ -0,0 +1,194 @@
+#include "GeometryCheck.hpp"
+#include "Elements.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+// Nearest-neighbor distance over bond length when Bohr values are read as
+// Angstrom; anything between the bounds is reported as a unit mix-up, beyond
+// them the system is just sparse
+static const double BOHR_RATIO = 1.8897261;
+static const double BOHR_RATIO_LOW = 1.7, BOHR_RATIO_HIGH = 2.3;
+static const double SHRUNK_RATIO = 0.6;
+
+// Atoms per parallel_for item; small geometries (and the many files of a
+// batch lint, which is already parallel) stay on one thread
+static const size_t BLOCK = 2048;
+
+static std::string atom_name(uint32_t i, uint8_t element) {
+  return std::to_string(i + 1) + " (" + elements::get(element).symbol + ")";
+}
+
+static std::string format(const char *fmt, double value) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), fmt, value);
+  return buf;
+}
+
+namespace {
+
+struct BlockResult {
+  std::vector<GeometryIssue> pairs;
+  std::vector<std::pair<uint32_t, uint32_t>> bonds;
+};
+
+} // namespace
+
+std::vector<GeometryIssue> check_geometry(const std::vector<Atom> &atoms,
+                                          const GeometryCheckOptions &options) {
+  std::vector<GeometryIssue> issues;
+  const size_t n = atoms.size();
+  if (n < 2)
+    return issues;
+
+  double max_radius = 0.0;
+  for (const auto &a : atoms)
+    max_radius = std::max(max_radius, elements::get(a.element).covalent_radius);
+  const double max_ratio = std::max(BOHR_RATIO_HIGH, options.bond_tolerance);
+  CellList grid(atoms, 2.0 * max_radius * max_ratio);
+
+  // Per heavy atom: nearest neighbor distance over the covalent radius sum,
+  // NaN if nothing is within reach. Hydrogen is left out: stretched H chains
+  // and rings are common test systems and have no typical bond length.
+  std::vector<float> nearest(n, NAN);
+  const double dup2 = options.duplicate_distance * options.duplicate_distance;
+
+  const size_t blocks = (n + BLOCK - 1) / BLOCK;
+  std::vector<BlockResult> results(blocks);
+  auto check_block = [&](size_t b) {
+    BlockResult &out = results[b];
+    std::vector<uint32_t> neighbors;
+    const size_t end = std::min(n, (b + 1) * BLOCK);
+    for (size_t i = b * BLOCK; i < end; ++i) {
+      const Atom &a = atoms[i];
+      const double ri = elements::get(a.element).covalent_radius;
+      grid.query(a.x, a.y, a.z, (ri + max_radius) * max_ratio, neighbors,
+                 atoms);
+      double best = INFINITY;
+      for (uint32_t j : neighbors) {
+        if (j == i)
+          continue;
+        const Atom &o = atoms[j];
+        const double sum = ri + elements::get(o.element).covalent_radius;
+        const double dx = a.x - o.x, dy = a.y - o.y, dz = a.z - o.z;
+        const double d2 = dx * dx + dy * dy + dz * dz;
+        best = std::min(best, d2 / (sum * sum));
+        if (j < i)
+          continue; // Pairs are reported and bonded once, by their first atom
+
+        const uint32_t ai = static_cast<uint32_t>(i);
+        if (d2 <= options.bond_tolerance * options.bond_tolerance * sum * sum)
+          out.bonds.emplace_back(ai, j);
+        if (d2 < dup2) {
+          out.pairs.push_back({GeometryIssue::Kind::DUPLICATE, ai, j,
+                               "atoms " + atom_name(ai, a.element) + " and " +
+                                   atom_name(j, o.element) + " coincide"});
+        } else if (d2 < options.clash_fraction * options.clash_fraction * sum *
+                            sum) {
+          out.pairs.push_back(
+              {GeometryIssue::Kind::CLASH, ai, j,
+               "atoms " + atom_name(ai, a.element) + " and " +
+                   atom_name(j, o.element) + " are " +
+                   format("%.2f", std::sqrt(d2)) + " Å apart (bond ~" +
+                   format("%.2f", sum) + " Å)"});
+        }
+      }
+      if (std::isfinite(best) && a.element > 1)
+        nearest[i] = static_cast<float>(std::sqrt(best));
+    }
+  };
+  if (blocks == 1)
+    check_block(0);
+  else
+    parallel_for(blocks, check_block);
+
+  // Coordinates in the wrong unit stretch or shrink every bond alike
+  std::vector<float> ratios;
+  size_t heavy = 0;
+  for (size_t i = 0; i < n; ++i) {
+    heavy += atoms[i].element > 1;
+    if (!std::isnan(nearest[i]))
+      ratios.push_back(nearest[i]);
+  }
+  if (!ratios.empty() && ratios.size() * 2 >= heavy) {
+    auto mid = ratios.begin() + ratios.size() / 2;
+    std::nth_element(ratios.begin(), mid, ratios.end());
+    const double median = *mid;
+    if (median >= BOHR_RATIO_LOW && median <= BOHR_RATIO_HIGH)
+      issues.push_back(
+          {GeometryIssue::Kind::UNITS, 0, 0,
+           "nearest neighbors sit at " + format("%.2f", median) +
+               "x bond length; coordinates look like Bohr (scale by " +
+               format("%.4f", 1.0 / BOHR_RATIO) + " for Angstrom)"});
+    else if (median < SHRUNK_RATIO && ratios.size() >= 3) // Not one clash
+      issues.push_back({GeometryIssue::Kind::UNITS, 0, 0,
+                        "nearest neighbors sit at " + format("%.2f", median) +
+                            "x bond length; coordinates look scaled down"});
+  }
+
+  for (auto &r : results)
+    for (auto &issue : r.pairs)
+      issues.push_back(std::move(issue));
+  if (!issues.empty() && issues.front().kind == GeometryIssue::Kind::UNITS)
+    return issues; // Bonds mean nothing at the wrong scale
+
+  // Fragments from the bonds found above (union-find, as in find_fragments)
+  std::vector<uint32_t> parent(n);
+  for (size_t i = 0; i < n; ++i)
+    parent[i] = static_cast<uint32_t>(i);
+  auto find = [&](uint32_t i) {
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+  for (const auto &r : results)
+    for (const auto &bond : r.bonds) {
+      uint32_t ra = find(bond.first), rb = find(bond.second);
+      if (ra != rb)
+        parent[std::max(ra, rb)] = std::min(ra, rb);
+    }
+  std::vector<uint32_t> size(n, 0);
+  for (size_t i = 0; i < n; ++i)
+    ++size[find(static_cast<uint32_t>(i))];
+
+  // Roots are the first atom of their fragment, so this is in atom order
+  size_t fragments = 0, largest = 0;
+  uint32_t main_root = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (size[i] == 0)
+      continue;
+    ++fragments;
+    if (size[i] > largest) {
+      largest = size[i];
+      main_root = static_cast<uint32_t>(i);
+    }
+  }
+
+  // Stray atoms and pieces only stand out next to a main molecule holding
+  // most atoms, not in a solvent box, a dimer or a stretched H chain
+  if (fragments < 2 || largest < 2 || largest * 2 <= n)
+    return issues;
+  size_t pieces = 0; // Besides the main molecule and the isolated atoms
+  uint32_t first_piece = UINT32_MAX;
+  for (size_t i = 0; i < n; ++i) {
+    const uint32_t ai = static_cast<uint32_t>(i);
+    if (size[i] == 1)
+      issues.push_back({GeometryIssue::Kind::ISOLATED, ai, ai,
+                        "atom " + atom_name(ai, atoms[i].element) +
+                            " is not bonded to any other atom"});
+    else if (size[i] > 1 && ai != main_root && pieces++ == 0)
+      first_piece = ai;
+  }
+  if (pieces > 0)
+    issues.push_back(
+        {GeometryIssue::Kind::FRAGMENTS, first_piece, first_piece,
+         std::to_string(pieces) + (pieces == 1 ? " piece" : " pieces") +
+             " apart from the main " + std::to_string(largest) +
+             " atoms, first at atom " +
+             atom_name(first_piece, atoms[first_piece].element)});
+  return issues;
+}
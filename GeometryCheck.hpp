@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Geometry.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct GeometryIssue {
+  enum class Kind {
+    UNITS,     ///< Distances look like Bohr (or another unit), not Angstrom
+    DUPLICATE, ///< Two atoms at the same position
+    CLASH,     ///< Two atoms far closer than a bond
+    ISOLATED,  ///< Atom bonded to nothing next to a main molecule
+    FRAGMENTS, ///< Bonded pieces (two or more atoms) apart from the main one
+  };
+  Kind kind;
+  uint32_t atom = 0;  ///< 0-based; first atom of a pair or fragment
+  uint32_t other = 0; ///< Second atom of a pair, otherwise equal to atom
+  std::string message; ///< Atoms numbered from 1, as in selections
+};
+
+struct GeometryCheckOptions {
+  double duplicate_distance = 0.01; ///< Angstrom; closer atoms coincide
+  double clash_fraction = 0.6;      ///< Of the covalent radius sum
+  double bond_tolerance = 1.2;      ///< Same bond test as find_fragments()
+};
+
+/**
+ * \brief Sanity-check a geometry before a job is spent on it.
+ *
+ * One CellList pass finds, for every atom, its neighbors out to a little more
+ * than a Bohr-scaled bond: coinciding atoms, clashes (closer than
+ * `clash_fraction` of the covalent radius sum), the bonds that make up the
+ * fragments, and the nearest neighbor relative to a bond length. When the
+ * median of the latter is near 1.89 the coordinates were almost certainly
+ * written in Bohr. The pass is O(N) and large geometries are split across
+ * cores.
+ *
+ * \returns Issues: unit problems first, then pairs in atom order, then
+ *          isolated atoms and fragments
+ */
+std::vector<GeometryIssue>
+check_geometry(const std::vector<Atom> &atoms,
+               const GeometryCheckOptions &options = {});
@@ -0,0 +1,268 @@
+#include "GeometryLog.hpp"
+#include "Elements.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const double BOHR_TO_ANGSTROM = 0.529177210903;
+
+// Separator and column-title lines allowed between a header and its atoms
+static const int MAX_GAP = 3;
+
+// --- Mapping ---
+
+GeometryLog::GeometryLog(const std::string &path) {
+  fd_ = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  struct stat st;
+  if (fd_ < 0 || fstat(fd_, &st) != 0) {
+    error_ = "cannot open " + path + ": " + std::strerror(errno);
+    return;
+  }
+  if (st.st_size == 0) {
+    error_ = path + " is empty";
+    return;
+  }
+  void *map = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ,
+                   MAP_PRIVATE, fd_, 0);
+  if (map == MAP_FAILED) {
+    error_ = "cannot map " + path + ": " + std::strerror(errno);
+    return;
+  }
+  data_ = static_cast<const char *>(map);
+  size_ = static_cast<size_t>(st.st_size);
+  // Backward scans defeat readahead; only the pages touched are read
+  madvise(map, size_, MADV_RANDOM);
+}
+
+GeometryLog::~GeometryLog() {
+  if (data_)
+    munmap(const_cast<char *>(data_), size_);
+  if (fd_ >= 0)
+    close(fd_);
+}
+
+// --- Parsing ---
+
+static bool starts_with_nocase(const char *p, const char *end,
+                               const char *word) {
+  for (; *word; ++word, ++p)
+    if (p == end || std::tolower(static_cast<unsigned char>(*p)) != *word)
+      return false;
+  return true;
+}
+
+// Header words after their first letter, which may be either case: matches
+// "Geometry", "geometry" and "GEOMETRY" (likewise "Coordinates")
+static const char *const HEADER_TAILS[] = {"eometry", "EOMETRY", "oordinates",
+                                           "OORDINATES"};
+
+static bool header_word_at(const char *p, const char *end) {
+  const char c = static_cast<char>(*p | 0x20);
+  if (c != 'g' && c != 'c')
+    return false;
+  for (int i = c == 'g' ? 0 : 2, k = i + 2; i < k; ++i) {
+    const size_t n = std::strlen(HEADER_TAILS[i]);
+    if (static_cast<size_t>(end - p - 1) >= n &&
+        std::memcmp(p + 1, HEADER_TAILS[i], n) == 0)
+      return true;
+  }
+  return false;
+}
+
+static const char *line_end(const char *p, const char *end) {
+  const void *newline = std::memchr(p, '\n', end - p);
+  return newline ? static_cast<const char *>(newline) : end;
+}
+
+// Next blank-separated token of [p, end) as [first, last); false at the end
+static bool next_token(const char *&p, const char *end, const char *&first,
+                       const char *&last) {
+  while (p < end && std::isspace(static_cast<unsigned char>(*p)))
+    ++p;
+  first = p;
+  while (p < end && !std::isspace(static_cast<unsigned char>(*p)))
+    ++p;
+  last = p;
+  return first < last;
+}
+
+// [index] symbol x y z, with one or two extra numbers allowed. Tokens are
+// checked as they are read so that prose lines are rejected early.
+static bool parse_atom_line(const char *p, const char *end, Atom &atom) {
+  const char *first, *last;
+  if (!next_token(p, end, first, last))
+    return false;
+  if (std::isdigit(static_cast<unsigned char>(*first)) &&
+      !next_token(p, end, first, last))
+    return false; // Row index only
+  if (!std::isalpha(static_cast<unsigned char>(*first)))
+    return false;
+  // "H", "CL", "Cl1" (labels carry a number)
+  const char *symbol_end = first;
+  while (symbol_end < last &&
+         std::isalpha(static_cast<unsigned char>(*symbol_end)))
+    ++symbol_end;
+  atom.element = elements::lookup_symbol(first, symbol_end - first);
+  if (atom.element == 0)
+    return false;
+
+  double values[5];
+  int numbers = 0;
+  while (next_token(p, end, first, last)) {
+    if (numbers == 5)
+      return false;
+    if (*first == '+')
+      ++first;
+    auto [ptr, ec] = std::from_chars(first, last, values[numbers++]);
+    if (ec != std::errc() || ptr != last)
+      return false;
+  }
+  if (numbers < 3)
+    return false;
+  const int x = numbers == 4 ? 1 : 0; // Z or mass, then x y z
+  // from_chars reads "inf" and "nan"; those are not positions
+  if (!std::isfinite(values[x]) || !std::isfinite(values[x + 1]) ||
+      !std::isfinite(values[x + 2]))
+    return false;
+  atom.x = values[x];
+  atom.y = values[x + 1];
+  atom.z = values[x + 2];
+  atom.ao = 1.0f;
+  return true;
+}
+
+// Atoms of the block under the header line starting at `header`, at most
+// `limit` of them. A block is `complete` once a whole non-atom line follows
+// it; one running into the end of the file may still be being written. A
+// last line without its newline is never read as an atom.
+static bool parse_block(const char *header, const char *end,
+                        std::vector<Atom> &atoms, size_t limit = SIZE_MAX,
+                        bool *complete = nullptr) {
+  const char *header_end = line_end(header, end);
+  atoms.clear();
+  int gap = 0;
+  bool ended = false, torn = false;
+  for (const char *p = header_end + 1; p < end && !ended;) {
+    const char *e = line_end(p, end);
+    torn = e == end; // Only the last line of a file can lack its newline
+    Atom atom;
+    if (parse_atom_line(p, e, atom)) {
+      if (!torn) // A torn line may still be missing digits
+        atoms.push_back(atom);
+      ended = atoms.size() == limit;
+    } else {
+      ended = !atoms.empty() || ++gap > MAX_GAP;
+    }
+    p = e + 1;
+  }
+  if (complete)
+    *complete = ended && !torn;
+  if (atoms.empty())
+    return false;
+
+  for (const char *p = header; p < header_end; ++p)
+    if (starts_with_nocase(p, header_end, "bohr") ||
+        starts_with_nocase(p, header_end, "a.u.") ||
+        starts_with_nocase(p, header_end, "(au)")) {
+      for (Atom &atom : atoms) {
+        atom.x *= BOHR_TO_ANGSTROM;
+        atom.y *= BOHR_TO_ANGSTROM;
+        atom.z *= BOHR_TO_ANGSTROM;
+      }
+      break;
+    }
+  return true;
+}
+
+static const char *line_start(const char *p, const char *begin) {
+  while (p > begin && p[-1] != '\n')
+    --p;
+  return p;
+}
+
+// --- Frames ---
+
+bool GeometryLog::last(std::vector<Atom> &atoms) const {
+  if (!data_)
+    return false;
+  const char *end = data_ + size_;
+  // The final block may be unfinished; it is the answer only when there is
+  // no whole one (a log that ends on its only geometry)
+  std::vector<Atom> unfinished;
+  for (const char *p = end; p-- > data_;)
+    if (header_word_at(p, end)) {
+      const char *header = line_start(p, data_);
+      bool complete = false;
+      if (parse_block(header, end, atoms, SIZE_MAX, &complete)) {
+        if (complete)
+          return true;
+        unfinished.swap(atoms);
+      }
+      p = header; // Nothing (whole) under this line; go on above it
+    }
+  atoms.swap(unfinished);
+  return !atoms.empty();
+}
+
+void GeometryLog::build_index() {
+  if (indexed_ || !data_)
+    return;
+  indexed_ = true;
+  madvise(const_cast<char *>(data_), size_, MADV_SEQUENTIAL);
+  const char *end = data_ + size_;
+
+  // Next occurrence of each header tail; memmem outruns a bytewise scan
+  const char *next[4];
+  auto find = [&](int i, const char *from) {
+    const void *hit =
+        from < end ? memmem(from, end - from, HEADER_TAILS[i],
+                            std::strlen(HEADER_TAILS[i]))
+                   : nullptr;
+    next[i] = hit ? static_cast<const char *>(hit) : end;
+  };
+  for (int i = 0; i < 4; ++i)
+    find(i, data_ + 1);
+
+  std::vector<Atom> scratch;
+  for (;;) {
+    const char *hit = *std::min_element(next, next + 4);
+    if (hit == end)
+      break;
+    const char *resume = hit + 1;
+    if (header_word_at(hit - 1, end)) {
+      const char *header = line_start(hit - 1, data_);
+      if (parse_block(header, end, scratch, 1)) // A block, however long
+        frames_.push_back(header - data_);
+      resume = line_end(hit, end); // One frame per header line
+    }
+    for (int i = 0; i < 4; ++i)
+      if (next[i] < resume)
+        find(i, resume);
+  }
+  // Drop an unfinished final block unless it is all there is, as last()
+  if (frames_.size() > 1) {
+    bool complete = false;
+    parse_block(data_ + frames_.back(), end, scratch, SIZE_MAX, &complete);
+    if (!complete)
+      frames_.pop_back();
+  }
+  madvise(const_cast<char *>(data_), size_, MADV_RANDOM);
+}
+
+size_t GeometryLog::frame_count() {
+  build_index();
+  return frames_.size();
+}
+
+bool GeometryLog::frame(size_t index, std::vector<Atom> &atoms) {
+  build_index();
+  return index < frames_.size() &&
+         parse_block(data_ + frames_[index], data_ + size_, atoms);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Geometry.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Geometries printed in an output log (optimization, dynamics), read
+ *        through a read-only mapping so a multi-GB log is never read whole.
+ *
+ * A geometry is a header line naming "Geometry" or "Coordinates" followed,
+ * after at most a few separator or column-title lines, by atom lines:
+ * an optional index, an element symbol and three to five numbers, the last
+ * three of a four-number line (Z or mass first) or else the first three
+ * being x, y, z. Coordinates are in Angstrom unless the header says Bohr or
+ * a.u.
+ *
+ * last() scans backward from the end of the file and parses only the final
+ * block, so its cost depends on how far from the end that block is, not on
+ * the size of the log. A block running into the end of the file (a log
+ * still being written) is passed over for the one before it, unless it is
+ * the only one. Earlier frames need
+ * an index of every block, built by one forward scan the first time one is
+ * asked for.
+ */
+class GeometryLog {
+  int fd_ = -1;
+  const char *data_ = nullptr;
+  size_t size_ = 0;
+  std::string error_;
+  std::vector<size_t> frames_; ///< Header line offsets, built on first use
+  bool indexed_ = false;
+
+  void build_index();
+
+public:
+  explicit GeometryLog(const std::string &path);
+  ~GeometryLog();
+  GeometryLog(const GeometryLog &) = delete;
+  GeometryLog &operator=(const GeometryLog &) = delete;
+
+  bool ok() const { return data_ != nullptr; }
+  const std::string &error() const { return error_; }
+  size_t size() const { return size_; }
+
+  // The final geometry; false if the log holds none
+  bool last(std::vector<Atom> &atoms) const;
+
+  // Number of geometries (builds the index)
+  size_t frame_count();
+
+  // Geometry `index` counting from 0 (builds the index)
+  bool frame(size_t index, std::vector<Atom> &atoms);
+};
@@ -0,0 +1,926 @@
+#include "Index.hpp"
+#include "InputFile.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
+
+static const char INDEX_NAME[] = ".qsee-index";
+static const char INDEX_MAGIC[8] = {'Q', 'S', 'E', 'E', 'I', 'D', 'X', '1'};
+
+static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+static std::string upper(std::string s) {
+  for (char &c : s)
+    c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+  return s;
+}
+
+// Whole string as a number, NaN otherwise ("6-31G" and "1e" are not numbers)
+static double as_number(const std::string &s) {
+  if (s.empty())
+    return std::numeric_limits<double>::quiet_NaN();
+  char *end = nullptr;
+  double v = std::strtod(s.c_str(), &end);
+  if (end != s.c_str() + s.size() || !std::isfinite(v))
+    return std::numeric_limits<double>::quiet_NaN();
+  return v;
+}
+
+// --- Crawler ---
+
+namespace {
+
+struct CrawledFile {
+  std::string path; ///< Relative to the crawled directory
+  int64_t mtime_ns = 0;
+  uint64_t size = 0;
+};
+
+bool is_input_name(const char *name) {
+  size_t n = std::strlen(name);
+  return n > 4 && std::strcmp(name + n - 4, ".inp") == 0;
+}
+
+#if defined(__linux__)
+
+// Directories are handed out to all cores through a shared queue; a worker
+// lists one directory with getdents64 and pushes its subdirectories back.
+// Only .inp files (and entries the filesystem does not type) are stat'ed.
+class Crawler {
+  std::string root_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<std::string> pending_; ///< Relative directories to list
+  size_t busy_ = 0;                  ///< Workers listing a directory
+  std::vector<CrawledFile> found_;
+
+  void list(const std::string &rel, std::vector<std::string> &dirs,
+            std::vector<CrawledFile> &files) {
+    const std::string abs = rel.empty() ? root_ : root_ + "/" + rel;
+    int fd = open(abs.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+      return; // Unreadable directories are skipped, as in --lint
+
+    // linux_dirent64: ino (8), off (8), reclen (2), type (1), name
+    constexpr size_t RECLEN_OFFSET = 16, TYPE_OFFSET = 18, NAME_OFFSET = 19;
+    alignas(8) char buf[32768];
+    for (;;) {
+      long n = syscall(SYS_getdents64, fd, buf, sizeof(buf));
+      if (n <= 0)
+        break;
+      for (long pos = 0; pos < n;) {
+        unsigned short reclen;
+        std::memcpy(&reclen, buf + pos + RECLEN_OFFSET, sizeof(reclen));
+        unsigned char type = static_cast<unsigned char>(buf[pos + TYPE_OFFSET]);
+        const char *name = buf + pos + NAME_OFFSET;
+        pos += reclen;
+        if (name[0] == '.') // ".", ".." and hidden entries, like the index
+          continue;
+
+        std::string child = rel.empty() ? name : rel + "/" + name;
+        if (type == DT_DIR) {
+          dirs.push_back(std::move(child));
+          continue;
+        }
+        bool input = is_input_name(name);
+        if (!input && type != DT_UNKNOWN)
+          continue;
+        // Without d_type, look at the entry itself so a link to a directory
+        // is seen as a link; like DT_LNK, it is followed only to an input
+        bool unknown = type == DT_UNKNOWN;
+        struct stat st;
+        if (fstatat(fd, name, &st, unknown ? AT_SYMLINK_NOFOLLOW : 0) != 0)
+          continue;
+        if (S_ISLNK(st.st_mode)) {
+          unknown = false;
+          if (!input || fstatat(fd, name, &st, 0) != 0)
+            continue;
+        }
+        if (S_ISDIR(st.st_mode)) {
+          if (unknown) // Symlinked directories are not followed
+            dirs.push_back(std::move(child));
+        } else if (S_ISREG(st.st_mode) && input) {
+          CrawledFile file;
+          file.path = std::move(child);
+          file.mtime_ns = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 +
+                          st.st_mtim.tv_nsec;
+          file.size = static_cast<uint64_t>(st.st_size);
+          files.push_back(std::move(file));
+        }
+      }
+    }
+    close(fd);
+  }
+
+  void work() {
+    std::vector<std::string> dirs;
+    std::vector<CrawledFile> files;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      cv_.wait(lock, [&] { return !pending_.empty() || busy_ == 0; });
+      if (pending_.empty())
+        return; // Nothing queued and nobody listing: the tree is done
+      std::string rel = std::move(pending_.back());
+      pending_.pop_back();
+      ++busy_;
+      lock.unlock();
+
+      dirs.clear();
+      files.clear();
+      list(rel, dirs, files);
+
+      lock.lock();
+      --busy_;
+      for (auto &d : dirs)
+        pending_.push_back(std::move(d));
+      for (auto &f : files)
+        found_.push_back(std::move(f));
+      cv_.notify_all();
+    }
+  }
+
+public:
+  explicit Crawler(std::string root) : root_(std::move(root)) {}
+
+  std::vector<CrawledFile> run() {
+    pending_.push_back("");
+    const unsigned n_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < n_threads; ++t)
+      threads.emplace_back([this] { work(); });
+    work();
+    for (auto &thread : threads)
+      thread.join();
+    return std::move(found_);
+  }
+};
+
+bool crawl_inputs(const std::string &root, std::vector<CrawledFile> &files) {
+  struct stat st;
+  if (stat(root.c_str(), &st) != 0 || !S_ISDIR(st.st_mode))
+    return false;
+  files = Crawler(root).run();
+  return true;
+}
+
+#else
+
+bool crawl_inputs(const std::string &root, std::vector<CrawledFile> &files) {
+  std::error_code ec;
+  if (!fs::is_directory(root, ec))
+    return false;
+  for (fs::recursive_directory_iterator
+           it(root, fs::directory_options::skip_permission_denied, ec),
+       end;
+       it != end; it.increment(ec)) {
+    if (ec)
+      break;
+    const std::string name = it->path().filename().string();
+    if (!name.empty() && name[0] == '.') {
+      if (it->is_directory(ec))
+        it.disable_recursion_pending();
+      continue;
+    }
+    if (!it->is_regular_file(ec) || !is_input_name(name.c_str()))
+      continue;
+    CrawledFile file;
+    file.path = fs::relative(it->path(), root, ec).generic_string();
+    file.mtime_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        it->last_write_time(ec).time_since_epoch())
+                        .count();
+    file.size = it->file_size(ec);
+    files.push_back(std::move(file));
+  }
+  return true;
+}
+
+#endif
+
+} // namespace
+
+// --- Index ---
+
+namespace {
+
+// Columnar index: one entry per file in the file columns, one row per
+// SECTION.KEY in the key/value columns. Every string is interned once.
+struct Index {
+  std::vector<std::string> strings;
+  std::unordered_map<std::string, uint32_t> ids; ///< Only built when writing
+
+  // Files, sorted by path; rows of file i are kv_begin[i] .. kv_begin[i+1]
+  std::vector<uint32_t> path, formula, atoms;
+  std::vector<int32_t> charge, mult;
+  std::vector<int64_t> mtime_ns;
+  std::vector<uint64_t> size;
+  std::vector<uint32_t> kv_begin{0};
+
+  // Key/value rows
+  std::vector<uint32_t> kv_file, kv_key, kv_value;
+  std::vector<double> kv_number; ///< NaN when the value is not a number
+
+  size_t files() const { return path.size(); }
+
+  uint32_t intern(const std::string &s) {
+    auto it = ids.find(s);
+    if (it != ids.end())
+      return it->second;
+    uint32_t id = static_cast<uint32_t>(strings.size());
+    strings.push_back(s);
+    ids.emplace(s, id);
+    return id;
+  }
+
+  void add_row(const std::string &key, const std::string &value) {
+    kv_file.push_back(static_cast<uint32_t>(files()));
+    kv_key.push_back(intern(key));
+    kv_value.push_back(intern(value));
+    kv_number.push_back(as_number(value));
+  }
+
+  // Close the file whose rows were just added
+  void add_file(const CrawledFile &file, const std::string &formula_text,
+                int charge_value, int mult_value, size_t atom_count) {
+    path.push_back(intern(file.path));
+    formula.push_back(intern(formula_text));
+    atoms.push_back(static_cast<uint32_t>(atom_count));
+    charge.push_back(charge_value);
+    mult.push_back(mult_value);
+    mtime_ns.push_back(file.mtime_ns);
+    size.push_back(file.size);
+    kv_begin.push_back(static_cast<uint32_t>(kv_file.size()));
+  }
+};
+
+// --- On-disk format ---
+// "QSEEIDX1", then u64 counts (strings, string bytes, files, rows), then the
+// string offsets and bytes, then each column in turn. Every block is padded
+// to 8 bytes so the columns stay aligned.
+
+class Writer {
+  FILE *f_;
+
+public:
+  bool ok = true;
+  explicit Writer(FILE *f) : f_(f) {}
+
+  void bytes(const void *data, size_t n) {
+    if (n && std::fwrite(data, 1, n, f_) != n)
+      ok = false;
+    static const char zeros[8] = {};
+    if (n % 8 && std::fwrite(zeros, 1, 8 - n % 8, f_) != 8 - n % 8)
+      ok = false;
+  }
+
+  template <typename T> void column(const std::vector<T> &v) {
+    bytes(v.data(), v.size() * sizeof(T));
+  }
+};
+
+class Reader {
+  const std::vector<char> &buf_;
+  size_t at_ = 0;
+
+public:
+  bool ok = true;
+  explicit Reader(const std::vector<char> &buf) : buf_(buf) {}
+
+  const char *bytes(size_t n) {
+    size_t padded = (n + 7) / 8 * 8;
+    if (!ok || padded < n || buf_.size() - at_ < padded) {
+      ok = false;
+      return nullptr;
+    }
+    const char *p = buf_.data() + at_;
+    at_ += padded;
+    return p;
+  }
+
+  template <typename T> void column(std::vector<T> &v, size_t n) {
+    if (n > buf_.size() / sizeof(T)) { // Corrupt count, not a huge index
+      ok = false;
+      return;
+    }
+    const char *p = bytes(n * sizeof(T));
+    if (!p)
+      return;
+    v.resize(n);
+    std::memcpy(v.data(), p, n * sizeof(T));
+  }
+
+  bool done() const { return ok && at_ == buf_.size(); }
+};
+
+// "runs/" and "runs" name the same index and print the same paths
+std::string trim_slashes(std::string dir) {
+  while (dir.size() > 1 && dir.back() == '/')
+    dir.pop_back();
+  return dir;
+}
+
+std::string index_path(const std::string &dir) {
+  return dir + "/" + INDEX_NAME;
+}
+
+bool save_index(const Index &index, const std::string &file) {
+  const std::string tmp = file + ".tmp";
+  FILE *f = std::fopen(tmp.c_str(), "wb");
+  if (!f)
+    return false;
+
+  std::vector<uint64_t> offsets(index.strings.size() + 1, 0);
+  for (size_t i = 0; i < index.strings.size(); ++i)
+    offsets[i + 1] = offsets[i] + index.strings[i].size();
+  std::string blob;
+  blob.reserve(offsets.back());
+  for (const auto &s : index.strings)
+    blob += s;
+
+  Writer w(f);
+  w.bytes(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+  const uint64_t counts[4] = {index.strings.size(), blob.size(), index.files(),
+                              index.kv_file.size()};
+  w.bytes(counts, sizeof(counts));
+  w.column(offsets);
+  w.bytes(blob.data(), blob.size());
+  w.column(index.path);
+  w.column(index.formula);
+  w.column(index.atoms);
+  w.column(index.charge);
+  w.column(index.mult);
+  w.column(index.mtime_ns);
+  w.column(index.size);
+  w.column(index.kv_begin);
+  w.column(index.kv_file);
+  w.column(index.kv_key);
+  w.column(index.kv_value);
+  w.column(index.kv_number);
+
+  bool ok = w.ok;
+  if (std::fclose(f) != 0)
+    ok = false;
+  // Readers see either the old index or the new one, never half of one
+  if (!ok || std::rename(tmp.c_str(), file.c_str()) != 0) {
+    std::remove(tmp.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool load_index(const std::string &file, Index &index) {
+  FILE *f = std::fopen(file.c_str(), "rb");
+  if (!f)
+    return false;
+  std::vector<char> buf;
+  char chunk[1 << 16];
+  for (size_t n; (n = std::fread(chunk, 1, sizeof(chunk), f)) > 0;)
+    buf.insert(buf.end(), chunk, chunk + n);
+  std::fclose(f);
+
+  Reader r(buf);
+  const char *magic = r.bytes(sizeof(INDEX_MAGIC));
+  if (!magic || std::memcmp(magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0)
+    return false;
+  const char *raw = r.bytes(4 * sizeof(uint64_t));
+  if (!raw)
+    return false;
+  uint64_t counts[4];
+  std::memcpy(counts, raw, sizeof(counts));
+  const uint64_t n_strings = counts[0], n_bytes = counts[1], n_files = counts[2],
+                 n_rows = counts[3];
+  // No count can exceed the file's size; this also keeps n + 1 from wrapping
+  if (n_strings >= buf.size() || n_bytes >= buf.size() ||
+      n_files >= buf.size() || n_rows >= buf.size())
+    return false;
+
+  std::vector<uint64_t> offsets;
+  r.column(offsets, n_strings + 1);
+  const char *blob = r.ok ? r.bytes(n_bytes) : nullptr;
+  if (!blob || offsets.back() != n_bytes)
+    return false;
+  index.strings.resize(n_strings);
+  for (size_t i = 0; i < n_strings; ++i) {
+    if (offsets[i] > offsets[i + 1] || offsets[i + 1] > n_bytes)
+      return false;
+    index.strings[i].assign(blob + offsets[i], offsets[i + 1] - offsets[i]);
+  }
+
+  r.column(index.path, n_files);
+  r.column(index.formula, n_files);
+  r.column(index.atoms, n_files);
+  r.column(index.charge, n_files);
+  r.column(index.mult, n_files);
+  r.column(index.mtime_ns, n_files);
+  r.column(index.size, n_files);
+  r.column(index.kv_begin, n_files + 1);
+  r.column(index.kv_file, n_rows);
+  r.column(index.kv_key, n_rows);
+  r.column(index.kv_value, n_rows);
+  r.column(index.kv_number, n_rows);
+  if (!r.done())
+    return false;
+
+  // Ids index the string table and rows stay inside their files, so queries
+  // can trust the columns without checking again
+  auto valid_ids = [&](const std::vector<uint32_t> &v) {
+    return std::all_of(v.begin(), v.end(),
+                       [&](uint32_t id) { return id < n_strings; });
+  };
+  if (!valid_ids(index.path) || !valid_ids(index.formula) ||
+      !valid_ids(index.kv_key) || !valid_ids(index.kv_value))
+    return false;
+  if (index.kv_begin.front() != 0 || index.kv_begin.back() != n_rows)
+    return false;
+  for (size_t i = 0; i < n_files; ++i) {
+    if (index.kv_begin[i] > index.kv_begin[i + 1])
+      return false;
+    for (uint32_t row = index.kv_begin[i]; row < index.kv_begin[i + 1]; ++row)
+      if (index.kv_file[row] != i)
+        return false;
+  }
+  return true;
+}
+
+// What is kept of a parsed file
+struct ParsedFile {
+  std::string formula;
+  int charge = 0, mult = 1;
+  size_t atoms = 0;
+  std::vector<std::pair<std::string, std::string>> keys; ///< SECTION.KEY, value
+};
+
+} // namespace
+
+int run_index(const std::string &root) {
+  const std::string dir = trim_slashes(root);
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<CrawledFile> files;
+  if (!crawl_inputs(dir, files)) {
+    std::cerr << "Cannot index " << dir << ": not a directory" << std::endl;
+    return 2;
+  }
+  std::sort(files.begin(), files.end(),
+            [](const CrawledFile &a, const CrawledFile &b) {
+              return a.path < b.path;
+            });
+  const double crawl_ms = elapsed_ms(start);
+
+  // Rows of files that have not changed are carried over from the old index
+  Index old;
+  std::unordered_map<std::string, size_t> old_files;
+  if (load_index(index_path(dir), old))
+    for (size_t i = 0; i < old.files(); ++i)
+      old_files.emplace(old.strings[old.path[i]], i);
+
+  std::vector<size_t> reuse(files.size(), SIZE_MAX);
+  std::vector<size_t> stale;
+  for (size_t i = 0; i < files.size(); ++i) {
+    auto it = old_files.find(files[i].path);
+    if (it != old_files.end() && old.mtime_ns[it->second] == files[i].mtime_ns &&
+        old.size[it->second] == files[i].size)
+      reuse[i] = it->second;
+    else
+      stale.push_back(i);
+  }
+
+  std::vector<ParsedFile> parsed(stale.size());
+  parallel_for(stale.size(), [&](size_t j) {
+    InputFileData data = parse_inp_file(dir + "/" + files[stale[j]].path);
+    ParsedFile &p = parsed[j];
+    p.formula = data.get_formula();
+    p.charge = data.charge;
+    p.mult = data.multiplicity;
+    p.atoms = data.atoms.size();
+    p.keys.reserve(data.parameters.size());
+    for (const auto &param : data.parameters)
+      p.keys.emplace_back(param.section + "." + param.key, param.value);
+  });
+
+  Index index;
+  for (size_t i = 0, j = 0; i < files.size(); ++i) {
+    if (reuse[i] != SIZE_MAX) {
+      const size_t o = reuse[i];
+      for (uint32_t row = old.kv_begin[o]; row < old.kv_begin[o + 1]; ++row)
+        index.add_row(old.strings[old.kv_key[row]],
+                      old.strings[old.kv_value[row]]);
+      index.add_file(files[i], old.strings[old.formula[o]], old.charge[o],
+                     old.mult[o], old.atoms[o]);
+    } else {
+      const ParsedFile &p = parsed[j++];
+      for (const auto &kv : p.keys)
+        index.add_row(kv.first, kv.second);
+      index.add_file(files[i], p.formula, p.charge, p.mult, p.atoms);
+    }
+  }
+
+  if (!save_index(index, index_path(dir))) {
+    std::cerr << "Cannot write " << index_path(dir) << std::endl;
+    return 2;
+  }
+
+  std::fprintf(stderr,
+               "Indexed %zu files (%zu parsed, %zu unchanged, %zu keys) in "
+               "%.1f ms (crawl %.1f ms)\n",
+               files.size(), stale.size(), files.size() - stale.size(),
+               index.kv_file.size(), elapsed_ms(start), crawl_ms);
+  return 0;
+}
+
+// --- Query ---
+
+namespace {
+
+enum class NodeType { NOT, AND, OR, EXISTS, COMPARE };
+enum class CompareOp { EQ, NE, LT, LE, GT, GE, CONTAINS };
+
+struct Node {
+  NodeType type;
+  std::vector<std::unique_ptr<Node>> children;
+  std::string field; ///< Upper case: PATH, FORMULA, ..., or SECTION.KEY
+  CompareOp op = CompareOp::EQ;
+  std::string value; ///< Upper case
+  double number = 0.0; ///< value as a number, NaN if it is not one
+};
+
+using NodePtr = std::unique_ptr<Node>;
+
+struct Token {
+  enum Kind { WORD, OP, LPAREN, RPAREN, END } kind;
+  std::string text;
+  bool quoted = false;
+  size_t pos = 0; // Offset in the query, for errors
+};
+
+bool is_op_char(char c) {
+  return c == '<' || c == '>' || c == '=' || c == '!' || c == '~';
+}
+
+// Words run to the next space, operator or unmatched parenthesis, so values
+// like 6-31G(D) and 6-311+G(2D,P) need no quotes
+std::vector<Token> tokenize(const std::string &s) {
+  std::vector<Token> tokens;
+  size_t i = 0;
+  while (i < s.size()) {
+    char c = s[i];
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      ++i;
+      continue;
+    }
+    Token t;
+    t.pos = i;
+    if (c == '(' || c == ')') {
+      t.kind = c == '(' ? Token::LPAREN : Token::RPAREN;
+      t.text = c;
+      ++i;
+    } else if (is_op_char(c)) {
+      t.kind = Token::OP;
+      t.text = c;
+      ++i;
+      if (i < s.size() && s[i] == '=' && c != '~') {
+        t.text += '=';
+        ++i;
+      }
+      if (t.text == "!")
+        throw std::runtime_error("Expected '!=' at position " +
+                                 std::to_string(t.pos + 1));
+    } else if (c == '"' || c == '\'') {
+      size_t close = s.find(c, i + 1);
+      if (close == std::string::npos)
+        throw std::runtime_error("Unterminated string at position " +
+                                 std::to_string(i + 1));
+      t.kind = Token::WORD;
+      t.quoted = true;
+      t.text = s.substr(i + 1, close - i - 1);
+      i = close + 1;
+    } else {
+      t.kind = Token::WORD;
+      int depth = 0;
+      while (i < s.size()) {
+        char d = s[i];
+        if (std::isspace(static_cast<unsigned char>(d)) || is_op_char(d) ||
+            d == '"' || d == '\'')
+          break;
+        if (d == '(')
+          ++depth;
+        else if (d == ')' && depth-- == 0)
+          break;
+        t.text += d;
+        ++i;
+      }
+      if (depth > 0)
+        throw std::runtime_error("Unbalanced '(' in '" + t.text +
+                                 "' at position " + std::to_string(t.pos + 1));
+    }
+    tokens.push_back(t);
+  }
+  Token end;
+  end.kind = Token::END;
+  end.pos = s.size();
+  tokens.push_back(end);
+  return tokens;
+}
+
+class Parser {
+  const std::vector<Token> &tokens_;
+  size_t at_ = 0;
+
+  const Token &peek() const { return tokens_[at_]; }
+  const Token &take() { return tokens_[at_++]; }
+
+  bool is_word(const Token &t, const char *word) const {
+    return t.kind == Token::WORD && !t.quoted && upper(t.text) == word;
+  }
+
+  bool accept_word(const char *word) {
+    if (is_word(peek(), word)) {
+      ++at_;
+      return true;
+    }
+    return false;
+  }
+
+  [[noreturn]] void fail(const std::string &what) const {
+    const Token &t = peek();
+    throw std::runtime_error(
+        what + " at position " + std::to_string(t.pos + 1) +
+        (t.kind == Token::END ? " (end of query)" : " ('" + t.text + "')"));
+  }
+
+  static NodePtr make(NodeType type) {
+    auto node = std::make_unique<Node>();
+    node->type = type;
+    return node;
+  }
+
+  NodePtr parse_or() {
+    NodePtr left = parse_and();
+    while (accept_word("OR")) {
+      NodePtr node = make(NodeType::OR);
+      node->children.push_back(std::move(left));
+      node->children.push_back(parse_and());
+      left = std::move(node);
+    }
+    return left;
+  }
+
+  NodePtr parse_and() {
+    NodePtr left = parse_unary();
+    while (accept_word("AND")) {
+      NodePtr node = make(NodeType::AND);
+      node->children.push_back(std::move(left));
+      node->children.push_back(parse_unary());
+      left = std::move(node);
+    }
+    return left;
+  }
+
+  NodePtr parse_unary() {
+    if (accept_word("NOT")) {
+      NodePtr node = make(NodeType::NOT);
+      node->children.push_back(parse_unary());
+      return node;
+    }
+    if (peek().kind == Token::LPAREN) {
+      take();
+      NodePtr inner = parse_or();
+      if (peek().kind != Token::RPAREN)
+        fail("Expected ')'");
+      take();
+      return inner;
+    }
+    if (peek().kind != Token::WORD || is_word(peek(), "AND") ||
+        is_word(peek(), "OR"))
+      fail("Expected a field");
+    NodePtr node = make(NodeType::EXISTS);
+    node->field = upper(take().text);
+    if (node->field.find('.') == std::string::npos && node->field != "PATH" &&
+        node->field != "FORMULA" && node->field != "CHARGE" &&
+        node->field != "MULT" && node->field != "ATOMS") {
+      --at_;
+      fail("Unknown field (use SECTION.KEY, path, formula, charge, mult or "
+           "atoms)");
+    }
+    if (peek().kind != Token::OP)
+      return node;
+
+    const std::string op = take().text;
+    node->type = NodeType::COMPARE;
+    node->op = op == "!=" ? CompareOp::NE
+               : op == "<" ? CompareOp::LT
+               : op == "<=" ? CompareOp::LE
+               : op == ">" ? CompareOp::GT
+               : op == ">=" ? CompareOp::GE
+               : op == "~" ? CompareOp::CONTAINS
+                           : CompareOp::EQ; // "=" and "=="
+    if (peek().kind != Token::WORD)
+      fail("Expected a value after '" + op + "'");
+    node->value = upper(take().text);
+    node->number = as_number(node->value);
+    return node;
+  }
+
+public:
+  explicit Parser(const std::vector<Token> &tokens) : tokens_(tokens) {}
+
+  NodePtr parse() {
+    if (peek().kind == Token::END)
+      fail("Empty query");
+    NodePtr root = parse_or();
+    if (peek().kind != Token::END)
+      fail("Unexpected token");
+    return root;
+  }
+};
+
+// --- Evaluation ---
+// Every node yields one byte per file; comparisons are single column scans
+
+bool compare(CompareOp op, int order) {
+  switch (op) {
+  case CompareOp::EQ: return order == 0;
+  case CompareOp::NE: return order != 0;
+  case CompareOp::LT: return order < 0;
+  case CompareOp::LE: return order <= 0;
+  case CompareOp::GT: return order > 0;
+  case CompareOp::GE: return order >= 0;
+  case CompareOp::CONTAINS: break;
+  }
+  return false;
+}
+
+class Evaluator {
+  const Index &index_;
+
+  // Outcome of the node's comparison against one value; `number` is the
+  // value as a number, NaN if it is not one
+  static bool test(const Node &node, const std::string &value, double number) {
+    if (node.op == CompareOp::CONTAINS)
+      return upper(value).find(node.value) != std::string::npos;
+    if (!std::isnan(number) && !std::isnan(node.number))
+      return compare(node.op, (number > node.number) - (number < node.number));
+    const std::string u = upper(value);
+    return compare(node.op, u.compare(node.value));
+  }
+
+  // String columns are tested once per distinct string, then looked up
+  void string_column(const Node &node, const std::vector<uint32_t> &column,
+                     std::vector<uint8_t> &out) const {
+    std::unordered_map<uint32_t, uint8_t> memo;
+    for (size_t i = 0; i < column.size(); ++i) {
+      auto it = memo.find(column[i]);
+      if (it == memo.end()) {
+        const std::string &s = index_.strings[column[i]];
+        it = memo.emplace(column[i], test(node, s, as_number(s))).first;
+      }
+      out[i] = it->second;
+    }
+  }
+
+  template <typename T>
+  void number_column(const Node &node, const std::vector<T> &column,
+                     std::vector<uint8_t> &out) const {
+    for (size_t i = 0; i < column.size(); ++i)
+      out[i] = test(node, std::to_string(column[i]),
+                    static_cast<double>(column[i]));
+  }
+
+  void key_rows(const Node &node, std::vector<uint8_t> &out) const {
+    uint32_t key = UINT32_MAX;
+    for (size_t id = 0; id < index_.strings.size(); ++id)
+      if (index_.strings[id] == node.field) {
+        key = static_cast<uint32_t>(id);
+        break;
+      }
+    if (key == UINT32_MAX)
+      return; // No file sets it
+
+    std::unordered_map<uint32_t, uint8_t> memo;
+    for (size_t row = 0; row < index_.kv_key.size(); ++row) {
+      if (index_.kv_key[row] != key)
+        continue;
+      bool match = true;
+      if (node.type == NodeType::COMPARE) {
+        const uint32_t value = index_.kv_value[row];
+        auto it = memo.find(value);
+        if (it == memo.end())
+          it = memo.emplace(value, test(node, index_.strings[value],
+                                        index_.kv_number[row]))
+                   .first;
+        match = it->second;
+      }
+      if (match)
+        out[index_.kv_file[row]] = 1;
+    }
+  }
+
+public:
+  explicit Evaluator(const Index &index) : index_(index) {}
+
+  std::vector<uint8_t> eval(const Node &node) const {
+    const size_t n = index_.files();
+    std::vector<uint8_t> out(n, 0);
+    switch (node.type) {
+    case NodeType::NOT:
+      out = eval(*node.children[0]);
+      for (auto &b : out)
+        b = !b;
+      break;
+    case NodeType::AND:
+    case NodeType::OR: {
+      out = eval(*node.children[0]);
+      std::vector<uint8_t> right = eval(*node.children[1]);
+      for (size_t i = 0; i < n; ++i)
+        out[i] = node.type == NodeType::AND ? out[i] & right[i]
+                                            : out[i] | right[i];
+      break;
+    }
+    case NodeType::EXISTS:
+    case NodeType::COMPARE:
+      if (node.field.find('.') != std::string::npos)
+        key_rows(node, out);
+      else if (node.type == NodeType::EXISTS)
+        std::fill(out.begin(), out.end(), 1); // Every file has these
+      else if (node.field == "PATH")
+        string_column(node, index_.path, out);
+      else if (node.field == "FORMULA")
+        string_column(node, index_.formula, out);
+      else if (node.field == "CHARGE")
+        number_column(node, index_.charge, out);
+      else if (node.field == "MULT")
+        number_column(node, index_.mult, out);
+      else
+        number_column(node, index_.atoms, out);
+      break;
+    }
+    return out;
+  }
+};
+
+} // namespace
+
+int run_query(const std::string &root, const std::string &query) {
+  const std::string dir = trim_slashes(root);
+  auto start = std::chrono::steady_clock::now();
+
+  NodePtr plan;
+  try {
+    plan = Parser(tokenize(query)).parse();
+  } catch (const std::runtime_error &e) {
+    std::cerr << "Query Error: " << e.what() << std::endl;
+    return 2;
+  }
+
+  Index index;
+  if (!load_index(index_path(dir), index)) {
+    std::cerr << "No usable index in " << dir << "; run qsee --index " << dir
+              << " first" << std::endl;
+    return 2;
+  }
+
+  std::vector<uint8_t> match = Evaluator(index).eval(*plan);
+  size_t matches = 0;
+  std::string out;
+  for (size_t i = 0; i < index.files(); ++i)
+    if (match[i]) {
+      out += dir + "/" + index.strings[index.path[i]] + "\n";
+      ++matches;
+    }
+  std::fwrite(out.data(), 1, out.size(), stdout);
+  std::fflush(stdout);
+
+  std::fprintf(stderr, "%zu of %zu files match (%.1f ms)\n", matches,
+               index.files(), elapsed_ms(start));
+  return matches ? 0 : 1;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+
+/**
+ * \brief Build or refresh the keyword index of every .inp file under a
+ *        directory, stored as DIR/.qsee-index.
+ *
+ * Directories are crawled on all cores (getdents64 on Linux). Files whose
+ * mtime and size match the previous index keep their rows; the rest are
+ * parsed in parallel. The index is columnar: per file the path, formula,
+ * charge, multiplicity and atom count, and one row per SECTION.KEY with the
+ * value as a string and, when it reads as one, a number.
+ *
+ * \returns Exit status: 0 on success, 2 if the directory cannot be read or
+ *          the index cannot be written
+ */
+int run_index(const std::string &dir);
+
+/**
+ * \brief Print the indexed files under a directory that match a query.
+ *
+ * Grammar (keywords and fields are case-insensitive):
+ *
+ *     expr    := term ("or" term)*
+ *     term    := factor ("and" factor)*
+ *     factor  := "not" factor | "(" expr ")" | FIELD [OP VALUE]
+ *     FIELD   := SECTION.KEY | path | formula | charge | mult | atoms
+ *     OP      := = == != < <= > >= ~ (contains)
+ *
+ * Comparisons are numeric when both sides are numbers and case-insensitive
+ * string comparisons otherwise. A bare field matches files that set it; a
+ * comparison on a key a file does not set is false.
+ *
+ * \returns Exit status: 0 if any file matched, 1 if none did, 2 if the query
+ *          is malformed or there is no index
+ */
+int run_query(const std::string &dir, const std::string &query);
@@ -0,0 +1,182 @@
+#include "InputFile.hpp"
+#include "Directive.hpp"
+#include "Elements.hpp"
+#include "Input.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+std::string InputFileData::get_parameter(const std::string &section,
+                                         const std::string &key) const {
+  for (const auto &param : parameters)
+    if (param.section == section && param.key == key)
+      return param.value;
+  return "";
+}
+
+std::string InputFileData::get_formula() const {
+  std::array<int, elements::MAX_Z + 1> counts{};
+  for (const auto &atom : atoms) {
+    counts[atom.element]++;
+  }
+  auto append = [&](std::string &formula, uint8_t z) {
+    formula += elements::get(z).symbol;
+    if (counts[z] > 1)
+      formula += std::to_string(counts[z]);
+  };
+  // Standard order: C, H, then alphabetical
+  std::string formula;
+  const uint8_t carbon = 6, hydrogen = 1;
+  if (counts[carbon])
+    append(formula, carbon);
+  if (counts[hydrogen])
+    append(formula, hydrogen);
+  std::vector<uint8_t> others;
+  for (int z = 0; z <= elements::MAX_Z; ++z) {
+    if (counts[z] && z != carbon && z != hydrogen)
+      others.push_back(static_cast<uint8_t>(z));
+  }
+  std::sort(others.begin(), others.end(), [](uint8_t a, uint8_t b) {
+    return std::strcmp(elements::get(a).symbol, elements::get(b).symbol) < 0;
+  });
+  for (uint8_t z : others) {
+    append(formula, z);
+  }
+  return formula;
+}
+
+// --- File parsing ---
+InputFileData parse_inp_file(const std::string &filename) {
+  InputFileData data;
+  data.filename = filename;
+
+  // 1. Manually scan for Title (first meaningful comment) and the
+  //    chronusq: directive, which the parser below would upper-case
+  {
+    std::ifstream file(filename);
+    if (file.is_open()) {
+      std::string line;
+      bool found_title = false;
+      while (std::getline(file, line)) {
+        size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos)
+          continue;
+        line = line.substr(start);
+
+        if (line[0] == '#') {
+          if (line.length() > 1 && !found_title) {
+            std::string comment = line.substr(1);
+            size_t cstart = comment.find_first_not_of(" \t");
+            if (cstart != std::string::npos) {
+              data.title = comment.substr(cstart);
+              found_title = true;
+            }
+          }
+        } else if (line[0] == '[') {
+          break; // Hit a section, stop looking
+        } else if (data.chronusq_line.empty()) {
+          size_t sep = line.find_first_of("=:");
+          std::string key = line.substr(0, sep);
+          key.erase(key.find_last_not_of(" \t") + 1);
+          for (char &c : key)
+            c = std::toupper(static_cast<unsigned char>(c));
+          if (sep != std::string::npos && (key == "CHRONUSQ" || key == "CQ"))
+            data.chronusq_line = line.substr(sep + 1, line.find('#') - sep - 1);
+        }
+      }
+    }
+  }
+
+  // 2. Use Robust Input Parser
+  try {
+    Input input(filename);
+    input.parse();
+
+    // Retrieve simple properties
+    if (input.containsData("MOLECULE.CHARGE"))
+      data.charge = input.getData<int>("MOLECULE.CHARGE");
+    if (input.containsData("MOLECULE.MULT"))
+      data.multiplicity = input.getData<int>("MOLECULE.MULT");
+
+    // Geometry
+    std::string geom_str;
+    if (input.containsData("MOLECULE.GEOM")) {
+      geom_str = input.getData<std::string>("MOLECULE.GEOM");
+    } else if (input.containsData("GEOMETRY")) { // Fallback/Alternative
+      geom_str = input.getData<std::string>("GEOMETRY");
+    }
+
+    if (!geom_str.empty()) {
+      std::istringstream iss(geom_str);
+      std::string line;
+      while (std::getline(iss, line)) {
+        std::istringstream ls(line);
+        std::string symbol;
+        Atom atom;
+        if (ls >> symbol >> atom.x >> atom.y >> atom.z) {
+          atom.element = elements::atomic_number(symbol);
+          data.atoms.push_back(atom);
+        }
+      }
+    }
+
+    // Populate Parameters for Display
+    for (const auto &kv : input.getDict()) {
+      std::string full_key = kv.first;
+      std::string value = kv.second;
+
+      // Skip Geometry blob in parameters list to avoid clutter; the
+      // directive is shown expanded below
+      if (full_key == "MOLECULE.GEOM" || full_key == "GEOMETRY" ||
+          full_key == "CHRONUSQ" || full_key == "CQ")
+        continue;
+
+      InputParameter param;
+      size_t dot_pos = full_key.find('.');
+      if (dot_pos != std::string::npos) {
+        param.section = full_key.substr(0, dot_pos);
+        param.key = full_key.substr(dot_pos + 1);
+      } else {
+        param.section = "GLOBAL";
+        param.key = full_key;
+      }
+      param.value = value;
+      data.parameters.push_back(param);
+    }
+
+    // Keys set by the chronusq: directive win over the sections, as in
+    // CQInputFile::parse()
+    Directive directive = parse_chronusq_directive(data.chronusq_line);
+    for (const auto &issue : directive.issues)
+      std::cerr << "Directive Warning: " << issue.message << std::endl;
+    for (const auto &kv : directive.keys) {
+      size_t dot_pos = kv.first.find('.');
+      std::string section = kv.first.substr(0, dot_pos);
+      std::string key = kv.first.substr(dot_pos + 1);
+      auto it = std::find_if(data.parameters.begin(), data.parameters.end(),
+                             [&](const InputParameter &p) {
+                               return p.section == section && p.key == key;
+                             });
+      if (it == data.parameters.end())
+        it = data.parameters.insert(data.parameters.end(),
+                                     InputParameter{section, key, "", ""});
+      it->value = kv.second;
+      it->description = "chronusq: directive";
+    }
+
+  } catch (const std::exception &e) {
+    data.error = e.what();
+    std::cerr << "Parser Error: " << e.what() << std::endl;
+  }
+
+  data.estimate = estimate_job(
+      data.atoms, data.charge, data.multiplicity,
+      [&](const std::string &section, const std::string &key) {
+        return data.get_parameter(section, key);
+      });
+  return data;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Estimate.hpp"
+#include "Geometry.hpp"
+#include <string>
+#include <vector>
+
+// --- Data Structures ---
+// Modular input parameter structure (ready for future descriptions)
+struct InputParameter {
+  std::string section;     // e.g., "QM", "BASIS", "SCF"
+  std::string key;         // e.g., "reference", "basis"
+  std::string value;       // e.g., "GBLYP", "6-31G(D)"
+  std::string description; // For future use: explanation of parameter
+};
+
+// Complete input file data
+struct InputFileData {
+  std::string filename;
+  std::string title;         // From comment at top
+  std::string chronusq_line; // The chronusq: directive
+  std::string error;         // Parser message ("" if the file was read)
+  int charge = 0;
+  int multiplicity = 1;
+  std::vector<Atom> atoms;
+  std::vector<InputParameter> parameters;
+  JobEstimate estimate; // Projected memory and cost of the job
+
+  // Value of SECTION.KEY as shown in the info panel ("" if unset)
+  std::string get_parameter(const std::string &section,
+                            const std::string &key) const;
+
+  // Get element composition string (e.g., "H5" or "C6H12O6")
+  std::string get_formula() const;
+};
+
+/**
+ * \brief Read a ChronusQ input file: title, chronusq: directive, charge,
+ *        multiplicity, geometry (Angstrom) and every SECTION.KEY.
+ *
+ * Keys set by the directive override those of the sections. Parser errors are
+ * reported on std::cerr and kept in InputFileData::error.
+ */
+InputFileData parse_inp_file(const std::string &filename);
@@ -0,0 +1,154 @@
+#include "Labels.hpp"
+#include <algorithm>
+
+// --- 5x8 font ---
+// Column-major glyphs for ASCII 0x20-0x7E: one byte per column, bit 0 at
+// the top, bit 7 for descenders.
+static const uint8_t FONT_5X8[95][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00},
+    {0x00, 0x07, 0x00, 0x07, 0x00}, {0x14, 0x7F, 0x14, 0x7F, 0x14},
+    {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+    {0x36, 0x49, 0x56, 0x20, 0x50}, {0x00, 0x08, 0x07, 0x03, 0x00},
+    {0x00, 0x1C, 0x22, 0x41, 0x00}, {0x00, 0x41, 0x22, 0x1C, 0x00},
+    {0x2A, 0x1C, 0x7F, 0x1C, 0x2A}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+    {0x00, 0x80, 0x70, 0x30, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08},
+    {0x00, 0x00, 0x60, 0x60, 0x00}, {0x20, 0x10, 0x08, 0x04, 0x02},
+    {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+    {0x72, 0x49, 0x49, 0x49, 0x46}, {0x21, 0x41, 0x49, 0x4D, 0x33},
+    {0x18, 0x14, 0x12, 0x7F, 0x10}, {0x27, 0x45, 0x45, 0x45, 0x39},
+    {0x3C, 0x4A, 0x49, 0x49, 0x31}, {0x41, 0x21, 0x11, 0x09, 0x07},
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x46, 0x49, 0x49, 0x29, 0x1E},
+    {0x00, 0x00, 0x14, 0x00, 0x00}, {0x00, 0x40, 0x34, 0x00, 0x00},
+    {0x00, 0x08, 0x14, 0x22, 0x41}, {0x14, 0x14, 0x14, 0x14, 0x14},
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x59, 0x09, 0x06},
+    {0x3E, 0x41, 0x5D, 0x59, 0x4E}, {0x7C, 0x12, 0x11, 0x12, 0x7C},
+    {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+    {0x7F, 0x41, 0x41, 0x41, 0x3E}, {0x7F, 0x49, 0x49, 0x49, 0x41},
+    {0x7F, 0x09, 0x09, 0x09, 0x01}, {0x3E, 0x41, 0x41, 0x51, 0x73},
+    {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41},
+    {0x7F, 0x40, 0x40, 0x40, 0x40}, {0x7F, 0x02, 0x1C, 0x02, 0x7F},
+    {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E},
+    {0x7F, 0x09, 0x19, 0x29, 0x46}, {0x26, 0x49, 0x49, 0x49, 0x32},
+    {0x03, 0x01, 0x7F, 0x01, 0x03}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F},
+    {0x63, 0x14, 0x08, 0x14, 0x63}, {0x03, 0x04, 0x78, 0x04, 0x03},
+    {0x61, 0x59, 0x49, 0x4D, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x41},
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x41, 0x7F},
+    {0x04, 0x02, 0x01, 0x02, 0x04}, {0x40, 0x40, 0x40, 0x40, 0x40},
+    {0x00, 0x03, 0x07, 0x08, 0x00}, {0x20, 0x54, 0x54, 0x78, 0x40},
+    {0x7F, 0x28, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x28},
+    {0x38, 0x44, 0x44, 0x28, 0x7F}, {0x38, 0x54, 0x54, 0x54, 0x18},
+    {0x00, 0x08, 0x7E, 0x09, 0x02}, {0x18, 0xA4, 0xA4, 0x9C, 0x78},
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00},
+    {0x20, 0x40, 0x40, 0x3D, 0x00}, {0x7F, 0x10, 0x28, 0x44, 0x00},
+    {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x78, 0x04, 0x78},
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38},
+    {0xFC, 0x18, 0x24, 0x24, 0x18}, {0x18, 0x24, 0x24, 0x18, 0xFC},
+    {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x24},
+    {0x04, 0x04, 0x3F, 0x44, 0x24}, {0x3C, 0x40, 0x40, 0x20, 0x7C},
+    {0x1C, 0x20, 0x40, 0x20, 0x1C}, {0x3C, 0x40, 0x30, 0x40, 0x3C},
+    {0x44, 0x28, 0x10, 0x28, 0x44}, {0x4C, 0x90, 0x90, 0x90, 0x7C},
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00},
+    {0x00, 0x00, 0x77, 0x00, 0x00}, {0x00, 0x41, 0x36, 0x08, 0x00},
+    {0x02, 0x01, 0x02, 0x04, 0x02},
+};
+
+static constexpr int GLYPHS = 95;
+static constexpr uint8_t HALO_ALPHA = 170;
+
+// --- GlyphAtlas ---
+
+GlyphAtlas::GlyphAtlas(int scale)
+    : scale_(std::max(1, scale)), cell_w_(7 * scale_), cell_h_(10 * scale_) {
+  const int stride = GLYPHS * cell_w_;
+  glyph_.assign(static_cast<size_t>(stride) * cell_h_, 0);
+  halo_.assign(glyph_.size(), 0);
+
+  for (int g = 0; g < GLYPHS; ++g) {
+    for (int col = 0; col < 5; ++col) {
+      for (int row = 0; row < 8; ++row) {
+        if (!(FONT_5X8[g][col] >> row & 1))
+          continue;
+        // Font pixel (col, row) sits one halo pixel in from the cell corner
+        const int x0 = g * cell_w_ + (col + 1) * scale_;
+        const int y0 = (row + 1) * scale_;
+        for (int y = y0; y < y0 + scale_; ++y)
+          std::fill_n(&glyph_[static_cast<size_t>(y) * stride + x0], scale_,
+                      255);
+        for (int y = y0 - scale_; y < y0 + 2 * scale_; ++y)
+          std::fill_n(&halo_[static_cast<size_t>(y) * stride + x0 - scale_],
+                      3 * scale_, HALO_ALPHA);
+      }
+    }
+  }
+}
+
+void GlyphAtlas::draw(std::vector<uint8_t> &rgba, int width, int height,
+                      int x, int y, const std::string &text,
+                      const Color &color) const {
+  const Color shadow = {0, 0, 0};
+  const int stride = GLYPHS * cell_w_;
+  const int y0 = std::max(0, y), y1 = std::min(height, y + cell_h_);
+
+  for (size_t k = 0; k < text.size(); ++k) {
+    int g = static_cast<unsigned char>(text[k]) - 0x20;
+    if (g < 0 || g >= GLYPHS)
+      g = '?' - 0x20;
+    const int gx = x + static_cast<int>(k) * advance();
+    const int x0 = std::max(0, gx), x1 = std::min(width, gx + cell_w_);
+    if (x0 >= x1)
+      continue;
+    for (int py = y0; py < y1; ++py) {
+      const size_t src = static_cast<size_t>(py - y) * stride + g * cell_w_;
+      uint8_t *dst = &rgba[(static_cast<size_t>(py) * width + x0) * 4];
+      for (int px = x0; px < x1; ++px, dst += 4) {
+        const uint8_t a = glyph_[src + px - gx];
+        if (a)
+          blend_pixel(dst, color, a);
+        else if (const uint8_t h = halo_[src + px - gx])
+          blend_pixel(dst, shadow, h);
+      }
+    }
+  }
+}
+
+// --- OccupancyGrid ---
+
+void OccupancyGrid::reset(int width, int height, int cell) {
+  cell_ = std::max(1, cell);
+  cols_ = (width + cell_ - 1) / cell_;
+  rows_ = (height + cell_ - 1) / cell_;
+  bits_.assign(static_cast<size_t>(cols_) * rows_, 0);
+}
+
+template <typename F>
+bool OccupancyGrid::for_each_cell(int x0, int y0, int x1, int y1,
+                                  F &&f) const {
+  if (x1 <= 0 || y1 <= 0)
+    return true;
+  const int c0 = std::max(0, x0 / cell_);
+  const int c1 = std::min(cols_ - 1, (x1 - 1) / cell_);
+  const int r0 = std::max(0, y0 / cell_);
+  const int r1 = std::min(rows_ - 1, (y1 - 1) / cell_);
+  for (int r = r0; r <= r1; ++r)
+    for (int c = c0; c <= c1; ++c)
+      if (!f(static_cast<size_t>(r) * cols_ + c))
+        return false;
+  return true;
+}
+
+bool OccupancyGrid::is_free(int x0, int y0, int x1, int y1,
+                            uint8_t mask) const {
+  return for_each_cell(x0, y0, x1, y1,
+                       [&](size_t i) { return !(bits_[i] & mask); });
+}
+
+void OccupancyGrid::mark(int x0, int y0, int x1, int y1, uint8_t bit) {
+  std::vector<uint8_t> &bits = bits_;
+  for_each_cell(x0, y0, x1, y1, [&](size_t i) {
+    bits[i] |= bit;
+    return true;
+  });
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Raster.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Embedded 5x8 bitmap font rasterized once into a coverage atlas.
+ *
+ * Every printable ASCII glyph is expanded to the requested integer scale
+ * together with a one-pixel dark halo, so drawing a label is a handful of
+ * row blits into the framebuffer with no per-frame rasterization.
+ */
+class GlyphAtlas {
+
+  int scale_;
+  int cell_w_, cell_h_;       ///< Glyph cell including the halo margin
+  std::vector<uint8_t> glyph_; ///< Glyph coverage, cells side by side
+  std::vector<uint8_t> halo_;  ///< Dilated coverage drawn underneath
+
+public:
+  explicit GlyphAtlas(int scale = 1);
+
+  int advance() const { return 6 * scale_; }
+  int line_height() const { return cell_h_; }
+  int text_width(const std::string &text) const {
+    return text.empty() ? 0 : static_cast<int>(text.size()) * advance() + 2 * scale_;
+  }
+
+  /**
+   * \brief Blit text with its top-left corner (including halo) at (x, y).
+   *
+   * The buffer is premultiplied RGBA; pixels outside it are clipped.
+   */
+  void draw(std::vector<uint8_t> &rgba, int width, int height, int x, int y,
+            const std::string &text, const Color &color) const;
+};
+
+/**
+ * \brief Coarse screen-space occupancy grid for label placement.
+ *
+ * Cells record what covers them (labels, atom discs) as bit flags so a
+ * candidate rectangle can be rejected against any combination of them.
+ */
+class OccupancyGrid {
+
+  int cols_ = 0, rows_ = 0, cell_ = 4;
+  std::vector<uint8_t> bits_;
+
+  template <typename F>
+  bool for_each_cell(int x0, int y0, int x1, int y1, F &&f) const;
+
+public:
+  enum : uint8_t { LABEL = 1, DISC = 2 };
+
+  void reset(int width, int height, int cell = 4);
+
+  // True if no cell overlapping [x0, x1) x [y0, y1) has any bit of mask
+  bool is_free(int x0, int y0, int x1, int y1, uint8_t mask) const;
+  void mark(int x0, int y0, int x1, int y1, uint8_t bit);
+};
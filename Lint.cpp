@@ -0,0 +1,345 @@
+#include "Lint.hpp"
+#include "Directive.hpp"
+#include "Elements.hpp"
+#include "GeometryCheck.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+
+namespace fs = std::filesystem;
+
+// --- Suggestions ---
+
+// Edit distance counting adjacent transpositions as one edit (optimal
+// string alignment), so "SFC" is one typo away from "SCF"
+static size_t edit_distance(std::string_view a, std::string_view b) {
+  const size_t w = b.size() + 1;
+  std::vector<size_t> d((a.size() + 1) * w);
+  for (size_t i = 0; i <= a.size(); ++i)
+    d[i * w] = i;
+  for (size_t j = 0; j <= b.size(); ++j)
+    d[j] = j;
+  for (size_t i = 1; i <= a.size(); ++i)
+    for (size_t j = 1; j <= b.size(); ++j) {
+      size_t &cell = d[i * w + j];
+      cell = std::min({d[(i - 1) * w + j] + 1, d[i * w + j - 1] + 1,
+                       d[(i - 1) * w + j - 1] + (a[i - 1] != b[j - 1])});
+      if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1])
+        cell = std::min(cell, d[(i - 2) * w + j - 2] + 1);
+    }
+  return d.back();
+}
+
+// Closest candidate within a typo-sized distance, or "" if none is close
+template <typename Candidates>
+static std::string nearest(std::string_view word,
+                           const Candidates &candidates) {
+  const size_t limit =
+      std::max<size_t>(1, std::min<size_t>(3, word.size() / 3));
+  std::string best;
+  size_t best_distance = limit + 1;
+  for (std::string_view candidate : candidates) {
+    size_t d = edit_distance(word, candidate);
+    if (d < best_distance) {
+      best_distance = d;
+      best = std::string(candidate);
+    }
+  }
+  return best;
+}
+
+const schema::Section *find_schema_section(std::string_view name) {
+  for (const auto &section : schema::SECTIONS)
+    if (name == section.name)
+      return &section;
+  return nullptr;
+}
+
+// --- Line scanning ---
+
+static std::string_view trim(std::string_view s) {
+  size_t first = s.find_first_not_of(" \t\r\n");
+  if (first == std::string_view::npos)
+    return {};
+  size_t last = s.find_last_not_of(" \t\r\n");
+  return s.substr(first, last - first + 1);
+}
+
+size_t unenclosed_separator(std::string_view s) {
+  int depth = 0;
+  for (size_t i = 0; i < s.size(); ++i) {
+    char c = s[i];
+    if (c == '(' || c == '[' || c == '{')
+      ++depth;
+    else if (c == ')' || c == ']' || c == '}')
+      depth = std::max(0, depth - 1);
+    else if ((c == '=' || c == ':') && depth == 0)
+      return i;
+  }
+  return std::string_view::npos;
+}
+
+static std::string upper(std::string_view s) {
+  std::string out(s);
+  for (char &c : out)
+    if (c >= 'a' && c <= 'z')
+      c -= 'a' - 'A';
+  return out;
+}
+
+// The free-format directive: report what the parser could not read and any
+// key it expands to that the schema does not know
+static void lint_directive(std::string_view value, size_t line_no,
+                           size_t column,
+                           std::vector<LintDiagnostic> &diagnostics) {
+  Directive directive = parse_chronusq_directive(value);
+  for (const auto &issue : directive.issues)
+    diagnostics.push_back({line_no, column + issue.offset,
+                           "chronusq: " + issue.message});
+  for (const auto &kv : directive.keys)
+    if (kv.first.find('[') == std::string::npos &&
+        !schema::contains(kv.first))
+      diagnostics.push_back({line_no, column,
+                             "chronusq: directive sets unknown keyword " +
+                                 kv.first});
+}
+
+// One atom of a GEOM block: a symbol ChronusQ resolves and three numbers.
+// Runs for every atom of a geometry, so nothing is allocated unless a problem
+// is reported (or the atom is kept for the geometry check).
+static void lint_geometry(std::string_view line, size_t line_no, size_t column,
+                          std::vector<LintDiagnostic> &diagnostics,
+                          LintGeometry *geometry) {
+  std::string_view tokens[4];
+  size_t offsets[4], count = 0;
+  for (size_t i = 0; count < 4;) {
+    size_t start = line.find_first_not_of(" \t\r", i);
+    if (start == std::string_view::npos)
+      break;
+    size_t end = std::min(line.find_first_of(" \t\r", start), line.size());
+    tokens[count] = line.substr(start, end - start);
+    offsets[count++] = start;
+    i = end;
+  }
+  if (count == 0)
+    return;
+
+  const int z = elements::atomic_number(upper(tokens[0]));
+  if (z == 0)
+    diagnostics.push_back(
+        {line_no, column, "unknown element " + std::string(tokens[0])});
+  if (count < 4) {
+    diagnostics.push_back({line_no, column,
+                           "atom " + std::string(tokens[0]) +
+                               " needs x, y and z coordinates"});
+    return;
+  }
+  double xyz[3];
+  bool numbers = true;
+  for (size_t k = 1; k < 4; ++k) {
+    std::string_view value = tokens[k];
+    const char *first = value.data() + (value.front() == '+');
+    auto [end, ec] =
+        std::from_chars(first, value.data() + value.size(), xyz[k - 1]);
+    if (ec != std::errc() || end != value.data() + value.size()) {
+      diagnostics.push_back({line_no, column + offsets[k],
+                             "coordinate '" + std::string(value) +
+                                 "' is not a number"});
+      numbers = false;
+    }
+  }
+  if (geometry && z != 0 && numbers) {
+    geometry->atoms.push_back(
+        {static_cast<uint8_t>(z), xyz[0], xyz[1], xyz[2]});
+    geometry->lines.push_back(line_no);
+    geometry->columns.push_back(column);
+  }
+}
+
+LineKind classify_line(std::string_view raw) {
+  std::string_view line = trim(raw.substr(0, raw.find('#')));
+  if (line.empty())
+    return LineKind::BLANK;
+  if (line.front() == '[' && line.back() == ']')
+    return LineKind::HEADER;
+  return unenclosed_separator(line) == std::string_view::npos
+             ? LineKind::CONTINUATION
+             : LineKind::ENTRY;
+}
+
+void lint_line(std::string_view raw, size_t line_no, LintState &state,
+               std::vector<LintDiagnostic> &diagnostics,
+               LintGeometry *geometry) {
+  // Everything after '#' is a comment
+  std::string_view line = trim(raw.substr(0, raw.find('#')));
+  if (line.empty())
+    return;
+  const size_t column = line.data() - raw.data() + 1;
+
+  // Section header
+  if (line.front() == '[' && line.back() == ']') {
+    state.section = upper(trim(line.substr(1, line.size() - 2)));
+    state.keyword.clear();
+    state.schema = find_schema_section(state.section);
+    if (!state.schema && !schema::contains(state.section)) {
+      std::vector<std::string_view> names;
+      for (const auto &s : schema::SECTIONS)
+        names.push_back(s.name);
+      std::string guess =
+          state.section.size() > 2 ? nearest(state.section, names) : "";
+      if (!guess.empty())
+        diagnostics.push_back({line_no, column,
+                               "unknown section [" + state.section +
+                                   "] (did you mean [" + guess + "]?)"});
+    }
+    return;
+  }
+
+  // Data entry; anything else continues the previous value
+  size_t sep = unenclosed_separator(line);
+  if (sep == std::string_view::npos) {
+    if (state.in_geometry())
+      lint_geometry(line, line_no, column, diagnostics, geometry);
+    return;
+  }
+  state.keyword = upper(trim(line.substr(0, sep)));
+  const std::string &keyword = state.keyword;
+  if (state.section.empty() && (keyword == "CHRONUSQ" || keyword == "CQ")) {
+    lint_directive(line.substr(sep + 1), line_no, column + sep + 1,
+                   diagnostics);
+    return;
+  }
+  if (state.in_geometry()) {
+    std::string_view value = trim(line.substr(sep + 1));
+    if (!value.empty())
+      lint_geometry(value, line_no, value.data() - raw.data() + 1,
+                    diagnostics, geometry);
+  }
+  if (!state.schema)
+    return;
+  if (keyword.empty() || schema::contains(state.section + "." + keyword))
+    return;
+
+  std::string message = "unknown keyword " + state.section + "." + keyword;
+  std::string guess = nearest(
+      keyword, std::vector<std::string_view>(
+                   state.schema->keywords,
+                   state.schema->keywords + state.schema->count));
+  if (!guess.empty())
+    message += " (did you mean " + guess + "?)";
+  diagnostics.push_back({line_no, column, message});
+}
+
+std::vector<LintDiagnostic> lint_text(const std::string &text) {
+  std::vector<LintDiagnostic> diagnostics;
+  LintState state;
+  LintGeometry geometry;
+  size_t line_no = 0;
+  for (size_t pos = 0; pos < text.size();) {
+    size_t end = text.find('\n', pos);
+    if (end == std::string::npos)
+      end = text.size();
+    lint_line(std::string_view(text.data() + pos, end - pos), ++line_no, state,
+              diagnostics, &geometry);
+    pos = end + 1;
+  }
+
+  // Geometry findings go with the other findings of their line
+  for (const auto &issue : check_geometry(geometry.atoms))
+    diagnostics.push_back({geometry.lines[issue.atom],
+                           geometry.columns[issue.atom],
+                           "geometry: " + issue.message});
+  std::stable_sort(diagnostics.begin(), diagnostics.end(),
+                   [](const LintDiagnostic &a, const LintDiagnostic &b) {
+                     return a.line < b.line;
+                   });
+  return diagnostics;
+}
+
+// --- Driver ---
+
+static bool read_file(const std::string &path, std::string &out) {
+  FILE *f = std::fopen(path.c_str(), "rb");
+  if (!f)
+    return false;
+  out.clear();
+  char buf[1 << 14];
+  size_t n;
+  while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0)
+    out.append(buf, n);
+  std::fclose(f);
+  return true;
+}
+
+bool collect_input_files(const std::string &path,
+                         std::vector<std::string> &files) {
+  std::error_code ec;
+  if (fs::is_regular_file(path, ec)) {
+    files.push_back(path);
+    return true;
+  }
+  if (!fs::is_directory(path, ec))
+    return false;
+  for (fs::recursive_directory_iterator
+           it(path, fs::directory_options::skip_permission_denied, ec),
+       end;
+       it != end; it.increment(ec)) {
+    if (ec)
+      break;
+    if (it->is_regular_file(ec) && it->path().extension() == ".inp")
+      files.push_back(it->path().string());
+  }
+  std::sort(files.begin(), files.end());
+  return true;
+}
+
+int run_lint(const std::string &path) {
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::string> files;
+  if (!collect_input_files(path, files)) {
+    std::cerr << "Cannot lint " << path << ": no such file or directory"
+              << std::endl;
+    return 2;
+  }
+
+  // Lint on all cores, report in path order
+  std::vector<std::vector<LintDiagnostic>> results(files.size());
+  std::vector<uint8_t> unreadable(files.size(), 0);
+  parallel_for(files.size(), [&](size_t i) {
+    std::string text;
+    if (read_file(files[i], text))
+      results[i] = lint_text(text);
+    else
+      unreadable[i] = 1;
+  });
+
+  size_t problems = 0, dirty = 0;
+  for (size_t i = 0; i < files.size(); ++i) {
+    if (unreadable[i]) {
+      std::cout << files[i] << ": cannot read file\n";
+      ++problems;
+      ++dirty;
+      continue;
+    }
+    for (const auto &d : results[i])
+      std::cout << files[i] << ":" << d.line << ":" << d.column << ": "
+                << d.message << "\n";
+    problems += results[i].size();
+    dirty += !results[i].empty();
+  }
+  std::cout << std::flush;
+
+  std::cerr << "Linted " << files.size() << " files in "
+            << (long)std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - start)
+                   .count()
+            << " ms: " << problems << " problems in " << dirty << " files"
+            << std::endl;
+  return problems ? 1 : 0;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Geometry.hpp"
+#include "Schema.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct LintDiagnostic {
+  size_t line, column; // 1-based
+  std::string message;
+};
+
+/**
+ * \brief What the parser knows at the start of a line: the section it is in
+ *        and the entry that a continuation line would extend.
+ */
+struct LintState {
+  std::string section; ///< Current header, upper case
+  std::string keyword; ///< Last data entry, upper case
+  const schema::Section *schema = nullptr; ///< Null: section not validated
+
+  // Continuation lines are atoms of MOLECULE.GEOM
+  bool in_geometry() const { return section == "MOLECULE" && keyword == "GEOM"; }
+
+  bool operator==(const LintState &o) const {
+    return schema == o.schema && section == o.section && keyword == o.keyword;
+  }
+};
+
+// Atoms of the GEOM block and where each was written, for the geometry check
+struct LintGeometry {
+  std::vector<Atom> atoms;
+  std::vector<size_t> lines, columns; ///< 1-based, per atom
+};
+
+enum class LineKind {
+  BLANK,        ///< Empty or comment only
+  HEADER,       ///< [SECTION]
+  ENTRY,        ///< KEY = value or KEY: value
+  CONTINUATION, ///< Extends the previous entry (e.g. a GEOM atom)
+};
+
+// How Input::parse() reads a line
+LineKind classify_line(std::string_view raw);
+
+/**
+ * \brief Check one line and advance the state past it.
+ *
+ * Lines are classified the same way Input::parse() does. Lines of a
+ * MOLECULE.GEOM block must read "symbol x y z". A caller that keeps the state
+ * at the start of every line only has to re-check lines until the state after
+ * an edit matches the one stored before it. Blank and continuation lines leave
+ * the state as it was, and what is reported for them only depends on whether
+ * the state is inside a GEOM block.
+ *
+ * \param [in]     raw         Line without its newline
+ * \param [in]     line_no     1-based, used for the diagnostics
+ * \param [in,out] state       State before the line, then after it
+ * \param [out]    diagnostics Findings are appended
+ * \param [out]    geometry    If given, well-formed GEOM atoms are appended
+ */
+void lint_line(std::string_view raw, size_t line_no, LintState &state,
+               std::vector<LintDiagnostic> &diagnostics,
+               LintGeometry *geometry = nullptr);
+
+// Offset of the first '=' or ':' outside brackets, npos if none (mirrors
+// containsUnenclosedEqualSign in Input.cpp)
+size_t unenclosed_separator(std::string_view s);
+
+// Schema entry for an upper-case section name, null if not validated
+const schema::Section *find_schema_section(std::string_view name);
+
+/**
+ * \brief Check the section headers and keywords of one input file against
+ *        the ChronusQ keyword schema (Schema.hpp).
+ *
+ * Keywords are only checked inside sections the schema knows; a header that
+ * is not known but is close to one that is gets reported as a likely typo.
+ * The atoms of the GEOM block then go through check_geometry(), and its
+ * findings are reported on the line of the first atom involved.
+ */
+std::vector<LintDiagnostic> lint_text(const std::string &text);
+
+/**
+ * \brief Collect the .inp files under a directory (sorted), or the path
+ *        itself if it names a file.
+ *
+ * \returns False if the path is neither a file nor a directory
+ */
+bool collect_input_files(const std::string &path,
+                         std::vector<std::string> &files);
+
+/**
+ * \brief Lint every .inp file under a directory (or a single file) on all
+ *        cores and print the findings as path:line:column: message.
+ *
+ * \returns Exit status: 0 if clean, 1 if anything was reported, 2 if the
+ *          path could not be read
+ */
+int run_lint(const std::string &path);
@@ -0,0 +1,714 @@
+#include "Lsp.hpp"
+#include "Elements.hpp"
+#include "Lint.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// --- JSON ---
+
+// Just enough JSON for JSON-RPC messages
+struct Json {
+  enum Kind { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+  Kind kind = NUL;
+  bool boolean = false;
+  double number = 0;
+  std::string string;
+  std::vector<Json> items;
+  std::vector<std::pair<std::string, Json>> members;
+
+  // Member by name; a null value if absent or not an object
+  const Json &operator[](std::string_view key) const {
+    static const Json null;
+    for (const auto &m : members)
+      if (m.first == key)
+        return m.second;
+    return null;
+  }
+};
+
+static void append_utf8(std::string &out, uint32_t cp) {
+  if (cp < 0x80) {
+    out += static_cast<char>(cp);
+  } else if (cp < 0x800) {
+    out += static_cast<char>(0xC0 | (cp >> 6));
+    out += static_cast<char>(0x80 | (cp & 0x3F));
+  } else if (cp < 0x10000) {
+    out += static_cast<char>(0xE0 | (cp >> 12));
+    out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (cp & 0x3F));
+  } else {
+    out += static_cast<char>(0xF0 | (cp >> 18));
+    out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (cp & 0x3F));
+  }
+}
+
+class JsonReader {
+public:
+  explicit JsonReader(const std::string &text) : s_(text) {}
+
+  bool parse(Json &out) {
+    if (!value(out, 0))
+      return false;
+    skip();
+    return pos_ == s_.size();
+  }
+
+private:
+  const std::string &s_;
+  size_t pos_ = 0;
+
+  void skip() {
+    while (pos_ < s_.size() && (s_[pos_] == ' ' || s_[pos_] == '\t' ||
+                                s_[pos_] == '\r' || s_[pos_] == '\n'))
+      ++pos_;
+  }
+
+  bool literal(std::string_view word) {
+    if (s_.compare(pos_, word.size(), word) != 0)
+      return false;
+    pos_ += word.size();
+    return true;
+  }
+
+  bool hex4(uint32_t &out) {
+    if (pos_ + 4 > s_.size())
+      return false;
+    out = 0;
+    for (int i = 0; i < 4; ++i) {
+      char c = s_[pos_++];
+      out <<= 4;
+      if (c >= '0' && c <= '9')
+        out |= c - '0';
+      else if (c >= 'a' && c <= 'f')
+        out |= c - 'a' + 10;
+      else if (c >= 'A' && c <= 'F')
+        out |= c - 'A' + 10;
+      else
+        return false;
+    }
+    return true;
+  }
+
+  bool string(std::string &out) {
+    ++pos_; // Opening quote
+    while (pos_ < s_.size()) {
+      // Copy up to the next quote or escape in one go (document text)
+      size_t run = s_.find_first_of("\"\\", pos_);
+      if (run == std::string::npos)
+        return false;
+      out.append(s_, pos_, run - pos_);
+      pos_ = run + 1;
+      if (s_[run] == '"')
+        return true;
+      if (pos_ >= s_.size())
+        return false;
+      switch (char e = s_[pos_++]) {
+      case 'n': out += '\n'; break;
+      case 't': out += '\t'; break;
+      case 'r': out += '\r'; break;
+      case 'b': out += '\b'; break;
+      case 'f': out += '\f'; break;
+      case 'u': {
+        uint32_t cp;
+        if (!hex4(cp))
+          return false;
+        // Surrogate pair
+        if (cp >= 0xD800 && cp < 0xDC00 && s_.compare(pos_, 2, "\\u") == 0) {
+          pos_ += 2;
+          uint32_t low;
+          if (!hex4(low))
+            return false;
+          cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+        }
+        append_utf8(out, cp);
+        break;
+      }
+      default: out += e; break; // \" \\ \/
+      }
+    }
+    return false;
+  }
+
+  bool value(Json &out, int depth) {
+    skip();
+    if (pos_ >= s_.size() || depth > 64)
+      return false;
+    const char c = s_[pos_];
+    if (c == '{') {
+      out.kind = Json::OBJECT;
+      ++pos_;
+      skip();
+      if (pos_ < s_.size() && s_[pos_] == '}')
+        return ++pos_, true;
+      while (true) {
+        skip();
+        if (pos_ >= s_.size() || s_[pos_] != '"')
+          return false;
+        out.members.emplace_back();
+        if (!string(out.members.back().first))
+          return false;
+        skip();
+        if (pos_ >= s_.size() || s_[pos_++] != ':')
+          return false;
+        if (!value(out.members.back().second, depth + 1))
+          return false;
+        skip();
+        if (pos_ >= s_.size())
+          return false;
+        if (s_[pos_] == '}')
+          return ++pos_, true;
+        if (s_[pos_++] != ',')
+          return false;
+      }
+    }
+    if (c == '[') {
+      out.kind = Json::ARRAY;
+      ++pos_;
+      skip();
+      if (pos_ < s_.size() && s_[pos_] == ']')
+        return ++pos_, true;
+      while (true) {
+        out.items.emplace_back();
+        if (!value(out.items.back(), depth + 1))
+          return false;
+        skip();
+        if (pos_ >= s_.size())
+          return false;
+        if (s_[pos_] == ']')
+          return ++pos_, true;
+        if (s_[pos_++] != ',')
+          return false;
+      }
+    }
+    if (c == '"') {
+      out.kind = Json::STRING;
+      return string(out.string);
+    }
+    if (literal("true")) {
+      out.kind = Json::BOOLEAN;
+      out.boolean = true;
+      return true;
+    }
+    if (literal("false")) {
+      out.kind = Json::BOOLEAN;
+      return true;
+    }
+    if (literal("null"))
+      return true;
+    char *end = nullptr;
+    out.number = std::strtod(s_.c_str() + pos_, &end);
+    if (end == s_.c_str() + pos_)
+      return false;
+    out.kind = Json::NUMBER;
+    pos_ = end - s_.c_str();
+    return true;
+  }
+};
+
+static std::string json_string(std::string_view s) {
+  std::string out = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buf[8];
+      std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+      out += buf;
+    } else {
+      out += c;
+    }
+  }
+  return out + "\"";
+}
+
+// Request ids are echoed back as they came
+static std::string json_id(const Json &id) {
+  if (id.kind == Json::STRING)
+    return json_string(id.string);
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.17g", id.number);
+  return id.kind == Json::NUMBER ? buf : "null";
+}
+
+// --- Transport ---
+
+// One message framed by a Content-Length header
+static bool read_message(std::string &body) {
+  size_t length = 0;
+  bool framed = false;
+  std::string header;
+  while (std::getline(std::cin, header)) {
+    if (!header.empty() && header.back() == '\r')
+      header.pop_back();
+    if (header.empty()) {
+      if (framed)
+        break;
+      continue;
+    }
+    if (header.compare(0, 15, "Content-Length:") == 0) {
+      length = std::strtoul(header.c_str() + 15, nullptr, 10);
+      framed = true;
+    }
+  }
+  if (!framed)
+    return false;
+  body.assign(length, '\0');
+  return static_cast<bool>(std::cin.read(&body[0], length));
+}
+
+static void send(const std::string &body) {
+  std::cout << "Content-Length: " << body.size() << "\r\n\r\n"
+            << body << std::flush;
+}
+
+static void reply(const Json &id, const std::string &result) {
+  send("{\"jsonrpc\":\"2.0\",\"id\":" + json_id(id) + ",\"result\":" + result +
+       "}");
+}
+
+// --- Documents ---
+
+struct DocumentLine {
+  std::string text;                      ///< Without the newline
+  LineKind kind = LineKind::BLANK;
+  LintState state;                       ///< At the start of the line
+  std::vector<LintDiagnostic> diagnostics;
+};
+
+struct Document {
+  std::vector<DocumentLine> lines; ///< Never empty
+  LintState end;                   ///< After the last line
+  long version = 0;
+};
+
+struct LspStats {
+  size_t messages = 0;
+  size_t rechecked = 0; ///< Lines linted again after edits
+  double slowest = 0;   ///< Microseconds for one message
+};
+
+static std::vector<std::string> split_lines(const std::string &text) {
+  std::vector<std::string> out;
+  size_t pos = 0;
+  while (true) {
+    size_t end = text.find('\n', pos);
+    if (end == std::string::npos) {
+      out.push_back(text.substr(pos));
+      return out;
+    }
+    out.push_back(text.substr(pos, end - pos));
+    pos = end + 1;
+  }
+}
+
+// LSP columns count UTF-16 code units; lines are stored as UTF-8
+static size_t byte_offset(const std::string &line, size_t column) {
+  size_t i = 0;
+  for (size_t units = 0; i < line.size() && units < column;) {
+    const unsigned char c = line[i];
+    const size_t len = c < 0x80 ? 1 : c < 0xE0 ? 2 : c < 0xF0 ? 3 : 4;
+    units += len == 4 ? 2 : 1;
+    i += len;
+  }
+  return std::min(i, line.size());
+}
+
+static size_t utf16_column(const std::string &line, size_t bytes) {
+  size_t units = 0;
+  for (size_t i = 0; i < bytes && i < line.size(); ++i) {
+    const unsigned char c = line[i];
+    if ((c & 0xC0) != 0x80)
+      units += c >= 0xF0 ? 2 : 1;
+  }
+  return units;
+}
+
+/**
+ * \brief Lint from line `first` on, stopping once past `end` at the first
+ *        line whose new state matches the stored one: everything after it
+ *        would come out the same.
+ *
+ * Past `end`, blank and continuation lines whose GEOM-ness did not change keep
+ * their findings and only take the new state, so retyping a section header
+ * above a large geometry does not re-check every atom.
+ */
+static void relint(Document &doc, size_t first, size_t end, LspStats &stats) {
+  LintState state = doc.lines[first].state;
+  for (size_t i = first; i < doc.lines.size(); ++i) {
+    DocumentLine &line = doc.lines[i];
+    if (i >= end) {
+      if (state == line.state)
+        return;
+      const bool unchanged =
+          line.kind == LineKind::BLANK ||
+          (line.kind == LineKind::CONTINUATION &&
+           state.in_geometry() == line.state.in_geometry());
+      line.state = state;
+      if (unchanged)
+        continue;
+    } else {
+      line.state = state;
+    }
+    line.diagnostics.clear();
+    if (line.kind == LineKind::CONTINUATION && !state.in_geometry())
+      continue; // Only atoms are checked; the state passes through
+    lint_line(line.text, i + 1, state, line.diagnostics);
+    ++stats.rechecked;
+  }
+  doc.end = std::move(state);
+}
+
+static void set_text(Document &doc, const std::string &text,
+                     LspStats &stats) {
+  doc.lines.clear();
+  for (auto &text_line : split_lines(text)) {
+    const LineKind kind = classify_line(text_line);
+    doc.lines.push_back({std::move(text_line), kind, {}, {}});
+  }
+  doc.end = LintState{};
+  relint(doc, 0, doc.lines.size(), stats);
+}
+
+static size_t position_line(const Document &doc, const Json &position) {
+  const double line = position["line"].number;
+  return line < 0 ? 0 : std::min<size_t>(line, doc.lines.size() - 1);
+}
+
+// Replace a range with new text, then re-check from the first touched line
+static void apply_change(Document &doc, const Json &change, LspStats &stats) {
+  const Json &range = change["range"];
+  if (range.kind != Json::OBJECT) {
+    set_text(doc, change["text"].string, stats);
+    return;
+  }
+  const Json &from = range["start"], &to = range["end"];
+  const size_t first = position_line(doc, from);
+  size_t last = position_line(doc, to);
+  size_t tail = byte_offset(doc.lines[last].text, to["character"].number);
+  if (to["line"].number >= doc.lines.size()) // End of the document
+    tail = doc.lines[last].text.size();
+  last = std::max(first, last);
+
+  const std::string &head_line = doc.lines[first].text;
+  std::vector<std::string> text = split_lines(
+      head_line.substr(0, byte_offset(head_line, from["character"].number)) +
+      change["text"].string + doc.lines[last].text.substr(tail));
+
+  // Overwrite the lines that are still there and insert or erase only the
+  // difference; the first line keeps its starting state and the line after
+  // the edit keeps its own for the convergence test
+  const size_t replaced = last - first + 1;
+  if (text.size() < replaced)
+    doc.lines.erase(doc.lines.begin() + first + text.size(),
+                    doc.lines.begin() + last + 1);
+  else if (text.size() > replaced)
+    doc.lines.insert(doc.lines.begin() + last + 1, text.size() - replaced,
+                     DocumentLine{});
+  for (size_t i = 0; i < text.size(); ++i) {
+    DocumentLine &line = doc.lines[first + i];
+    line.kind = classify_line(text[i]);
+    line.text = std::move(text[i]);
+  }
+  relint(doc, first, first + text.size(), stats);
+}
+
+static void publish(const std::string &uri, const Document &doc) {
+  std::string out = "{\"jsonrpc\":\"2.0\",\"method\":"
+                    "\"textDocument/publishDiagnostics\",\"params\":{\"uri\":" +
+                    json_string(uri) +
+                    ",\"version\":" + std::to_string(doc.version) +
+                    ",\"diagnostics\":[";
+  bool first = true;
+  for (size_t i = 0; i < doc.lines.size(); ++i) {
+    const std::string &text = doc.lines[i].text;
+    for (const auto &d : doc.lines[i].diagnostics) {
+      // Underline the word the finding points at
+      const size_t start = std::min(d.column - 1, text.size());
+      size_t end = text.find_first_of(" \t\r=:#", start);
+      if (end == std::string::npos)
+        end = text.size();
+      end = std::max(end, std::min(start + 1, text.size()));
+      const std::string line = std::to_string(i);
+      out += std::string(first ? "" : ",") + "{\"range\":{\"start\":{\"line\":" +
+             line + ",\"character\":" +
+             std::to_string(utf16_column(text, start)) +
+             "},\"end\":{\"line\":" + line + ",\"character\":" +
+             std::to_string(utf16_column(text, end)) +
+             "}},\"severity\":1,\"source\":\"qsee\",\"message\":" +
+             json_string(d.message) + "}";
+      first = false;
+    }
+  }
+  send(out + "]}}");
+}
+
+// --- Completion and hover ---
+
+static std::string upper(std::string_view s) {
+  std::string out(s);
+  for (char &c : out)
+    if (c >= 'a' && c <= 'z')
+      c -= 'a' - 'A';
+  return out;
+}
+
+static std::string_view trim(std::string_view s) {
+  size_t first = s.find_first_not_of(" \t\r\n");
+  if (first == std::string_view::npos)
+    return {};
+  size_t last = s.find_last_not_of(" \t\r\n");
+  return s.substr(first, last - first + 1);
+}
+
+// Doc comment of SECTION.KEYWORD, null if the keyword is not in the schema
+static const char *keyword_doc(const schema::Section *section,
+                               std::string_view keyword) {
+  if (!section)
+    return nullptr;
+  for (size_t i = 0; i < section->count; ++i)
+    if (keyword == section->keywords[i])
+      return section->docs[i];
+  return nullptr;
+}
+
+static std::string completion_item(std::string_view label, int kind,
+                                   std::string_view detail) {
+  std::string out = "{\"label\":" + json_string(label) +
+                    ",\"kind\":" + std::to_string(kind);
+  if (!detail.empty())
+    out += ",\"detail\":" + json_string(detail);
+  return out + "}";
+}
+
+/**
+ * \brief Values listed in a keyword doc: "True or False" gives both, and
+ *        "string: a, b (note), c" gives a, b and c.
+ */
+static void value_items(std::string_view doc, std::vector<std::string> &items) {
+  const std::string text = upper(doc);
+  if (text.find("TRUE") != std::string::npos &&
+      text.find("FALSE") != std::string::npos) {
+    items.push_back(completion_item("True", 12, ""));
+    items.push_back(completion_item("False", 12, ""));
+    return;
+  }
+  if (text.compare(0, 7, "STRING:") != 0)
+    return;
+  std::string_view list = doc.substr(7);
+  while (!list.empty()) {
+    size_t comma = list.find(',');
+    std::string_view option = trim(list.substr(0, comma));
+    std::string_view note;
+    if (size_t paren = option.find('('); paren != std::string_view::npos) {
+      note = option.substr(paren);
+      option = trim(option.substr(0, paren));
+    }
+    if (!option.empty())
+      items.push_back(completion_item(option, 12, note));
+    list = comma == std::string_view::npos ? "" : list.substr(comma + 1);
+  }
+}
+
+static std::string complete(const Document &doc, const Json &position) {
+  const size_t line_no = position_line(doc, position);
+  const DocumentLine &line = doc.lines[line_no];
+  std::string_view before(line.text);
+  before = before.substr(0, byte_offset(line.text, position["character"].number));
+  const std::string_view typed = trim(before);
+
+  std::vector<std::string> items;
+  if (before.find('#') != std::string_view::npos) {
+    // Inside a comment
+  } else if (!typed.empty() && typed.front() == '[') {
+    for (const auto &s : schema::SECTIONS)
+      items.push_back(completion_item(
+          s.name, 9, std::to_string(s.count) + " keywords"));
+  } else if (size_t sep = unenclosed_separator(typed);
+             sep != std::string_view::npos) {
+    const std::string keyword = upper(trim(typed.substr(0, sep)));
+    if (const char *doc_text = keyword_doc(line.state.schema, keyword))
+      value_items(doc_text, items);
+  } else if (line.state.in_geometry()) {
+    if (typed.find_first_of(" \t") == std::string_view::npos)
+      for (int z = 1; z <= elements::MAX_Z; ++z)
+        items.push_back(completion_item(elements::get(z).symbol, 21,
+                                        "Z = " + std::to_string(z)));
+  } else if (const schema::Section *section = line.state.schema) {
+    for (size_t i = 0; i < section->count; ++i)
+      items.push_back(
+          completion_item(section->keywords[i], 14, section->docs[i]));
+  }
+
+  std::string out = "{\"isIncomplete\":false,\"items\":[";
+  for (size_t i = 0; i < items.size(); ++i)
+    out += (i ? "," : "") + items[i];
+  return out + "]}";
+}
+
+static std::string element_hover(std::string_view token) {
+  const uint8_t z = elements::atomic_number(upper(token));
+  if (z == 0)
+    return "";
+  const ElementData &e = elements::get(z);
+  char buf[160];
+  std::snprintf(buf, sizeof(buf),
+                "**%s** (Z = %d)\n\nmass %.3f amu, covalent radius %.2f "
+                "\xC3\x85, van der Waals radius %.2f \xC3\x85",
+                e.symbol, z, e.mass, e.covalent_radius, e.vdw_radius);
+  return buf;
+}
+
+// Markdown for the section, keyword or atom under the cursor ("" if none)
+static std::string hover_text(const Document &doc, const Json &position) {
+  const DocumentLine &line = doc.lines[position_line(doc, position)];
+  const std::string_view text(line.text);
+  const size_t at = byte_offset(line.text, position["character"].number);
+  const std::string_view code = text.substr(0, text.find('#'));
+  if (at >= code.size())
+    return "";
+
+  // Section header: its keywords
+  const std::string_view content = trim(code);
+  if (!content.empty() && content.front() == '[' && content.back() == ']') {
+    const std::string name =
+        upper(trim(content.substr(1, content.size() - 2)));
+    const schema::Section *section = find_schema_section(name);
+    if (!section)
+      return "";
+    std::string out = "**[" + name + "]**\n\n";
+    for (size_t i = 0; i < section->count; ++i)
+      out += (i ? ", " : "") + std::string(section->keywords[i]);
+    return out;
+  }
+
+  // Whitespace-delimited token under the cursor
+  size_t begin = at, end = at;
+  while (begin > 0 && !std::isspace(static_cast<unsigned char>(code[begin - 1])))
+    --begin;
+  while (end < code.size() && !std::isspace(static_cast<unsigned char>(code[end])))
+    ++end;
+  const size_t offset = content.data() - code.data();
+  const size_t sep = unenclosed_separator(content);
+  if (sep == std::string_view::npos) {
+    // An atom line; only its symbol has anything to say
+    if (line.state.in_geometry() && begin == offset)
+      return element_hover(code.substr(begin, end - begin));
+    return "";
+  }
+
+  const size_t sep_at = offset + sep;
+  if (at < sep_at) {
+    const std::string keyword = upper(trim(content.substr(0, sep)));
+    const char *doc_text = keyword_doc(line.state.schema, keyword);
+    if (!doc_text)
+      return "";
+    std::string out = "**" + line.state.section + "." + keyword + "**";
+    if (*doc_text)
+      out += "\n\n" + std::string(doc_text);
+    return out;
+  }
+  // The first atom can share the "geom:" line
+  const std::string_view value = trim(code.substr(sep_at + 1));
+  const size_t value_at = value.data() - code.data();
+  const size_t symbol = std::min(value.find_first_of(" \t"), value.size());
+  if (line.state.section == "MOLECULE" &&
+      upper(trim(content.substr(0, sep))) == "GEOM" && !value.empty() &&
+      at >= value_at && at < value_at + symbol)
+    return element_hover(value.substr(0, symbol));
+  return "";
+}
+
+// --- Server ---
+
+int run_lsp() {
+  std::ios::sync_with_stdio(false);
+  std::unordered_map<std::string, Document> documents;
+  LspStats stats;
+  bool shutdown = false;
+
+  std::string body;
+  while (read_message(body)) {
+    const auto start = std::chrono::steady_clock::now();
+    Json message;
+    if (!JsonReader(body).parse(message)) {
+      send("{\"jsonrpc\":\"2.0\",\"id\":null,\"error\":{\"code\":-32700,"
+           "\"message\":\"parse error\"}}");
+      continue;
+    }
+    const std::string &method = message["method"].string;
+    const Json &id = message["id"];
+    const Json &params = message["params"];
+    const std::string &uri = params["textDocument"]["uri"].string;
+
+    if (method == "initialize") {
+      reply(id, "{\"capabilities\":{\"textDocumentSync\":{\"openClose\":true,"
+                "\"change\":2},\"completionProvider\":{\"triggerCharacters\":"
+                "[\"[\",\"=\",\":\"]},\"hoverProvider\":true},"
+                "\"serverInfo\":{\"name\":\"qsee\"}}");
+    } else if (method == "shutdown") {
+      shutdown = true;
+      reply(id, "null");
+    } else if (method == "exit") {
+      break;
+    } else if (method == "textDocument/didOpen") {
+      Document &doc = documents[uri];
+      doc.version = params["textDocument"]["version"].number;
+      set_text(doc, params["textDocument"]["text"].string, stats);
+      publish(uri, doc);
+    } else if (method == "textDocument/didChange") {
+      auto it = documents.find(uri);
+      if (it == documents.end())
+        continue;
+      it->second.version = params["textDocument"]["version"].number;
+      for (const auto &change : params["contentChanges"].items)
+        apply_change(it->second, change, stats);
+      publish(uri, it->second);
+    } else if (method == "textDocument/didClose") {
+      documents.erase(uri);
+      send("{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/"
+           "publishDiagnostics\",\"params\":{\"uri\":" +
+           json_string(uri) + ",\"diagnostics\":[]}}");
+    } else if (method == "textDocument/completion" ||
+               method == "textDocument/hover") {
+      auto it = documents.find(uri);
+      std::string result = "null";
+      if (it != documents.end() && method == "textDocument/completion") {
+        result = complete(it->second, params["position"]);
+      } else if (it != documents.end()) {
+        std::string text = hover_text(it->second, params["position"]);
+        if (!text.empty())
+          result = "{\"contents\":{\"kind\":\"markdown\",\"value\":" +
+                   json_string(text) + "}}";
+      }
+      reply(id, result);
+    } else if (id.kind != Json::NUL) {
+      send("{\"jsonrpc\":\"2.0\",\"id\":" + json_id(id) +
+           ",\"error\":{\"code\":-32601,\"message\":" +
+           json_string("unsupported method " + method) + "}}");
+    }
+
+    ++stats.messages;
+    stats.slowest = std::max(
+        stats.slowest, std::chrono::duration<double, std::micro>(
+                           std::chrono::steady_clock::now() - start)
+                           .count());
+  }
+
+  std::cerr << "qsee --lsp: " << stats.messages << " messages, "
+            << stats.rechecked << " lines checked, slowest "
+            << (long)stats.slowest << " us" << std::endl;
+  return shutdown ? 0 : 1;
+}
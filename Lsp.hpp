@@ -0,0 +1,17 @@
+#pragma once
+
+/**
+ * \brief Serve the Language Server Protocol for ChronusQ input files on
+ *        stdin/stdout until the client sends "exit".
+ *
+ * Each open document is kept as lines, together with the lint state at the
+ * start of every line (LintState) and the diagnostics of every line. An
+ * incremental change is spliced into the lines and only re-checked until the
+ * state after the edit matches the one stored before it, so a keystroke inside
+ * a large GEOM block re-checks one line. Provides diagnostics, completion of
+ * section names, keywords and listed values, and hover docs taken from the
+ * keyword comments in the input/ sources.
+ *
+ * \returns Exit status: 0 after a shutdown request, 1 otherwise
+ */
+int run_lsp();
@@ -0,0 +1,225 @@
+#include "Octree.hpp"
+#include <algorithm>
+#include <cmath>
+
+// --- HierarchicalDepth ---
+
+void HierarchicalDepth::reset(int width, int height, int tile_size) {
+  tile_ = tile_size;
+  w_.clear();
+  h_.clear();
+  levels_.clear();
+  int w = (width + tile_ - 1) / tile_;
+  int h = (height + tile_ - 1) / tile_;
+  while (true) {
+    w_.push_back(w);
+    h_.push_back(h);
+    levels_.emplace_back(static_cast<size_t>(w) * h, -HUGE_VALF);
+    if (w == 1 && h == 1)
+      break;
+    w = (w + 1) / 2;
+    h = (h + 1) / 2;
+  }
+}
+
+void HierarchicalDepth::add_occluder(double x0, double y0, double x1,
+                                     double y1, float z) {
+  // Tiles completely inside the rectangle
+  int tx0 = std::max(0, static_cast<int>(std::ceil(x0 / tile_)));
+  int ty0 = std::max(0, static_cast<int>(std::ceil(y0 / tile_)));
+  int tx1 = std::min(w_[0] - 1, static_cast<int>(std::floor(x1 / tile_)) - 1);
+  int ty1 = std::min(h_[0] - 1, static_cast<int>(std::floor(y1 / tile_)) - 1);
+
+  for (int ty = ty0; ty <= ty1; ++ty)
+    for (int tx = tx0; tx <= tx1; ++tx) {
+      float &d = levels_[0][static_cast<size_t>(ty) * w_[0] + tx];
+      if (z <= d)
+        continue;
+      d = z;
+      // A parent is hidden behind the farthest of its children
+      int px = tx, py = ty;
+      for (size_t l = 1; l < levels_.size(); ++l) {
+        px /= 2;
+        py /= 2;
+        float m = HUGE_VALF;
+        for (int cy = 2 * py; cy <= std::min(2 * py + 1, h_[l - 1] - 1); ++cy)
+          for (int cx = 2 * px; cx <= std::min(2 * px + 1, w_[l - 1] - 1);
+               ++cx)
+            m = std::min(m, levels_[l - 1][static_cast<size_t>(cy) *
+                                               w_[l - 1] +
+                                           cx]);
+        float &pd = levels_[l][static_cast<size_t>(py) * w_[l] + px];
+        if (m <= pd)
+          break;
+        pd = m;
+      }
+    }
+}
+
+bool HierarchicalDepth::occluded(double x0, double y0, double x1, double y1,
+                                 float z_near) const {
+  if (levels_.empty())
+    return false;
+  // Pick the level where the box spans about two tiles per axis
+  double extent = std::max(x1 - x0, y1 - y0) / tile_;
+  size_t l = 0;
+  while (extent > 2.0 && l + 1 < levels_.size()) {
+    extent /= 2.0;
+    ++l;
+  }
+  const double size = static_cast<double>(tile_) * (1 << l);
+  int tx0 = std::max(0, static_cast<int>(std::floor(x0 / size)));
+  int ty0 = std::max(0, static_cast<int>(std::floor(y0 / size)));
+  int tx1 = std::min(w_[l] - 1, static_cast<int>(std::floor(x1 / size)));
+  int ty1 = std::min(h_[l] - 1, static_cast<int>(std::floor(y1 / size)));
+  if (tx0 > tx1 || ty0 > ty1)
+    return false;
+  for (int ty = ty0; ty <= ty1; ++ty)
+    for (int tx = tx0; tx <= tx1; ++tx)
+      if (!(z_near < levels_[l][static_cast<size_t>(ty) * w_[l] + tx]))
+        return false;
+  return true;
+}
+
+// --- Octree ---
+
+Octree::Octree(const std::vector<Atom> &atoms, int leaf_size) {
+  if (atoms.empty())
+    return;
+  order_.resize(atoms.size());
+  for (uint32_t i = 0; i < order_.size(); ++i)
+    order_[i] = i;
+  nodes_.emplace_back();
+  build(atoms, 0, 0, static_cast<uint32_t>(atoms.size()), 0,
+        std::max(1, leaf_size));
+}
+
+void Octree::build(const std::vector<Atom> &atoms, int32_t index,
+                   uint32_t begin, uint32_t end, int depth, int leaf_size) {
+  double lo[3] = {HUGE_VAL, HUGE_VAL, HUGE_VAL};
+  double hi[3] = {-HUGE_VAL, -HUGE_VAL, -HUGE_VAL};
+  for (uint32_t k = begin; k < end; ++k) {
+    const Atom &a = atoms[order_[k]];
+    const double p[3] = {a.x, a.y, a.z};
+    for (int d = 0; d < 3; ++d) {
+      lo[d] = std::min(lo[d], p[d]);
+      hi[d] = std::max(hi[d], p[d]);
+    }
+  }
+  const double c[3] = {(lo[0] + hi[0]) / 2, (lo[1] + hi[1]) / 2,
+                       (lo[2] + hi[2]) / 2};
+  double r2 = 0.0;
+  for (uint32_t k = begin; k < end; ++k) {
+    const Atom &a = atoms[order_[k]];
+    double dx = a.x - c[0], dy = a.y - c[1], dz = a.z - c[2];
+    r2 = std::max(r2, dx * dx + dy * dy + dz * dz);
+  }
+
+  Node &node = nodes_[index];
+  node.cx = c[0];
+  node.cy = c[1];
+  node.cz = c[2];
+  node.radius = std::sqrt(r2);
+  node.begin = begin;
+  node.end = end;
+
+  const double extent =
+      std::max({hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]});
+  if (end - begin <= static_cast<uint32_t>(leaf_size) || depth >= 20 ||
+      extent < 1e-6)
+    return;
+
+  // Counting sort of the range into octants around the box center
+  auto octant = [&](uint32_t i) {
+    const Atom &a = atoms[i];
+    return (a.x > c[0] ? 1 : 0) | (a.y > c[1] ? 2 : 0) | (a.z > c[2] ? 4 : 0);
+  };
+  uint32_t counts[8] = {0};
+  for (uint32_t k = begin; k < end; ++k)
+    counts[octant(order_[k])]++;
+  uint32_t starts[9];
+  starts[0] = begin;
+  for (int o = 0; o < 8; ++o)
+    starts[o + 1] = starts[o] + counts[o];
+  std::vector<uint32_t> sorted(end - begin);
+  uint32_t fill[8];
+  for (int o = 0; o < 8; ++o)
+    fill[o] = starts[o] - begin;
+  for (uint32_t k = begin; k < end; ++k)
+    sorted[fill[octant(order_[k])]++] = order_[k];
+  std::copy(sorted.begin(), sorted.end(), order_.begin() + begin);
+
+  // Children are stored contiguously
+  int32_t first = static_cast<int32_t>(nodes_.size());
+  uint8_t child_count = 0;
+  for (int o = 0; o < 8; ++o)
+    if (counts[o])
+      ++child_count;
+  nodes_.resize(nodes_.size() + child_count);
+  nodes_[index].first_child = first;
+  nodes_[index].child_count = child_count;
+
+  int32_t child = first;
+  for (int o = 0; o < 8; ++o)
+    if (counts[o])
+      build(atoms, child++, starts[o], starts[o + 1], depth + 1, leaf_size);
+}
+
+void Octree::collect_visible(const std::vector<Atom> &atoms,
+                             const ViewTransform &view, int width, int height,
+                             double pad, HierarchicalDepth *occlusion,
+                             std::vector<uint32_t> &visible) const {
+  visible.clear();
+  if (nodes_.empty())
+    return;
+  if (occlusion)
+    occlusion->reset(width, height);
+
+  // Occluders are the inscribed square of each atom's disc
+  const double inscribed = pad / std::sqrt(2.0);
+  const double pad_world = pad / view.scale;
+
+  std::vector<int32_t> stack = {0};
+  while (!stack.empty()) {
+    const Node &node = nodes_[stack.back()];
+    stack.pop_back();
+
+    Vec3 c = view.project(node.cx, node.cy, node.cz);
+    const double r = node.radius * view.scale + pad;
+    if (c.x + r < 0 || c.x - r > width || c.y + r < 0 || c.y - r > height)
+      continue;
+    if (occlusion &&
+        occlusion->occluded(c.x - r, c.y - r, c.x + r, c.y + r,
+                            static_cast<float>(c.z + node.radius + pad_world)))
+      continue;
+
+    if (node.child_count == 0) {
+      for (uint32_t k = node.begin; k < node.end; ++k) {
+        visible.push_back(order_[k]);
+        if (occlusion) {
+          const Atom &a = atoms[order_[k]];
+          Vec3 p = view.project(a.x, a.y, a.z);
+          occlusion->add_occluder(p.x - inscribed, p.y - inscribed,
+                                  p.x + inscribed, p.y + inscribed,
+                                  static_cast<float>(p.z));
+        }
+      }
+      continue;
+    }
+
+    // Push children far-to-near so the nearest is visited first
+    int32_t kids[8];
+    double depth[8];
+    for (int i = 0; i < node.child_count; ++i) {
+      kids[i] = node.first_child + i;
+      const Node &ch = nodes_[kids[i]];
+      depth[i] = view.rotate(ch.cx, ch.cy, ch.cz).z;
+    }
+    const int32_t first = node.first_child;
+    std::sort(kids, kids + node.child_count, [&](int32_t a, int32_t b) {
+      return depth[a - first] < depth[b - first];
+    });
+    for (int i = 0; i < node.child_count; ++i)
+      stack.push_back(kids[i]);
+  }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Geometry.hpp"
+#include <cstdint>
+#include <vector>
+
+/**
+ * \brief Coarse hierarchical depth buffer for occlusion culling.
+ *
+ * Level 0 stores, per tile, the depth behind which everything is hidden by
+ * an occluder that fully covers the tile (-inf if none). Each higher level
+ * keeps the farthest depth of its 2x2 children, so a test over a large
+ * screen rectangle touches only a handful of tiles.
+ */
+class HierarchicalDepth {
+
+  int tile_ = 8;
+  std::vector<int> w_, h_;
+  std::vector<std::vector<float>> levels_;
+
+public:
+  void reset(int width, int height, int tile_size = 8);
+
+  // Mark tiles fully inside [x0, x1] x [y0, y1] (pixels) as hidden behind z;
+  // coarser levels are updated incrementally along the affected path
+  void add_occluder(double x0, double y0, double x1, double y1, float z);
+
+  // True if a box spanning [x0, x1] x [y0, y1] whose nearest point is at
+  // depth z_near is hidden everywhere
+  bool occluded(double x0, double y0, double x1, double y1,
+                float z_near) const;
+};
+
+/**
+ * \brief Octree over atom positions, built once at load time.
+ *
+ * Each node stores a bounding sphere of its atoms, so a node can be culled
+ * against the screen rectangle (and optionally a HierarchicalDepth buffer)
+ * after projecting a single point. Leaves reference a contiguous range of
+ * a reordered atom index array.
+ */
+class Octree {
+
+  struct Node {
+    double cx, cy, cz; ///< Bounding sphere center
+    double radius;     ///< Bounding sphere radius
+    int32_t first_child = -1;
+    uint8_t child_count = 0;
+    uint32_t begin = 0, end = 0; ///< Range in order_
+  };
+
+  std::vector<Node> nodes_;
+  std::vector<uint32_t> order_; ///< Atom indices grouped by leaf
+
+  // Fill nodes_[index] from order_[begin, end) and recurse into children
+  void build(const std::vector<Atom> &atoms, int32_t index, uint32_t begin,
+             uint32_t end, int depth, int leaf_size);
+
+public:
+  Octree(const std::vector<Atom> &atoms, int leaf_size = 16);
+
+  /**
+   * \brief Collect atoms whose node may be visible in a width x height view.
+   *
+   * \param [in]  pad       Screen-space radius of an atom in pixels
+   * \param [in]  occlusion If non-null, nodes are visited front to back and
+   *                        visited atoms are added as occluders (treated as
+   *                        solid discs), culling nodes hidden behind them
+   * \param [out] visible   Indices of atoms that passed culling
+   */
+  void collect_visible(const std::vector<Atom> &atoms,
+                       const ViewTransform &view, int width, int height,
+                       double pad, HierarchicalDepth *occlusion,
+                       std::vector<uint32_t> &visible) const;
+
+  size_t node_count() const { return nodes_.size(); }
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \brief Worker threads started once and shared by every parallel_for, so
+ *        work done each frame (grid tiles, quad panes) does not create and
+ *        join threads every time.
+ *
+ * A batch runs one function on some of the workers and on the calling
+ * thread. A call made while another batch is running (a nested parallel_for,
+ * or another thread's) is refused and the caller does the work itself; the
+ * running batch already has the cores.
+ */
+class ThreadPool {
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable wake_, done_;
+  const std::function<void()> *work_ = nullptr;
+  size_t generation_ = 0;
+  size_t wanted_ = 0, joined_ = 0, pending_ = 0; ///< Workers in this batch
+  bool stop_ = false;
+  std::atomic<bool> busy_{false};
+
+  void worker_loop() {
+    size_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_)
+        return;
+      seen = generation_;
+      if (joined_ == wanted_)
+        continue; // Batch already has its threads
+      ++joined_;
+      const std::function<void()> &work = *work_;
+      lock.unlock();
+      work();
+      lock.lock();
+      if (--pending_ == 0)
+        done_.notify_one();
+    }
+  }
+
+  ThreadPool() {
+    const unsigned n = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned t = 1; t < n; ++t)
+      workers_.emplace_back([this] { worker_loop(); });
+  }
+
+public:
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &worker : workers_)
+      worker.join();
+  }
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  static ThreadPool &shared() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  // Threads a batch can use, the caller's included
+  size_t size() const { return workers_.size() + 1; }
+
+  /**
+   * \brief Run work() on up to `threads` threads (the caller's included) and
+   *        return once every one of them has finished.
+   *
+   * \returns false, without running anything, if a batch is already running
+   */
+  bool run(size_t threads, const std::function<void()> &work) {
+    if (busy_.exchange(true))
+      return false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      work_ = &work;
+      wanted_ = pending_ = std::min(threads, size()) - 1;
+      joined_ = 0;
+      ++generation_;
+    }
+    if (wanted_ > 0)
+      wake_.notify_all();
+    work();
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      done_.wait(lock, [&] { return pending_ == 0; });
+      work_ = nullptr;
+    }
+    busy_ = false;
+    return true;
+  }
+};
+
+// Run f(0 .. count-1) on all cores; items are handed out one at a time so
+// uneven items (large and small molecules, long and short files) still
+// balance
+template <typename F> void parallel_for(size_t count, F &&f) {
+  std::atomic<size_t> next{0};
+  const std::function<void()> worker = [&]() {
+    for (size_t i; (i = next.fetch_add(1)) < count;)
+      f(i);
+  };
+  if (count > 1 && ThreadPool::shared().run(count, worker))
+    return;
+  worker();
+}
@@ -0,0 +1,65 @@
+#include "Picking.hpp"
+
+long PickGrid::pick(double x, double y) const {
+  if (entries_.empty() || x < 0 || y < 0)
+    return -1;
+  const int bx = static_cast<int>(x / cell_);
+  const int by = static_cast<int>(y / cell_);
+  const double r2 = radius_ * radius_;
+
+  long best = -1;
+  float best_z = -HUGE_VALF;
+  for (int row = std::max(0, by - 1); row <= std::min(rows_ - 1, by + 1);
+       ++row)
+    for (int col = std::max(0, bx - 1); col <= std::min(cols_ - 1, bx + 1);
+         ++col) {
+      const size_t b = static_cast<size_t>(row) * cols_ + col;
+      for (uint32_t k = start_[b]; k < start_[b + 1]; ++k) {
+        const Entry &e = entries_[k];
+        const double dx = e.x - x, dy = e.y - y;
+        if (dx * dx + dy * dy <= r2 && e.z > best_z) {
+          best_z = e.z;
+          best = e.atom;
+        }
+      }
+    }
+  return best;
+}
+
+static Vec3 sub(const Atom &a, const Atom &b) {
+  return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+static double dot(const Vec3 &a, const Vec3 &b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+static Vec3 cross(const Vec3 &a, const Vec3 &b) {
+  return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z,
+          a.x * b.y - a.y * b.x};
+}
+
+double measure_distance(const Atom &a, const Atom &b) {
+  Vec3 d = sub(a, b);
+  return std::sqrt(dot(d, d));
+}
+
+double measure_angle(const Atom &a, const Atom &b, const Atom &c) {
+  Vec3 u = sub(a, b), v = sub(c, b);
+  double denom = std::sqrt(dot(u, u) * dot(v, v));
+  if (denom < 1e-12)
+    return 0.0;
+  double cosine = std::max(-1.0, std::min(1.0, dot(u, v) / denom));
+  return std::acos(cosine) * 180.0 / M_PI;
+}
+
+double measure_dihedral(const Atom &a, const Atom &b, const Atom &c,
+                        const Atom &d) {
+  Vec3 b1 = sub(b, a), b2 = sub(c, b), b3 = sub(d, c);
+  Vec3 n1 = cross(b1, b2), n2 = cross(b2, b3);
+  double len = std::sqrt(dot(b2, b2));
+  if (len < 1e-12)
+    return 0.0;
+  // IUPAC sign convention
+  return std::atan2(dot(cross(n1, n2), b2) / len, dot(n1, n2)) * 180.0 / M_PI;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Geometry.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * \brief Screen-space bucket grid over projected atoms for O(1) picking.
+ *
+ * Rebuilt from each frame's projection with a counting sort. Buckets are at
+ * least one atom diameter wide, so a pick only has to look at the 3x3
+ * buckets around the cursor.
+ */
+class PickGrid {
+
+  int cols_ = 0, rows_ = 0;
+  double cell_ = 1.0;
+  double radius_ = 1.0;
+
+  struct Entry {
+    float x, y, z;
+    uint32_t atom;
+  };
+  std::vector<uint32_t> start_; ///< Offset of each bucket in entries_
+  std::vector<Entry> entries_;  ///< Projected atoms sorted by bucket
+
+  int bucket_of(double v, int limit) const {
+    return std::min(limit - 1, std::max(0, static_cast<int>(v / cell_)));
+  }
+
+public:
+  /**
+   * \param [in] points Projected atoms; T needs x, y, z and index members
+   * \param [in] radius Screen-space atom radius in pixels
+   */
+  template <typename T>
+  void build(const std::vector<T> &points, int width, int height,
+             double radius) {
+    radius_ = radius;
+    cell_ = std::max(2.0 * radius, 1.0);
+    cols_ = static_cast<int>(width / cell_) + 1;
+    rows_ = static_cast<int>(height / cell_) + 1;
+    start_.assign(static_cast<size_t>(cols_) * rows_ + 1, 0);
+    entries_.resize(points.size());
+
+    std::vector<uint32_t> bucket(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      bucket[i] = static_cast<uint32_t>(bucket_of(points[i].y, rows_) * cols_ +
+                                        bucket_of(points[i].x, cols_));
+      start_[bucket[i] + 1]++;
+    }
+    for (size_t b = 1; b < start_.size(); ++b)
+      start_[b] += start_[b - 1];
+    std::vector<uint32_t> fill(start_.begin(), start_.end() - 1);
+    for (size_t i = 0; i < points.size(); ++i)
+      entries_[fill[bucket[i]]++] = {
+          static_cast<float>(points[i].x), static_cast<float>(points[i].y),
+          static_cast<float>(points[i].z),
+          static_cast<uint32_t>(points[i].index)};
+  }
+
+  // Nearest-to-viewer atom whose disc contains (x, y); -1 if none
+  long pick(double x, double y) const;
+};
+
+// --- Geometry measurements (Angstrom / degrees) ---
+double measure_distance(const Atom &a, const Atom &b);
+double measure_angle(const Atom &a, const Atom &b, const Atom &c);
+double measure_dihedral(const Atom &a, const Atom &b, const Atom &c,
+                        const Atom &d);
@@ -0,0 +1,191 @@
+#include "Raster.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+void draw_circle_outline(std::vector<uint8_t> &rgba, int width, int height,
+                         int cx, int cy, int radius, const Color &color) {
+  auto set_pixel = [&](int x, int y) {
+    if (x >= 0 && x < width && y >= 0 && y < height) {
+      int idx = (y * width + x) * 4;
+      rgba[idx] = color.r;
+      rgba[idx + 1] = color.g;
+      rgba[idx + 2] = color.b;
+      rgba[idx + 3] = 255;
+    }
+  };
+
+  // Draw 8 symmetric points
+  auto plot_circle_points = [&](int x, int y) {
+    set_pixel(cx + x, cy + y);
+    set_pixel(cx - x, cy + y);
+    set_pixel(cx + x, cy - y);
+    set_pixel(cx - x, cy - y);
+    set_pixel(cx + y, cy + x);
+    set_pixel(cx - y, cy + x);
+    set_pixel(cx + y, cy - x);
+    set_pixel(cx - y, cy - x);
+  };
+
+  int x = 0, y = radius;
+  int d = 3 - 2 * radius;
+
+  while (x <= y) {
+    plot_circle_points(x, y);
+    if (d < 0) {
+      d = d + 4 * x + 6;
+    } else {
+      d = d + 4 * (x - y) + 10;
+      y--;
+    }
+    x++;
+  }
+}
+
+void draw_circle_outline_aa(std::vector<uint8_t> &rgba, int width, int height,
+                            double cx, double cy, double radius,
+                            const Color &color, double thickness) {
+  for_each_ring_fragment(
+      width, height, cx, cy, radius, thickness,
+      [&](int x, int y, double coverage) {
+        int alpha = static_cast<int>(coverage * 255 + 0.5);
+        if (alpha > 0)
+          blend_pixel(&rgba[(static_cast<size_t>(y) * width + x) * 4], color,
+                      alpha);
+      });
+}
+
+void draw_line_aa(std::vector<uint8_t> &rgba, int width, int height, double x0,
+                  double y0, double x1, double y1, const Color &color,
+                  double thickness) {
+  const double half = thickness / 2.0, reach = half + 1.0;
+  const double dx = x1 - x0, dy = y1 - y0;
+  const double length2 = std::max(dx * dx + dy * dy, 1e-12);
+  const int xa =
+      std::max(0, static_cast<int>(std::floor(std::min(x0, x1) - reach)));
+  const int xb = std::min(
+      width - 1, static_cast<int>(std::ceil(std::max(x0, x1) + reach)));
+  const int ya =
+      std::max(0, static_cast<int>(std::floor(std::min(y0, y1) - reach)));
+  const int yb = std::min(
+      height - 1, static_cast<int>(std::ceil(std::max(y0, y1) + reach)));
+  for (int y = ya; y <= yb; ++y)
+    for (int x = xa; x <= xb; ++x) {
+      const double px = x + 0.5 - x0, py = y + 0.5 - y0;
+      const double t = std::clamp((px * dx + py * dy) / length2, 0.0, 1.0);
+      const double ex = px - t * dx, ey = py - t * dy;
+      const double coverage = half + 0.5 - std::sqrt(ex * ex + ey * ey);
+      if (coverage > 0.0)
+        blend_pixel(&rgba[(static_cast<size_t>(y) * width + x) * 4], color,
+                    static_cast<int>(std::min(coverage, 1.0) * 255 + 0.5));
+    }
+}
+
+// acc[i] += row[i] for n bytes
+static void accumulate_row(uint16_t *acc, const uint8_t *row, size_t n) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 16 <= n; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+    __m128i *a = reinterpret_cast<__m128i *>(acc + i);
+    __m128i lo = _mm_add_epi16(_mm_loadu_si128(a), _mm_unpacklo_epi8(v, zero));
+    __m128i hi =
+        _mm_add_epi16(_mm_loadu_si128(a + 1), _mm_unpackhi_epi8(v, zero));
+    _mm_storeu_si128(a, lo);
+    _mm_storeu_si128(a + 1, hi);
+  }
+#endif
+  for (; i < n; ++i)
+    acc[i] += row[i];
+}
+
+void downsample_box(const std::vector<uint8_t> &src, int width, int height,
+                    int factor, std::vector<uint8_t> &dst) {
+  const int src_w = width * factor;
+  const size_t row_bytes = static_cast<size_t>(src_w) * 4;
+  const int area = factor * factor; // at most 16 * 255, fits in uint16_t
+  dst.assign(static_cast<size_t>(width) * height * 4, 0);
+  std::vector<uint16_t> acc(row_bytes);
+
+  for (int oy = 0; oy < height; ++oy) {
+    // Vertical pass: sum `factor` source rows
+    std::fill(acc.begin(), acc.end(), 0);
+    for (int k = 0; k < factor; ++k)
+      accumulate_row(acc.data(),
+                     &src[static_cast<size_t>(oy * factor + k) * row_bytes],
+                     row_bytes);
+
+    // Horizontal pass: sum `factor` adjacent pixels per channel
+    uint8_t *out = &dst[static_cast<size_t>(oy) * width * 4];
+    for (int ox = 0; ox < width; ++ox) {
+      const uint16_t *p = &acc[static_cast<size_t>(ox) * factor * 4];
+      for (int c = 0; c < 4; ++c) {
+        int sum = 0;
+        for (int f = 0; f < factor; ++f)
+          sum += p[f * 4 + c];
+        out[ox * 4 + c] = static_cast<uint8_t>((sum + area / 2) / area);
+      }
+    }
+  }
+}
+
+void OitBuffers::reset(int w, int h) {
+  width = w;
+  height = h;
+  const size_t n = static_cast<size_t>(w) * h;
+  accum.assign(n * 4, 0.0f);
+  reveal.assign(n, 1.0f);
+  depth.assign(n, -HUGE_VALF);
+}
+
+void composite_oit(const OitBuffers &oit, std::vector<uint8_t> &rgba) {
+  const size_t n = static_cast<size_t>(oit.width) * oit.height;
+  for (size_t i = 0; i < n; ++i) {
+    const float r = oit.reveal[i];
+    if (r >= 1.0f)
+      continue; // No translucent fragments here
+    const float *a = &oit.accum[i * 4];
+    uint8_t *px = &rgba[i * 4];
+    // Normalizing by the weighted alpha sum turns the alpha lane into
+    // 255, so all four lanes resolve as avg * (1 - r) + dst * r
+    const float inv = 1.0f / std::max(a[3] / 255.0f, 1e-5f);
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    __m128 avg = _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(inv));
+    int32_t packed;
+    std::memcpy(&packed, px, 4);
+    __m128i d8 = _mm_cvtsi32_si128(packed);
+    __m128 dst = _mm_cvtepi32_ps(
+        _mm_unpacklo_epi16(_mm_unpacklo_epi8(d8, zero), zero));
+    __m128 out = _mm_add_ps(_mm_mul_ps(avg, _mm_set1_ps(1.0f - r)),
+                            _mm_mul_ps(dst, _mm_set1_ps(r)));
+    __m128i o32 = _mm_cvtps_epi32(
+        _mm_min_ps(_mm_max_ps(out, _mm_setzero_ps()), _mm_set1_ps(255.0f)));
+    __m128i o16 = _mm_packs_epi32(o32, zero);
+    packed = _mm_cvtsi128_si32(_mm_packus_epi16(o16, zero));
+    std::memcpy(px, &packed, 4);
+#else
+    for (int c = 0; c < 4; ++c) {
+      float out = a[c] * inv * (1.0f - r) + px[c] * r;
+      px[c] = static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, out)) +
+                                   0.5f);
+    }
+#endif
+  }
+}
+
+void unpremultiply_alpha(std::vector<uint8_t> &rgba) {
+  for (size_t i = 0; i + 3 < rgba.size(); i += 4) {
+    int a = rgba[i + 3];
+    if (a == 0 || a == 255)
+      continue;
+    for (int c = 0; c < 3; ++c)
+      rgba[i + c] =
+          static_cast<uint8_t>(std::min(255, (rgba[i + c] * 255 + a / 2) / a));
+  }
+}
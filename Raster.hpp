@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// --- Element colors (RGB) ---
+struct Color {
+  uint8_t r, g, b;
+};
+
+// --- Circle drawing (Bresenham's algorithm) ---
+void draw_circle_outline(std::vector<uint8_t> &rgba, int width, int height,
+                         int cx, int cy, int radius, const Color &color);
+
+/**
+ * \brief Visit every pixel touched by an anti-aliased circle outline.
+ *
+ * Calls frag(x, y, coverage) with coverage in (0, 1] derived from the
+ * distance between the pixel center and the ideal circle. The empty interior
+ * of the ring is skipped row by row.
+ */
+template <typename Frag>
+void for_each_ring_fragment(int width, int height, double cx, double cy,
+                            double radius, double thickness, Frag &&frag) {
+  const double half = thickness / 2.0;
+  // Pixels further than one pixel from the stroke have zero coverage
+  const double outer = radius + half + 1.0;
+  const double inner = std::max(0.0, radius - half - 1.0);
+
+  int y0 = std::max(0, static_cast<int>(std::floor(cy - outer)));
+  int y1 = std::min(height - 1, static_cast<int>(std::ceil(cy + outer)));
+  for (int y = y0; y <= y1; ++y) {
+    double dy = y + 0.5 - cy;
+    double dy2 = dy * dy;
+    if (dy2 >= outer * outer)
+      continue;
+
+    auto shade_span = [&](int xa, int xb) {
+      xa = std::max(xa, 0);
+      xb = std::min(xb, width - 1);
+      for (int x = xa; x <= xb; ++x) {
+        double dx = x + 0.5 - cx;
+        double coverage =
+            half + 0.5 - std::fabs(std::sqrt(dx * dx + dy2) - radius);
+        if (coverage > 0.0)
+          frag(x, y, std::min(coverage, 1.0));
+      }
+    };
+
+    double xo = std::sqrt(outer * outer - dy2);
+    int xa = static_cast<int>(std::floor(cx - xo));
+    int xb = static_cast<int>(std::ceil(cx + xo));
+    if (dy2 < inner * inner) {
+      // Pixel centers with |dx| < xi lie inside the inner bound
+      double xi = std::sqrt(inner * inner - dy2);
+      shade_span(xa, static_cast<int>(std::floor(cx - xi - 0.5)));
+      shade_span(static_cast<int>(std::ceil(cx + xi - 0.5)), xb);
+    } else {
+      shade_span(xa, xb);
+    }
+  }
+}
+
+// Premultiplied "over": dst = color * a + dst * (1 - a)
+inline void blend_pixel(uint8_t *px, const Color &color, int alpha) {
+  int inv = 255 - alpha;
+  px[0] = static_cast<uint8_t>((color.r * alpha + px[0] * inv + 127) / 255);
+  px[1] = static_cast<uint8_t>((color.g * alpha + px[1] * inv + 127) / 255);
+  px[2] = static_cast<uint8_t>((color.b * alpha + px[2] * inv + 127) / 255);
+  px[3] = static_cast<uint8_t>(alpha + (px[3] * inv + 127) / 255);
+}
+
+/**
+ * \brief Anti-aliased circle outline using analytic edge coverage.
+ *
+ * Each pixel's coverage is derived from the distance between its center and
+ * the ideal circle, so sub-pixel centers and radii are honored. The buffer is
+ * treated as premultiplied RGBA; call unpremultiply_alpha() before upload.
+ *
+ * \param [in] thickness Line width in pixels (scale it with the supersampling
+ *                       factor to keep the outline width constant)
+ */
+void draw_circle_outline_aa(std::vector<uint8_t> &rgba, int width, int height,
+                            double cx, double cy, double radius,
+                            const Color &color, double thickness = 1.0);
+
+/**
+ * \brief Anti-aliased line segment with round caps, coverage derived from
+ *        each pixel center's distance to the segment.
+ */
+void draw_line_aa(std::vector<uint8_t> &rgba, int width, int height, double x0,
+                  double y0, double x1, double y1, const Color &color,
+                  double thickness = 1.0);
+
+/**
+ * \brief Box-filter a (width*factor) x (height*factor) RGBA buffer down to
+ *        width x height. Rows are accumulated with SSE2 when available.
+ */
+void downsample_box(const std::vector<uint8_t> &src, int width, int height,
+                    int factor, std::vector<uint8_t> &dst);
+
+/**
+ * \brief Weighted blended order-independent transparency (McGuire & Bavoil).
+ *
+ * Translucent fragments are accumulated in any order into a weighted
+ * premultiplied color sum and a revealage product, then resolved over the
+ * opaque frame in a single pass. Fragments behind the opaque depth recorded
+ * with write_depth() are discarded.
+ */
+struct OitBuffers {
+  int width = 0, height = 0;
+  std::vector<float> accum;  ///< Weighted premultiplied RGBA, 4 per pixel
+  std::vector<float> reveal; ///< Product of (1 - alpha), 1 per pixel
+  std::vector<float> depth;  ///< Nearest opaque depth (larger z = nearer)
+
+  void reset(int w, int h);
+
+  void write_depth(int x, int y, float z) {
+    float &d = depth[static_cast<size_t>(y) * width + x];
+    d = std::max(d, z);
+  }
+
+  /**
+   * \param [in] alpha Fragment opacity (already multiplied by coverage)
+   * \param [in] far   Normalized distance from the viewer in [0, 1]
+   */
+  void add(int x, int y, const Color &color, float alpha, float z,
+           float far) {
+    size_t i = static_cast<size_t>(y) * width + x;
+    if (z < depth[i])
+      return;
+    float f = 1.0f - far;
+    float w = alpha * std::max(1e-2f, 3e3f * f * f * f);
+    float *a = &accum[i * 4];
+    a[0] += color.r * alpha * w;
+    a[1] += color.g * alpha * w;
+    a[2] += color.b * alpha * w;
+    a[3] += 255.0f * alpha * w;
+    reveal[i] *= 1.0f - alpha;
+  }
+};
+
+/**
+ * \brief Resolve OIT buffers over a premultiplied RGBA frame (SSE2 when
+ *        available).
+ */
+void composite_oit(const OitBuffers &oit, std::vector<uint8_t> &rgba);
+
+// Convert premultiplied RGBA (used while compositing) to the straight alpha
+// the Kitty protocol expects
+void unpremultiply_alpha(std::vector<uint8_t> &rgba);
@@ -0,0 +1,161 @@
+#include "Render.hpp"
+#include "Elements.hpp"
+#include <algorithm>
+#include <cmath>
+
+// --- Element colors (RGB) ---
+Color get_element_color(uint8_t element) {
+  const ElementData &e = elements::get(element);
+  return {e.r, e.g, e.b};
+}
+
+Color shade_color(const Color &c, float ao) {
+  const float k = 0.25f + 0.75f * ao;
+  return {static_cast<uint8_t>(c.r * k), static_cast<uint8_t>(c.g * k),
+          static_cast<uint8_t>(c.b * k)};
+}
+
+// --- 3D Math ---
+Vec3 rotate_x(const Vec3 &v, double angle) {
+  double c = std::cos(angle);
+  double s = std::sin(angle);
+  return {v.x, v.y * c - v.z * s, v.y * s + v.z * c};
+}
+
+Vec3 rotate_y(const Vec3 &v, double angle) {
+  double c = std::cos(angle);
+  double s = std::sin(angle);
+  return {v.x * c + v.z * s, v.y, -v.x * s + v.z * c};
+}
+
+Vec3 rotate_z(const Vec3 &v, double angle) {
+  double c = std::cos(angle);
+  double s = std::sin(angle);
+  return {v.x * c - v.y * s, v.x * s + v.y * c, v.z};
+}
+
+const char *view_mode_name(ViewMode mode) {
+  switch (mode) {
+  case ViewMode::XY: return "XY";
+  case ViewMode::XZ: return "XZ";
+  case ViewMode::YZ: return "YZ";
+  default: return "ISO";
+  }
+}
+
+Vec3 apply_camera_view(const Vec3 &v, ViewMode mode) {
+  switch (mode) {
+  case ViewMode::XY:
+    // Looking down Z-axis (no rotation needed)
+    return v;
+  case ViewMode::XZ:
+    // Looking down Y-axis (rotate -90° around X)
+    return rotate_x(v, -M_PI / 2.0);
+  case ViewMode::YZ:
+    // Looking down X-axis (rotate 90° around Y)
+    return rotate_y(v, M_PI / 2.0);
+  case ViewMode::ISOMETRIC:
+  default:
+    // 3/4 view: rotate to see from (1, 1, 1) direction
+    // First tilt down ~35.26° (arctan(1/√2)), then rotate 45° around Y
+    Vec3 tilted = rotate_x(v, -M_PI / 5.5); // ~32° down tilt
+    return rotate_y(tilted, M_PI / 4.0);    // 45° Y rotation
+  }
+}
+
+ViewTransform make_view(ViewMode mode, double angle, double scale, double ox,
+                        double oy) {
+  ViewTransform view;
+  const Vec3 basis[3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+  for (int c = 0; c < 3; ++c) {
+    Vec3 v = rotate_y(apply_camera_view(basis[c], mode), angle);
+    view.m[0][c] = v.x;
+    view.m[1][c] = v.y;
+    view.m[2][c] = v.z;
+  }
+  view.scale = scale;
+  view.ox = ox;
+  view.oy = oy;
+  return view;
+}
+
+// --- Still frames ---
+void rasterize_atoms(const std::vector<Atom> &atoms, const ViewTransform &view,
+                     int width, int height, int atom_radius, bool antialias,
+                     int supersample, bool use_ao,
+                     std::vector<ProjectedAtom> &projected,
+                     std::vector<uint8_t> &rgba) {
+  projected.clear();
+  for (size_t a = 0; a < atoms.size(); ++a) {
+    const Atom &atom = atoms[a];
+    Vec3 p = view.project(atom.x, atom.y, atom.z);
+    if (p.x + atom_radius < 0 || p.x - atom_radius > width ||
+        p.y + atom_radius < 0 || p.y - atom_radius > height)
+      continue;
+    Color color = get_element_color(atom.element);
+    if (use_ao)
+      color = shade_color(color, atom.ao);
+    projected.push_back({p.x, p.y, p.z, color, a});
+  }
+  std::sort(projected.begin(), projected.end(),
+            [](const ProjectedAtom &a, const ProjectedAtom &b) {
+              return a.z < b.z;
+            });
+
+  const int ss = supersample;
+  rgba.assign((size_t)width * ss * height * ss * 4, 0);
+  for (const auto &p : projected) {
+    if (antialias)
+      draw_circle_outline_aa(rgba, width * ss, height * ss, p.x * ss,
+                             p.y * ss, atom_radius * ss, p.color, ss);
+    else
+      draw_circle_outline(rgba, width * ss, height * ss, (int)p.x * ss,
+                          (int)p.y * ss, atom_radius * ss, p.color);
+  }
+  if (ss > 1) {
+    std::vector<uint8_t> filtered;
+    downsample_box(rgba, width, height, ss, filtered);
+    rgba.swap(filtered);
+  }
+}
+
+void render_still(const std::vector<Atom> &atoms, int width, int height,
+                  const StillOptions &options, std::vector<uint8_t> &rgba) {
+  // Center on the centroid, as the viewer does
+  std::vector<Atom> centered = atoms;
+  double cx = 0, cy = 0, cz = 0;
+  for (const auto &atom : centered) {
+    cx += atom.x;
+    cy += atom.y;
+    cz += atom.z;
+  }
+  const double n = std::max<size_t>(1, centered.size());
+  double max_extent = 0.0;
+  for (auto &atom : centered) {
+    atom.x -= cx / n;
+    atom.y -= cy / n;
+    atom.z -= cz / n;
+    max_extent = std::max(max_extent, std::sqrt(atom.x * atom.x +
+                                                atom.y * atom.y +
+                                                atom.z * atom.z));
+  }
+  if (options.ambient_occlusion)
+    compute_ambient_occlusion(centered);
+
+  // Same proportions as a comparison grid tile
+  const int edge = std::min(width, height);
+  const int atom_radius = std::max(2, (int)std::lround(edge * 12 / 256.0));
+  const int padding = (int)std::lround(edge * 10 / 256.0);
+  const double viewport_radius = edge / 2.0 - atom_radius - padding;
+  const double scale =
+      (max_extent > 0.001) ? (viewport_radius / max_extent) : 80.0;
+  const ViewTransform view =
+      make_view(options.view, options.angle, scale * options.zoom,
+                width / 2.0, height / 2.0);
+
+  std::vector<ProjectedAtom> projected;
+  rasterize_atoms(centered, view, width, height, atom_radius,
+                  options.antialias, std::max(1, options.supersample),
+                  options.ambient_occlusion, projected, rgba);
+  unpremultiply_alpha(rgba);
+}
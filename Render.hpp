@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Geometry.hpp"
+#include "Raster.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- Element colors (RGB) ---
+Color get_element_color(uint8_t element);
+
+// Darken a color by a precomputed ambient-occlusion factor, keeping a floor
+// so buried atoms stay visible
+Color shade_color(const Color &c, float ao);
+
+// --- 3D Math ---
+Vec3 rotate_x(const Vec3 &v, double angle);
+Vec3 rotate_y(const Vec3 &v, double angle);
+Vec3 rotate_z(const Vec3 &v, double angle);
+
+// Camera view modes
+enum class ViewMode { ISOMETRIC, XY, XZ, YZ };
+
+const char *view_mode_name(ViewMode mode);
+
+// Apply initial camera rotation based on view mode
+Vec3 apply_camera_view(const Vec3 &v, ViewMode mode);
+
+// Bake camera view, animation rotation, scale and pan into one transform by
+// pushing the basis vectors through the same rotation steps
+ViewTransform make_view(ViewMode mode, double angle, double scale, double ox,
+                        double oy);
+
+// --- Still frames ---
+struct ProjectedAtom {
+  double x, y; // Sub-pixel screen position
+  double z;
+  Color color;
+  size_t index;
+};
+
+/**
+ * \brief Draw atoms as circle outlines, far to near, into a premultiplied
+ *        width x height RGBA buffer.
+ *
+ * Atoms whose circle misses the frame are skipped. With supersampling the
+ * outlines are drawn at `supersample` times the size and box-filtered down.
+ *
+ * \param [out] projected Scratch, reused between frames
+ */
+void rasterize_atoms(const std::vector<Atom> &atoms, const ViewTransform &view,
+                     int width, int height, int atom_radius, bool antialias,
+                     int supersample, bool use_ao,
+                     std::vector<ProjectedAtom> &projected,
+                     std::vector<uint8_t> &rgba);
+
+struct StillOptions {
+  ViewMode view = ViewMode::ISOMETRIC;
+  double angle = 0.0;     ///< Turntable rotation about the screen vertical
+  double zoom = 1.0;
+  bool antialias = true;
+  int supersample = 1;    ///< 1, 2 or 4
+  bool ambient_occlusion = false;
+};
+
+/**
+ * \brief Render one frame of a geometry (Angstrom) off-screen.
+ *
+ * The molecule is centered and scaled to fill the frame the way a comparison
+ * grid tile is, so a thumbnail matches what the viewer shows.
+ *
+ * \param [out] rgba width x height x 4 bytes, straight (not premultiplied)
+ *                   alpha
+ */
+void render_still(const std::vector<Atom> &atoms, int width, int height,
+                  const StillOptions &options, std::vector<uint8_t> &rgba);
@@ -0,0 +1,303 @@
+#include "RtField.hpp"
+#include "TextPlot.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+// Steps evaluated per column before a column is subsampled
+static const size_t SAMPLES_PER_COLUMN = 256;
+
+// --- Envelopes ---
+// Shapes follow the envelope names: a linear ramp rises from 0 at t_on to 1
+// at t_off and holds, and a Gaussian is centered in its window.
+double RtField::envelope_at(double t) const {
+  if (t < t_on)
+    return 0.0;
+  switch (envelope) {
+  case FieldEnvelope::LINEAR_RAMP:
+    return t < t_off ? (t - t_on) / (t_off - t_on) : 1.0;
+  case FieldEnvelope::GAUSSIAN: {
+    const double dt = t - 0.5 * (t_on + t_off);
+    return t <= t_off ? std::exp(-alpha * dt * dt) : 0.0;
+  }
+  default:
+    return t <= t_off ? 1.0 : 0.0;
+  }
+}
+
+double RtField::value_at(double t) const {
+  const double e = envelope_at(t);
+  if (envelope != FieldEnvelope::PLANE_WAVE || e == 0.0)
+    return e;
+  return e * (sine ? std::sin(omega * t) : std::cos(omega * t));
+}
+
+// --- Parsing ---
+static bool to_number(const std::string &text, double &value) {
+  char *end = nullptr;
+  value = std::strtod(text.c_str(), &end);
+  return !text.empty() && end == text.c_str() + text.size() &&
+         std::isfinite(value);
+}
+
+// Comma-separated fields of text, blanks removed
+static std::vector<std::string> split_commas(const std::string &text) {
+  std::vector<std::string> parts;
+  std::string part;
+  for (char c : text) {
+    if (c == ',') {
+      parts.push_back(part);
+      part.clear();
+    } else if (!std::isspace(static_cast<unsigned char>(c))) {
+      part += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+  }
+  if (!part.empty() || !parts.empty())
+    parts.push_back(part);
+  return parts;
+}
+
+// Text between `open` and the matching `close` in spec, "" if absent
+static std::string between(const std::string &spec, char open, char close) {
+  const size_t a = spec.find(open);
+  const size_t b = a == std::string::npos ? a : spec.find(close, a);
+  return b == std::string::npos ? "" : spec.substr(a + 1, b - a - 1);
+}
+
+static bool parse_field(const std::string &line, RtField &field,
+                        std::string &error) {
+  std::istringstream ls(line);
+  std::vector<std::string> tokens;
+  for (std::string token; ls >> token;)
+    tokens.push_back(token);
+  if (tokens.size() != 5) {
+    error = "expected 'Envelope(tOn,tOff) Electric x y z'";
+    return false;
+  }
+  std::string kind = tokens[1];
+  for (char &c : kind)
+    c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+  if (kind != "ELECTRIC") {
+    error = kind == "MAGNETIC" ? "magnetic fields are not implemented"
+                               : "unknown field type " + tokens[1];
+    return false;
+  }
+  for (int i = 0; i < 3; ++i)
+    if (!to_number(tokens[2 + i], field.amplitude[i])) {
+      error = "bad field component " + tokens[2 + i];
+      return false;
+    }
+
+  const std::string &spec = tokens[0];
+  std::string name = spec.substr(0, spec.find_first_of("(["));
+  for (char &c : name)
+    c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+  const std::vector<std::string> times = split_commas(between(spec, '(', ')'));
+  const std::vector<std::string> params = split_commas(between(spec, '[', ']'));
+  if (times.size() != 2 || !to_number(times[0], field.t_on) ||
+      !to_number(times[1], field.t_off)) {
+    error = spec + " needs (tOn,tOff)";
+    return false;
+  }
+  if (field.t_off <= field.t_on) {
+    error = "tOff must be > tOn";
+    return false;
+  }
+
+  if (name == "STEPFIELD" || name == "LINEARRAMPFIELD") {
+    field.envelope = name == "STEPFIELD" ? FieldEnvelope::STEP
+                                         : FieldEnvelope::LINEAR_RAMP;
+    if (!params.empty()) {
+      error = name + " takes no parameters";
+      return false;
+    }
+  } else if (name == "PLANEWAVEFIELD") {
+    field.envelope = FieldEnvelope::PLANE_WAVE;
+    if (params.empty() || params.size() > 2 ||
+        !to_number(params[0], field.omega)) {
+      error = "PlaneWaveField needs [omega] or [omega,COS|SIN]";
+      return false;
+    }
+    if (params.size() == 2) {
+      if (params[1] == "SIN" || params[1] == "FALSE") {
+        field.sine = true;
+      } else if (params[1] != "COS" && params[1] != "TRUE") {
+        error = "PlaneWaveField carrier must be COS or SIN";
+        return false;
+      }
+    }
+  } else if (name == "GAUSSIANFIELD") {
+    field.envelope = FieldEnvelope::GAUSSIAN;
+    if (params.size() != 1 || !to_number(params[0], field.alpha) ||
+        field.alpha < 0.0) {
+      error = "GaussianField needs [alpha] with alpha >= 0";
+      return false;
+    }
+  } else {
+    error = "unknown envelope " + name;
+    return false;
+  }
+  return true;
+}
+
+std::vector<RtField> parse_rt_fields(const std::string &value,
+                                     std::vector<std::string> &errors) {
+  std::vector<RtField> fields;
+  std::istringstream lines(value);
+  for (std::string line; std::getline(lines, line);) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos)
+      continue;
+    RtField field;
+    std::string error;
+    if (parse_field(line, field, error))
+      fields.push_back(field);
+    else
+      errors.push_back(error);
+  }
+  return fields;
+}
+
+// --- Sampling ---
+static double norm(const std::array<double, 3> &v) {
+  return std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+
+FieldTrace sample_rt_fields(const std::vector<RtField> &fields, double dt,
+                            size_t steps, size_t columns) {
+  FieldTrace trace;
+  const RtField *strongest = nullptr;
+  for (const RtField &f : fields)
+    if (!strongest || norm(f.amplitude) > norm(strongest->amplitude))
+      strongest = &f;
+  if (strongest && norm(strongest->amplitude) > 0.0)
+    for (int i = 0; i < 3; ++i)
+      trace.axis[i] = strongest->amplitude[i] / norm(strongest->amplitude);
+  if (fields.empty() || !(dt > 0.0) || columns == 0)
+    return trace;
+
+  std::vector<double> projected;
+  for (const RtField &f : fields)
+    projected.push_back(f.amplitude[0] * trace.axis[0] +
+                        f.amplitude[1] * trace.axis[1] +
+                        f.amplitude[2] * trace.axis[2]);
+
+  // Steps at which an envelope switches on or off, or peaks; a column that
+  // is subsampled still evaluates these
+  std::vector<double> events;
+  for (const RtField &f : fields) {
+    for (double t : {f.t_on, f.t_off})
+      for (double s = std::floor(t / dt) - 1; s <= std::ceil(t / dt) + 1; ++s)
+        events.push_back(s);
+    if (f.envelope == FieldEnvelope::GAUSSIAN)
+      events.push_back(std::round(0.5 * (f.t_on + f.t_off) / dt));
+  }
+  std::sort(events.begin(), events.end());
+
+  const size_t n = steps + 1;
+  const size_t buckets = std::min(columns, n);
+  trace.lo.resize(buckets);
+  trace.hi.resize(buckets);
+  std::vector<char> bounded(fields.size());
+  for (size_t k = 0; k < buckets; ++k) {
+    const size_t s0 = k * n / buckets, s1 = (k + 1) * n / buckets;
+    const double t0 = s0 * dt, t1 = (s1 - 1) * dt;
+
+    // Plane waves completing a period inside the column span ±envelope
+    for (size_t i = 0; i < fields.size(); ++i) {
+      const RtField &f = fields[i];
+      const double span =
+          std::min(t1, f.t_off) - std::max(t0, f.t_on);
+      bounded[i] = f.envelope == FieldEnvelope::PLANE_WAVE &&
+                   f.omega != 0.0 && span * std::fabs(f.omega) >= 2 * M_PI;
+    }
+
+    double lo = INFINITY, hi = -INFINITY;
+    auto evaluate = [&](size_t s) {
+      const double t = s * dt;
+      double base = 0.0, bound = 0.0;
+      for (size_t i = 0; i < fields.size(); ++i) {
+        if (bounded[i])
+          bound += std::fabs(projected[i]) * fields[i].envelope_at(t);
+        else
+          base += projected[i] * fields[i].value_at(t);
+      }
+      lo = std::min(lo, base - bound);
+      hi = std::max(hi, base + bound);
+    };
+
+    const size_t count = s1 - s0;
+    const size_t stride = (count + SAMPLES_PER_COLUMN - 1) / SAMPLES_PER_COLUMN;
+    for (size_t s = s0; s < s1; s += stride)
+      evaluate(s);
+    if (stride > 1) {
+      evaluate(s1 - 1);
+      auto e = std::lower_bound(events.begin(), events.end(), (double)s0);
+      for (; e != events.end() && *e < (double)s1; ++e)
+        evaluate(static_cast<size_t>(*e));
+    }
+    trace.lo[k] = lo;
+    trace.hi[k] = hi;
+  }
+  return trace;
+}
+
+// --- Description ---
+static std::string format_number(double v) {
+  char text[32];
+  std::snprintf(text, sizeof(text), "%g", v);
+  return text;
+}
+
+std::vector<std::string> describe_rt_fields(const std::vector<RtField> &fields,
+                                            double dt, size_t steps,
+                                            int width) {
+  std::vector<std::string> lines;
+  for (const RtField &f : fields) {
+    std::string line;
+    switch (f.envelope) {
+    case FieldEnvelope::STEP:
+      line = "Step";
+      break;
+    case FieldEnvelope::LINEAR_RAMP:
+      line = "Ramp";
+      break;
+    case FieldEnvelope::PLANE_WAVE:
+      line = std::string(f.sine ? "Sin" : "Cos") + " ω=" +
+             format_number(f.omega);
+      break;
+    case FieldEnvelope::GAUSSIAN:
+      line = "Gauss α=" + format_number(f.alpha);
+      break;
+    }
+    line += " " + format_number(f.t_on) + "-" + format_number(f.t_off) +
+            " au (" + format_number(f.amplitude[0]) + "," +
+            format_number(f.amplitude[1]) + "," +
+            format_number(f.amplitude[2]) + ")";
+    lines.push_back(line);
+  }
+  if (fields.empty() || !(dt > 0.0) || steps == 0) {
+    lines.push_back("! no RT.MAXSTEPS or TMAX/DELTAT; field not sampled");
+    return lines;
+  }
+
+  const int plot_width = std::max(width - 8, 4);
+  FieldTrace trace = sample_rt_fields(fields, dt, steps, 2 * plot_width);
+  for (const auto &line : plot_ranges(trace.lo, trace.hi, plot_width, 2))
+    lines.push_back(line);
+
+  // Name the axis when it is a Cartesian one
+  std::string axis;
+  for (int i = 0; i < 3; ++i)
+    if (std::fabs(trace.axis[i]) > 1.0 - 1e-9)
+      axis = std::string(trace.axis[i] < 0 ? "-" : "") + "xyz"[i];
+  if (axis.empty())
+    axis = "(" + format_number(std::round(trace.axis[0] * 100) / 100) + "," +
+           format_number(std::round(trace.axis[1] * 100) / 100) + "," +
+           format_number(std::round(trace.axis[2] * 100) / 100) + ")";
+  lines.push_back("E·" + axis + ", 0-" + format_number(steps * dt) + " au, " +
+                  std::to_string(steps) + " steps");
+  return lines;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+enum class FieldEnvelope { STEP, LINEAR_RAMP, PLANE_WAVE, GAUSSIAN };
+
+/**
+ * \brief One line of an [RT] FIELD block, as parseRTField reads it:
+ *        "Envelope[parameters](tOn,tOff) Electric x y z". Times in au.
+ */
+struct RtField {
+  FieldEnvelope envelope = FieldEnvelope::STEP;
+  double t_on = 0.0, t_off = 0.0;
+  double omega = 0.0;  ///< PLANE_WAVE angular frequency
+  bool sine = false;   ///< PLANE_WAVE sin(ωt) instead of cos(ωt)
+  double alpha = 0.0;  ///< GAUSSIAN exponent
+  std::array<double, 3> amplitude = {0.0, 0.0, 0.0}; ///< Dipole field (au)
+
+  // Envelope without the plane-wave carrier, 0 outside [t_on, t_off] (a
+  // linear ramp stays on after t_off)
+  double envelope_at(double t) const;
+  // Envelope times carrier
+  double value_at(double t) const;
+};
+
+/**
+ * \brief Parse the lines of an RT.FIELD value. Envelopes are StepField,
+ *        LinearRampField, PlaneWaveField[ω(,cos|sin)] and GaussianField[α].
+ *
+ * \param [out] errors One message per line that could not be read
+ */
+std::vector<RtField> parse_rt_fields(const std::string &value,
+                                     std::vector<std::string> &errors);
+
+// A field projected on one polarization, min/max decimated to columns
+struct FieldTrace {
+  std::array<double, 3> axis = {0.0, 0.0, 1.0}; ///< Unit polarization
+  std::vector<double> lo, hi; ///< Per column (au), over steps 0..steps
+};
+
+/**
+ * \brief Sample the sum of `fields` at t = 0, dt, ..., steps * dt along the
+ *        polarization of the strongest field and keep each column's extremes.
+ *
+ * A column evaluates at most a few hundred steps plus the steps at each
+ * window's edges, so a kick a few steps long still shows in a million-step
+ * run. Where a column spans a whole period of a plane wave, its carrier is
+ * bounded by ±1 instead of sampled. The cost is independent of `steps`.
+ */
+FieldTrace sample_rt_fields(const std::vector<RtField> &fields, double dt,
+                            size_t steps, size_t columns);
+
+/**
+ * \brief Info-panel lines for the fields of an RT job: one per field and a
+ *        sparkline of the trace, `width` columns wide.
+ */
+std::vector<std::string> describe_rt_fields(const std::vector<RtField> &fields,
+                                            double dt, size_t steps,
+                                            int width);
@@ -0,0 +1,313 @@
+#include "ScfMonitor.hpp"
+#include "InputFile.hpp"
+#include "TextPlot.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#endif
+
+// ChronusQ's rmsdPConvTol when SCF.ACCURACY is not given
+static const double DEFAULT_ACCURACY = 1e-8;
+
+// --- Parsing ---
+
+void ScfLog::feed(const char *data, size_t size) {
+  const char *end = data + size;
+  while (data < end) {
+    const char *newline =
+        static_cast<const char *>(std::memchr(data, '\n', end - data));
+    if (!newline) {
+      partial_.append(data, end);
+      return;
+    }
+    if (partial_.empty()) {
+      parse_line(data, newline);
+    } else {
+      partial_.append(data, newline);
+      parse_line(partial_.data(), partial_.data() + partial_.size());
+      partial_.clear();
+    }
+    data = newline + 1;
+  }
+}
+
+static bool contains(const char *begin, const char *end, const char *word) {
+  const size_t n = std::strlen(word);
+  for (const char *p = begin; p + n <= end; ++p)
+    if (std::memcmp(p, word, n) == 0)
+      return true;
+  return false;
+}
+
+void ScfLog::parse_line(const char *begin, const char *end) {
+  while (begin < end && (*begin == ' ' || *begin == '\t'))
+    ++begin;
+
+  // "  SCFIt: 7     -76.0107465155    -1.2345678e-06    2.3456789e-05 ..."
+  static const char TAG[] = "SCFIt:";
+  const size_t tag = sizeof(TAG) - 1;
+  if (static_cast<size_t>(end - begin) > tag &&
+      std::memcmp(begin, TAG, tag) == 0) {
+    // strtod stops at the first non-number, so copy the bounded line once
+    std::string line(begin + tag, end);
+    double values[5];
+    int count = 0;
+    const char *p = line.c_str();
+    for (char *next; count < 5; p = next) {
+      values[count] = std::strtod(p, &next);
+      if (next == p)
+        break;
+      ++count;
+    }
+    if (count < 2)
+      return;
+
+    ScfIteration it;
+    it.iteration = static_cast<int>(values[0]);
+    it.energy = values[1];
+    it.delta_energy = count > 2 ? values[2] : NAN;
+    it.delta_density = count > 3 ? values[3] : NAN;
+    it.delta_magnetization = count > 4 ? values[4] : NAN;
+    if (state != ScfState::RUNNING || iterations.empty() ||
+        it.iteration <= iterations.back().iteration) {
+      iterations.clear();
+      ++scf_count;
+    }
+    iterations.push_back(it);
+    state = ScfState::RUNNING;
+    return;
+  }
+
+  // "Step: 120  Time (AU): 6.0000 ..." of a real-time propagation
+  static const char STEP[] = "Step";
+  const size_t step = sizeof(STEP) - 1;
+  if (static_cast<size_t>(end - begin) > step &&
+      std::memcmp(begin, STEP, step) == 0) {
+    std::string line(begin + step, end);
+    const char *p = line.c_str();
+    while (*p == ':' || *p == ' ' || *p == '\t')
+      ++p;
+    char *next;
+    const long value = std::strtol(p, &next, 10);
+    if (next == p || value < 0)
+      return;
+    rt_step = value;
+    rt_time = NAN;
+    const size_t time = line.find("Time");
+    if (time != std::string::npos) {
+      p = line.c_str() + time + 4;
+      while (*p && !std::isdigit(static_cast<unsigned char>(*p)) &&
+             *p != '-' && *p != '.')
+        ++p;
+      const double t = std::strtod(p, &next);
+      if (next != p)
+        rt_time = t;
+    }
+    return;
+  }
+
+  if (state != ScfState::RUNNING)
+    return;
+  if (contains(begin, end, "SCF Completed"))
+    state = ScfState::CONVERGED;
+  else if (contains(begin, end, "SCF Failed"))
+    state = ScfState::FAILED;
+}
+
+// --- Following ---
+
+OutputFollower::OutputFollower(const std::string &path, bool watch)
+    : path_(path), watch_(watch) {
+  size_t slash = path.find_last_of('/');
+  const std::string dir = slash == std::string::npos
+                              ? "."
+                              : path.substr(0, std::max<size_t>(slash, 1));
+  name_ = slash == std::string::npos ? path : path.substr(slash + 1);
+#if defined(__linux__)
+  // The directory, not the file: creation and replacement show up too
+  if (watch)
+    watch_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (watch_fd_ >= 0 &&
+      inotify_add_watch(watch_fd_, dir.c_str(),
+                        IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE |
+                            IN_MOVED_TO) < 0) {
+    close(watch_fd_);
+    watch_fd_ = -1;
+  }
+#endif
+}
+
+OutputFollower::~OutputFollower() {
+  if (file_fd_ >= 0)
+    close(file_fd_);
+  if (watch_fd_ >= 0)
+    close(watch_fd_);
+}
+
+bool OutputFollower::poll(ScfLog &log) {
+  bool changed = pending_ || (watch_ && watch_fd_ < 0);
+  pending_ = false;
+#if defined(__linux__)
+  if (watch_fd_ >= 0) {
+    alignas(inotify_event) char buf[4096];
+    for (ssize_t n; (n = read(watch_fd_, buf, sizeof(buf))) > 0;)
+      for (ssize_t pos = 0; pos < n;) {
+        const auto *event = reinterpret_cast<const inotify_event *>(buf + pos);
+        if (event->len && name_ == event->name)
+          changed = true;
+        pos += sizeof(inotify_event) + event->len;
+      }
+  }
+#endif
+  return changed && read_appended(log);
+}
+
+bool OutputFollower::tail_unchanged() const {
+  char buf[TAIL];
+  return tail_.empty() ||
+         (pread(file_fd_, buf, tail_.size(), offset_ - tail_.size()) ==
+              static_cast<ssize_t>(tail_.size()) &&
+          std::memcmp(buf, tail_.data(), tail_.size()) == 0);
+}
+
+bool OutputFollower::read_appended(ScfLog &log) {
+  // A different file under the same name (rotated or rewritten) starts over
+  struct stat st;
+  if (stat(path_.c_str(), &st) != 0)
+    return false;
+  if (file_fd_ >= 0 && st.st_ino != inode_) {
+    close(file_fd_);
+    file_fd_ = -1;
+  }
+  if (file_fd_ < 0) {
+    file_fd_ = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file_fd_ < 0)
+      return false;
+    if (fstat(file_fd_, &st) != 0)
+      return false;
+    inode_ = st.st_ino;
+    offset_ = 0;
+    tail_.clear();
+    log.reset();
+  } else if (static_cast<uint64_t>(st.st_size) < offset_ ||
+             !tail_unchanged()) {
+    offset_ = 0; // Truncated or rewritten in place
+    tail_.clear();
+    log.reset();
+  }
+
+  bool any = false;
+  char buf[1 << 16];
+  for (ssize_t n; (n = pread(file_fd_, buf, sizeof(buf), offset_)) > 0;) {
+    log.feed(buf, static_cast<size_t>(n));
+    offset_ += n;
+    bytes_read += n;
+    tail_.append(buf, n);
+    if (tail_.size() > TAIL)
+      tail_.erase(0, tail_.size() - TAIL);
+    any = true;
+  }
+  return any;
+}
+
+// --- Description ---
+
+double scf_accuracy(const std::string &value) {
+  double accuracy = std::atof(value.c_str());
+  return accuracy > 0 ? accuracy : DEFAULT_ACCURACY;
+}
+
+std::vector<std::string> describe_scf(const ScfLog &log, int width,
+                                      double accuracy) {
+  std::vector<std::string> lines;
+  if (log.iterations.empty()) {
+    lines.push_back("Waiting for SCF iterations...");
+    return lines;
+  }
+
+  const ScfIteration &last = log.iterations.back();
+  const char *state = log.state == ScfState::CONVERGED ? "converged"
+                      : log.state == ScfState::FAILED  ? "FAILED"
+                                                       : "running";
+  char buf[160];
+  std::snprintf(buf, sizeof(buf), "SCF %zu, iteration %d: %s", log.scf_count,
+                last.iteration, state);
+  lines.push_back(buf);
+  std::snprintf(buf, sizeof(buf), "E = %.10f Eh", last.energy);
+  lines.push_back(buf);
+
+  std::vector<double> de, dp;
+  for (const auto &it : log.iterations) {
+    de.push_back(std::fabs(it.delta_energy));
+    dp.push_back(it.delta_density);
+  }
+  const int plot_width = std::max(8, width - 8);
+  std::snprintf(buf, sizeof(buf), "|ΔE| %.2e (tol %.0e)", de.back(),
+                100 * accuracy);
+  lines.push_back(buf);
+  for (auto &line : plot_log_series(de, plot_width, 3, 100 * accuracy))
+    lines.push_back(std::move(line));
+  std::snprintf(buf, sizeof(buf), "|ΔP| %.2e (tol %.0e)", dp.back(), accuracy);
+  lines.push_back(buf);
+  for (auto &line : plot_log_series(dp, plot_width, 3, accuracy))
+    lines.push_back(std::move(line));
+  return lines;
+}
+
+// --- Monitor mode ---
+
+static volatile sig_atomic_t monitoring = 1;
+static void stop_monitor(int) { monitoring = 0; }
+
+int run_monitor(const std::string &output, const std::string &input) {
+  double accuracy = DEFAULT_ACCURACY;
+  if (!input.empty())
+    accuracy = scf_accuracy(
+        parse_inp_file(input).get_parameter("SCF", "ACCURACY"));
+
+  std::signal(SIGINT, stop_monitor);
+  std::signal(SIGTERM, stop_monitor);
+
+  OutputFollower follower(output);
+  ScfLog log;
+  bool first = true;
+  while (monitoring) {
+    if (follower.poll(log) || first) {
+      first = false;
+      struct winsize ws {};
+      int columns = 80;
+      if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 0)
+        columns = ws.ws_col;
+      std::string screen = "\033[H\033[J" + output + "\n\n";
+      for (const auto &line : describe_scf(log, std::min(columns, 120) - 2,
+                                           accuracy))
+        screen += line + "\n";
+      char status[96];
+      std::snprintf(status, sizeof(status),
+                    "\n%llu bytes read; Ctrl-C to stop\n",
+                    static_cast<unsigned long long>(follower.bytes_read));
+      screen += status;
+      std::fwrite(screen.data(), 1, screen.size(), stdout);
+      std::fflush(stdout);
+    }
+    // Sleep until the directory reports a change (or poll the size)
+    pollfd pfd{follower.fd(), POLLIN, 0};
+    if (follower.fd() >= 0)
+      ::poll(&pfd, 1, 500);
+    else
+      usleep(250000);
+  }
+  return log.state == ScfState::CONVERGED ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+// One "SCFIt:" row of a ChronusQ output; NaN where the row has no value
+// (iteration 0 prints no differences, closed shells no |ΔP(M)|)
+struct ScfIteration {
+  int iteration = 0;
+  double energy;              ///< Eh
+  double delta_energy;        ///< ΔE (Eh)
+  double delta_density;       ///< |ΔP(S)|, RMS scalar density change
+  double delta_magnetization; ///< |ΔP(M)|
+};
+
+enum class ScfState { WAITING, RUNNING, CONVERGED, FAILED };
+
+/**
+ * \brief Incremental parser of ChronusQ output: feed it bytes as they are
+ *        appended and it keeps the iterations of the current SCF.
+ *
+ * Only complete lines are parsed; a trailing partial line is held until the
+ * rest arrives. A row whose iteration does not follow the previous one
+ * starts a new SCF (e.g. a second geometry or a restart). Lines starting
+ * with "Step" followed by a number track a real-time propagation.
+ */
+class ScfLog {
+  std::string partial_; ///< Unterminated last line
+
+  void parse_line(const char *begin, const char *end);
+
+public:
+  std::vector<ScfIteration> iterations; ///< Of the current SCF
+  ScfState state = ScfState::WAITING;
+  size_t scf_count = 0; ///< SCFs seen so far, the current one included
+  long rt_step = -1;     ///< Last real-time step printed, -1 before any
+  double rt_time = NAN;  ///< Its "Time" (au), NaN if the line had none
+
+  void feed(const char *data, size_t size);
+  void reset() { *this = ScfLog(); }
+};
+
+/**
+ * \brief Follows a growing file: each poll() reads only the bytes appended
+ *        since the last one.
+ *
+ * On Linux the file's directory is watched with inotify, so a poll with no
+ * event costs one non-blocking read() and the file may not exist yet when
+ * following starts. If the file is truncated, rewritten in place (the bytes
+ * just before the offset changed) or replaced, the log is reset and the new
+ * file read from its start. Elsewhere every poll stats the file.
+ *
+ * With `watch` false the owner watches the directory instead (one inotify
+ * instance for many files) and calls notify() when the file changes.
+ */
+class OutputFollower {
+  std::string path_, name_;
+  int watch_fd_ = -1; ///< inotify descriptor, -1 without inotify
+  int file_fd_ = -1;
+  uint64_t offset_ = 0; ///< Bytes of the current file already parsed
+  std::string tail_;    ///< Last bytes before offset_, to notice rewrites
+  ino_t inode_ = 0;
+  bool pending_ = true; ///< Read on the next poll whatever the events say
+  bool watch_ = true;   ///< Without an own watch, read only when notified
+
+  static constexpr size_t TAIL = 64;
+
+  bool tail_unchanged() const;
+  bool read_appended(ScfLog &log);
+
+public:
+  explicit OutputFollower(const std::string &path, bool watch = true);
+  ~OutputFollower();
+  OutputFollower(const OutputFollower &) = delete;
+  OutputFollower &operator=(const OutputFollower &) = delete;
+
+  // Descriptor that becomes readable on a change (for poll()), -1 if none
+  int fd() const { return watch_fd_; }
+  // File name within its directory, as inotify events report it
+  const std::string &name() const { return name_; }
+  void notify() { pending_ = true; }
+
+  uint64_t bytes_read = 0; ///< Over all files followed
+
+  // Feed newly appended bytes to the log; true if anything was read
+  bool poll(ScfLog &log);
+};
+
+/**
+ * \brief Status line and |ΔE| / |ΔP| plots of the current SCF, ready for the
+ *        info panel or the monitor screen.
+ *
+ * \param [in] accuracy SCF.ACCURACY: the density threshold; energy and the
+ *                      maximum density change converge at 100x that
+ */
+std::vector<std::string> describe_scf(const ScfLog &log, int width,
+                                      double accuracy);
+
+// SCF.ACCURACY of a parsed input, ChronusQ's default if unset
+double scf_accuracy(const std::string &value);
+
+/**
+ * \brief Follow a ChronusQ output file and redraw its SCF convergence on
+ *        every append until interrupted.
+ *
+ * \param [in] input Optional .inp file for SCF.ACCURACY ("" for the default)
+ * \returns Exit status: 0 if the last SCF converged, 1 otherwise
+ */
+int run_monitor(const std::string &output, const std::string &input);
@@ -0,0 +1,924 @@
+#pragma once
+
+// Generated by gen_schema.py from the allowedKeywords lists in
+// input/*.cxx -- do not edit by hand.
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace schema {
+
+struct Section {
+  const char *name;
+  const char *const *keywords;
+  size_t count;
+  const char *const *docs; // Parallel to keywords, "" if none
+};
+
+inline constexpr const char *KW_BASIS[] = {
+    "BASIS",
+    "BASISDEF",
+    "BASISTYPE",
+    "DEFINEBASIS",
+    "FORCECART",
+};
+inline constexpr const char *DOC_BASIS[] = {
+    "",
+    "",
+    "",
+    "",
+    "",
+};
+inline constexpr const char *KW_CC[] = {
+    "ETOL",
+    "FROZENOCCUPIED",
+    "FROZENVIRTUAL",
+    "MAXITER",
+    "NDIIS",
+    "NEVARIATION",
+    "REBUILDFOCK",
+    "TABLKSIZE",
+    "TTOL",
+    "TYPE",
+    "USEDIIS",
+};
+inline constexpr const char *DOC_CC[] = {
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+};
+inline constexpr const char *KW_DFTINT[] = {
+    "EPS",
+    "GAUXC",
+    "INHOUSE",
+    "NANG",
+    "NMACRO",
+    "NRAD",
+};
+inline constexpr const char *DOC_DFTINT[] = {
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+};
+inline constexpr const char *KW_DYNAMICS[] = {
+    "DELTAT",
+    "INIT_PERT",
+    "NELECPNUC",
+    "NNUCPGRAD",
+    "PERT_VALUE_X",
+    "PERT_VALUE_Y",
+    "PERT_VALUE_Z",
+    "RESTART",
+    "SAVEALLGEOMETRY",
+    "TMAX",
+    "TPB",
+};
+inline constexpr const char *DOC_DYNAMICS[] = {
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+};
+inline constexpr const char *KW_EOMCC[] = {
+    "CVSCONTINUUM",
+    "CVSCORE",
+    "DAVIDSONBIORTHO",
+    "DAVIDSONCHECKEVAL",
+    "DAVIDSONCHECKEVEC",
+    "DAVIDSONCONVONGRAMSCHMIDT",
+    "DAVIDSONENERGYSPECIFICABS",
+    "DAVIDSONEVALCONV",
+    "DAVIDSONEVECCONV",
+    "DAVIDSONGUESSMULTIPLIER",
+    "DAVIDSONMAXMACROITER",
+    "DAVIDSONMAXMICROITER",
+    "DAVIDSONPRECONDSMALL",
+    "DAVIDSONRCHECKESIDUAL",
+    "DAVIDSONRESIDUALCONV",
+    "DAVIDSONSUBSPACEMULTIPLIER",
+    "DAVIDSONWHENSC",
+    "DIAGMETHOD",
+    "GRAMSCHMIDTEPS",
+    "GRAMSCHMIDTREPEAT",
+    "HBARTYPE",
+    "NROOTS",
+    "OSCILLATORSTRENGTH",
+    "SAVEHAMILTONIAN",
+};
+inline constexpr const char *DOC_EOMCC[] = {
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+};
+inline constexpr const char *KW_GAUXC[] = {
+    "BASISTOL",
+    "BATCHSIZE",
+    "GPU",
+    "GPUMEMFRAC",
+    "GRID",
+    "INTKERNEL",
+    "PBASISTOL",
+    "PRUNINGSCHEME",
+    "RADIALQUAD",
+    "XCBACKEND",
+    "XCWEIGHTALG",
+};
+inline constexpr const char *DOC_GAUXC[] = {
+    "double",
+    "size_t",
+    "True or False",
+    "Float between 0 and 1",
+    "string: fine, ultrafine, superfine, GM3, GM5",
+    "string: default, shellbatched (gpu only), incore (gpu only), reference (cpu only)",
+    "double",
+    "string: unpruned, robust, treutler",
+    "string: MuraKnowles,MurrayHandyLaming,TreutlerAldrichs",
+    "string: libxc, builtin",
+    "string: Becke, SSF, LKO",
+};
+inline constexpr const char *KW_INTS[] = {
+    "ALG",
+    "BARECOULOMB",
+    "BREIT",
+    "DC",
+    "DIRACCOULOMB",
+    "FINITENUCLEI",
+    "GAUGE",
+    "GAUNT",
+    "GRADALG",
+    "LIBCINT",
+    "LLLL",
+    "RI",
+    "RIBUILD4INDEX",
+    "RICOMBINEBASISTHRESH",
+    "RICOMBINEBASISTRUNCATE",
+    "RIGENCONTR",
+    "RIMAXQUAL",
+    "RIMINSHRINK",
+    "RIREPORTERROR",
+    "RISIGMA",
+    "RITHRESHOLD",
+    "SCHWARZ",
+    "SSSS",
+    "TPITRANSALG",
+};
+inline constexpr const char *DOC_INTS[] = {
+    "Direct or Incore?",
+    "True or False",
+    "True or False",
+    "True or False, SF, SD, 3C, 2C, 1C, AMF",
+    "True or False",
+    "True or False",
+    "True or False",
+    "True or False",
+    "Direct or Incore for gradients?",
+    "Ture or False",
+    "True or False",
+    "String, determines which algorithm to use for RI/CD",
+    "True or False",
+    "Double, determines for combineAuxBasis algorithm what threshold to use for the CD of twoCenterERI",
+    "String, determines for combineAuxBasis algorithm whether to remove linear deps using some threshold",
+    "True or False",
+    "size_t",
+    "size_t",
+    "True of False, keyword only for EPINTS Section and only applies if the user chooses to approximate (ee|pp)",
+    "double",
+    "double",
+    "double",
+    "True or False",
+    "N5 or N6",
+};
+inline constexpr const char *KW_MCSCF[] = {
+    "CASORBITAL",
+    "CICONV",
+    "CIDIAGALG",
+    "CUBE",
+    "FIELD",
+    "FVORBITAL",
+    "GENIVO",
+    "HESSDIAGSCALE",
+    "INORBITAL",
+    "JOBTYPE",
+    "MAXCIITER",
+    "MAXDAVIDSONSPACE",
+    "MAXSCFITER",
+    "NACTE",
+    "NACTO",
+    "NDAVIDSONGUESS",
+    "NROOTS",
+    "OSCISTREN",
+    "POPULATION",
+    "PRINTMOS",
+    "PRINTMULT",
+    "PRINTRDMS",
+    "PRINTSPIN",
+    "RAS1MAXHOLE",
+    "RAS1ORBITAL",
+    "RAS2ORBITAL",
+    "RAS3MAXELEC",
+    "RAS3ORBITAL",
+    "READCI",
+    "ROTATENEGORBS",
+    "SAWEIGHTS",
+    "SCFALG",
+    "SCFENECONV",
+    "SCFGRADCONV",
+    "STATEAVERAGE",
+    "SWAPMO",
+};
+inline constexpr const char *DOC_MCSCF[] = {
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+};
+inline constexpr const char *KW_MCSCF_CUBE[] = {
+    "DEN",
+    "MAGANDPHASE",
+    "MOS",
+    "NAME",
+    "ORB",
+    "PADDING",
+    "POINTS",
+    "RES",
+    "STEPS",
+};
+inline constexpr const char *DOC_MCSCF_CUBE[] = {
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+};
+inline constexpr const char *KW_MISC[] = {
+    "DEBUGTIMING",
+    "MEM",
+    "MEMBLK",
+    "MEMTYPE",
+    "NSMP",
+    "TIMER",
+    "TIMERUNIT",
+};
+inline constexpr const char *DOC_MISC[] = {
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+};
+inline constexpr const char *KW_MOLECULE[] = {
+    "CHARGE",
+    "GEOM",
+    "MULT",
+    "READGEOM",
+};
+inline constexpr const char *DOC_MOLECULE[] = {
+    "",
+    "",
+    "",
+    "",
+};
+inline constexpr const char *KW_MOR[] = {
+    "ERRMETH",
+    "GETEIG",
+    "NMODEL",
+    "NMODELMAX",
+    "REFINE",
+};
+inline constexpr const char *DOC_MOR[] = {
+    "",
+    "",
+    "",
+    "",
+    "",
+};
+inline constexpr const char *KW_PBASIS[] = {
+    "BASIS",
+    "BASISDEF",
+    "BASISTYPE",
+    "DEFINEBASIS",
+    "FORCECART",
+};
+inline constexpr const char *DOC_PBASIS[] = {
+    "",
+    "",
+    "",
+    "",
+    "",
+};
+inline constexpr const char *KW_PERTURB[] = {
+    "DOFULL",
+    "DOGVVPT",
+    "DOITER",
+    "EXTENDMS",
+    "FROZENCORE",
+    "FROZENVIRTUAL",
+    "IMAGINARYSHIFT",
+    "ITERCONV",
+    "LEVELSHIFT",
+    "MAXITER",
+    "SELECTVIRTUAL",
+    "SOI",
+    "STATEAVERAGE",
+};
+inline constexpr const char *DOC_PERTURB[] = {
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+};
+inline constexpr const char *KW_PINTS[] = {
+    "ALG",
+    "BARECOULOMB",
+    "BREIT",
+    "DC",
+    "DIRACCOULOMB",
+    "FINITENUCLEI",
+    "GAUGE",
+    "GAUNT",
+    "GRADALG",
+    "LIBCINT",
+    "LLLL",
+    "RI",
+    "RIBUILD4INDEX",
+    "RICOMBINEBASISTHRESH",
+    "RICOMBINEBASISTRUNCATE",
+    "RIGENCONTR",
+    "RIMAXQUAL",
+    "RIMINSHRINK",
+    "RIREPORTERROR",
+    "RISIGMA",
+    "RITHRESHOLD",
+    "SCHWARZ",
+    "SSSS",
+    "TPITRANSALG",
+};
+inline constexpr const char *DOC_PINTS[] = {
+    "Direct or Incore?",
+    "True or False",
+    "True or False",
+    "True or False, SF, SD, 3C, 2C, 1C, AMF",
+    "True or False",
+    "True or False",
+    "True or False",
+    "True or False",
+    "Direct or Incore for gradients?",
+    "Ture or False",
+    "True or False",
+    "String, determines which algorithm to use for RI/CD",
+    "True or False",
+    "Double, determines for combineAuxBasis algorithm what threshold to use for the CD of twoCenterERI",
+    "String, determines for combineAuxBasis algorithm whether to remove linear deps using some threshold",
+    "True or False",
+    "size_t",
+    "size_t",
+    "True of False, keyword only for EPINTS Section and only applies if the user chooses to approximate (ee|pp)",
+    "double",
+    "double",
+    "double",
+    "True or False",
+    "N5 or N6",
+};
+inline constexpr const char *KW_QM[] = {
+    "ATOMICX2C",
+    "JOB",
+    "NUCREFERENCE",
+    "REFERENCE",
+    "SNSOTYPE",
+    "SPINORBITSCALING",
+    "X2CTYPE",
+};
+inline constexpr const char *DOC_QM[] = {
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+};
+inline constexpr const char *KW_RESPONSE[] = {
+    "AOPS",
+    "BFREQ",
+    "BOPS",
+    "CONV",
+    "DAMP",
+    "DEMIN",
+    "DISTMATFROMROOT",
+    "DOAPBAMB",
+    "DOFULL",
+    "DOREDUCED",
+    "DOSTAB",
+    "FORCEDAMP",
+    "FORMMATDIST",
+    "FULLMAT",
+    "GPLHR_M",
+    "GPLHR_SIGMA",
+    "MAXITER",
+    "NEO",
+    "NROOTS",
+    "PPSPINMAT",
+    "PPSTAR",
+    "PPTDAMAT",
+    "PROPAGATOR",
+    "TDA",
+    "TYPE",
+};
+inline constexpr const char *DOC_RESPONSE[] = {
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+};
+inline constexpr const char *KW_RT[] = {
+    "CIPOPULATION",
+    "COEFFS",
+    "DELTAT",
+    "DETS",
+    "FIELD",
+    "FIELDINDEPENDENTHAMILTONIAN",
+    "INITTYPE",
+    "INTALG",
+    "IRSTRT",
+    "LCSTATES",
+    "LCWEIGHTS",
+    "MAXSTEPS",
+    "ORBITALPOPFREQ",
+    "PRINTCONTRACTIONTIMING",
+    "PRINTDEN",
+    "PRINTLEVEL",
+    "PRINTSTEP",
+    "PROT_INTALG",
+    "REALTIMECORRELATIONFUNC",
+    "REALTIMECORRELATIONFUNCSTART",
+    "RESTART",
+    "RESTARTALG",
+    "RESTARTFROM",
+    "RESTARTSTEP",
+    "RTBREIT",
+    "RTGAUGE",
+    "RTGAUNT",
+    "RTPRINTDEN",
+    "SAVEONEPDM",
+    "SAVESTEP",
+    "SCFFIELD",
+    "TMAX",
+    "TYPE",
+    "UNITS",
+};
+inline constexpr const char *DOC_RT[] = {
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "The total time for the whole dynamics: 100 fs (Default)",
+    "Type of dynamics: BOMD (Default), Ehrenfest, RT",
+    "The units of time: FS (Default), AU",
+};
+inline constexpr const char *KW_SCF[] = {
+    "ACCURACY",
+    "ALG",
+    "CUBE",
+    "DAMP",
+    "DAMPERROR",
+    "DAMPPARAM",
+    "DENTOL",
+    "DIIS",
+    "DIISALG",
+    "ENETOL",
+    "EXTRAP",
+    "FDCTOL",
+    "FIELD",
+    "GUESS",
+    "INCFOCK",
+    "MAXITER",
+    "NEO",
+    "NINCFOCK",
+    "NKEEP",
+    "NRAPPROX",
+    "NRLEVELSHIFT",
+    "NRTRUST",
+    "PRINTCONTRACTIONTIMING",
+    "PRINTMOS",
+    "PROT_GUESS",
+    "SWAPMO",
+    "SWITCH",
+};
+inline constexpr const char *DOC_SCF[] = {
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+};
+inline constexpr const char *KW_SCF_CUBE[] = {
+    "DEN",
+    "MAGANDPHASE",
+    "MOS",
+    "NAME",
+    "ORB",
+    "PADDING",
+    "POINTS",
+    "RES",
+    "STEPS",
+};
+inline constexpr const char *DOC_SCF_CUBE[] = {
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+};
+
+inline constexpr Section SECTIONS[] = {
+    {"BASIS", KW_BASIS, sizeof(KW_BASIS) / sizeof(KW_BASIS[0]), DOC_BASIS},
+    {"CC", KW_CC, sizeof(KW_CC) / sizeof(KW_CC[0]), DOC_CC},
+    {"DFTINT", KW_DFTINT, sizeof(KW_DFTINT) / sizeof(KW_DFTINT[0]), DOC_DFTINT},
+    {"DYNAMICS", KW_DYNAMICS, sizeof(KW_DYNAMICS) / sizeof(KW_DYNAMICS[0]), DOC_DYNAMICS},
+    {"EOMCC", KW_EOMCC, sizeof(KW_EOMCC) / sizeof(KW_EOMCC[0]), DOC_EOMCC},
+    {"GAUXC", KW_GAUXC, sizeof(KW_GAUXC) / sizeof(KW_GAUXC[0]), DOC_GAUXC},
+    {"INTS", KW_INTS, sizeof(KW_INTS) / sizeof(KW_INTS[0]), DOC_INTS},
+    {"MCSCF", KW_MCSCF, sizeof(KW_MCSCF) / sizeof(KW_MCSCF[0]), DOC_MCSCF},
+    {"MCSCF.CUBE", KW_MCSCF_CUBE, sizeof(KW_MCSCF_CUBE) / sizeof(KW_MCSCF_CUBE[0]), DOC_MCSCF_CUBE},
+    {"MISC", KW_MISC, sizeof(KW_MISC) / sizeof(KW_MISC[0]), DOC_MISC},
+    {"MOLECULE", KW_MOLECULE, sizeof(KW_MOLECULE) / sizeof(KW_MOLECULE[0]), DOC_MOLECULE},
+    {"MOR", KW_MOR, sizeof(KW_MOR) / sizeof(KW_MOR[0]), DOC_MOR},
+    {"PBASIS", KW_PBASIS, sizeof(KW_PBASIS) / sizeof(KW_PBASIS[0]), DOC_PBASIS},
+    {"PERTURB", KW_PERTURB, sizeof(KW_PERTURB) / sizeof(KW_PERTURB[0]), DOC_PERTURB},
+    {"PINTS", KW_PINTS, sizeof(KW_PINTS) / sizeof(KW_PINTS[0]), DOC_PINTS},
+    {"QM", KW_QM, sizeof(KW_QM) / sizeof(KW_QM[0]), DOC_QM},
+    {"RESPONSE", KW_RESPONSE, sizeof(KW_RESPONSE) / sizeof(KW_RESPONSE[0]), DOC_RESPONSE},
+    {"RT", KW_RT, sizeof(KW_RT) / sizeof(KW_RT[0]), DOC_RT},
+    {"SCF", KW_SCF, sizeof(KW_SCF) / sizeof(KW_SCF[0]), DOC_SCF},
+    {"SCF.CUBE", KW_SCF_CUBE, sizeof(KW_SCF_CUBE) / sizeof(KW_SCF_CUBE[0]), DOC_SCF_CUBE},
+};
+
+// Section names and SECTION.KEYWORD pairs, 315 keys in 1024 slots
+constexpr size_t BUCKETS = 78;
+constexpr size_t SLOTS = 1024;
+
+inline constexpr uint16_t DISPLACEMENT[BUCKETS] = {
+    1, 1, 2, 1, 1, 4, 1, 1, 1, 1, 1, 2,
+    2, 1, 1, 4, 2, 1, 1, 4, 1, 5, 1, 2,
+    0, 4, 1, 2, 1, 1, 1, 1, 3, 1, 2, 1,
+    2, 2, 1, 1, 1, 3, 1, 1, 6, 1, 1, 2,
+    1, 3, 1, 6, 1, 1, 3, 1, 0, 5, 2, 3,
+    1, 2, 2, 1, 1, 1, 1, 1, 2, 1, 3, 1,
+    10, 1, 3, 2, 4, 1,
+};
+
+inline constexpr const char *TABLE[SLOTS] = {
+    nullptr, nullptr, "PINTS", nullptr, nullptr, "MCSCF.RAS1MAXHOLE", nullptr,
+    nullptr, "SCF.CUBE", "RT.SCFFIELD", nullptr, "SCF.DENTOL", nullptr,
+    "PERTURB.EXTENDMS", nullptr, nullptr, nullptr, "RESPONSE.BFREQ",
+    "MCSCF.MAXSCFITER", "MISC.MEMTYPE", nullptr, nullptr, nullptr, "SCF.NKEEP",
+    "MOLECULE.MULT", nullptr, nullptr, "RESPONSE.DEMIN", nullptr, nullptr,
+    nullptr, nullptr, "EOMCC.DAVIDSONEVECCONV", nullptr, nullptr, nullptr,
+    "MISC", nullptr, nullptr, nullptr, "MCSCF.PRINTSPIN", nullptr, nullptr,
+    "DFTINT.EPS", "RESPONSE.NROOTS", "DFTINT.NANG", nullptr, nullptr, nullptr,
+    nullptr, "PINTS.TPITRANSALG", "RT.FIELDINDEPENDENTHAMILTONIAN", nullptr,
+    "DYNAMICS.PERT_VALUE_Z", nullptr, nullptr, "SCF.DAMP", nullptr,
+    "RT.RESTARTALG", nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "SCF.EXTRAP", nullptr, "PERTURB.ITERCONV",
+    nullptr, nullptr, "CC.FROZENOCCUPIED", nullptr, nullptr, nullptr, nullptr,
+    "RESPONSE.DOFULL", "SCF.CUBE.STEPS", nullptr, "EOMCC", nullptr, nullptr,
+    nullptr, nullptr, "INTS.RICOMBINEBASISTRUNCATE", nullptr, nullptr,
+    "PBASIS.FORCECART", nullptr, nullptr, "RT.RTBREIT", nullptr,
+    "RT.ORBITALPOPFREQ", nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    nullptr, "QM", nullptr, nullptr, "BASIS.BASISDEF", nullptr, nullptr,
+    "RESPONSE.CONV", nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "DFTINT.GAUXC", nullptr, nullptr, nullptr,
+    "RESPONSE.FORMMATDIST", "INTS.RICOMBINEBASISTHRESH", "SCF.ACCURACY",
+    "CC.TYPE", nullptr, nullptr, nullptr, "SCF.CUBE.MOS", nullptr, nullptr,
+    "INTS.GAUNT", nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    "EOMCC.DAVIDSONPRECONDSMALL", nullptr, nullptr, nullptr, nullptr, nullptr,
+    "MOR.GETEIG", nullptr, nullptr, "RESPONSE.PPSTAR", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr, nullptr, "SCF.PROT_GUESS", nullptr,
+    nullptr, nullptr, "INTS.TPITRANSALG", nullptr, nullptr, "PINTS.GAUGE",
+    "EOMCC.DAVIDSONMAXMICROITER", nullptr, "CC.NDIIS", "CC.ETOL", "RT.RTGAUNT",
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "RT.LCWEIGHTS", nullptr, nullptr, nullptr, nullptr,
+    nullptr, "EOMCC.DIAGMETHOD", "EOMCC.CVSCORE", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    "SCF.CUBE.PADDING", nullptr, "SCF.PRINTMOS", nullptr, nullptr, nullptr,
+    "RESPONSE.DOSTAB", nullptr, nullptr, nullptr, nullptr, nullptr,
+    "MCSCF.SCFALG", "SCF.SWAPMO", "MCSCF.CUBE.DEN", nullptr, nullptr,
+    "PINTS.RISIGMA", nullptr, nullptr, nullptr, "GAUXC.BASISTOL", nullptr,
+    "MCSCF.RAS3MAXELEC", nullptr, "PERTURB.IMAGINARYSHIFT", "SCF.CUBE.DEN",
+    "MISC.TIMER", "PINTS.FINITENUCLEI", "RESPONSE.GPLHR_M", nullptr,
+    "PINTS.RIGENCONTR", nullptr, "RESPONSE.FORCEDAMP", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr, "PINTS.GAUNT", nullptr, nullptr,
+    "CC.MAXITER", "CC.USEDIIS", "SCF", "SCF.NRAPPROX",
+    "RT.REALTIMECORRELATIONFUNC", nullptr, nullptr, nullptr,
+    "MOLECULE.READGEOM", nullptr, "CC.TABLKSIZE", nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr, "SCF.NINCFOCK", "DYNAMICS",
+    "RESPONSE.DAMP", "PINTS.RITHRESHOLD", "MCSCF.CICONV", nullptr, nullptr,
+    "MCSCF.CUBE.ORB", nullptr, nullptr, nullptr, "SCF.NRTRUST", nullptr,
+    nullptr, nullptr, "MCSCF.CUBE.NAME", "RT.PRINTSTEP", "CC.NEVARIATION",
+    nullptr, "PERTURB.SELECTVIRTUAL", nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "GAUXC.GRID", nullptr, nullptr, nullptr,
+    "RT.DETS", nullptr, "PINTS.GRADALG", nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    "MCSCF.CUBE.STEPS", nullptr, "INTS.RISIGMA", "SCF.CUBE.ORB", nullptr,
+    nullptr, nullptr, nullptr, nullptr, "MCSCF.NACTE", "MCSCF.SCFENECONV",
+    nullptr, nullptr, nullptr, nullptr, "INTS.LLLL", nullptr, nullptr, nullptr,
+    "INTS.DC", nullptr, "MOR.NMODEL", nullptr,
+    "EOMCC.DAVIDSONENERGYSPECIFICABS", "DYNAMICS.NELECPNUC", "GAUXC.XCBACKEND",
+    "PBASIS", nullptr, nullptr, nullptr, nullptr, "MCSCF.NROOTS", "MCSCF.FIELD",
+    "EOMCC.GRAMSCHMIDTEPS", "RT.TYPE", "RT.RTGAUGE", "INTS.SCHWARZ",
+    "RT.LCSTATES", nullptr, "QM.REFERENCE", "RT.IRSTRT", nullptr,
+    "INTS.LIBCINT", nullptr, "MCSCF.MAXCIITER", nullptr, "MCSCF.CUBE.MOS",
+    nullptr, "RT.PRINTLEVEL", nullptr, "SCF.FDCTOL", nullptr,
+    "MCSCF.STATEAVERAGE", nullptr, "BASIS.FORCECART", nullptr, nullptr,
+    "EOMCC.DAVIDSONGUESSMULTIPLIER", nullptr, nullptr, nullptr, "DFTINT",
+    nullptr, nullptr, nullptr, nullptr, "EOMCC.DAVIDSONBIORTHO", nullptr,
+    nullptr, nullptr, "GAUXC.BATCHSIZE", "MCSCF.POPULATION", nullptr, nullptr,
+    nullptr, nullptr, "MCSCF.PRINTMOS", "RT.COEFFS", "PINTS.RIMAXQUAL", nullptr,
+    "PERTURB.STATEAVERAGE", nullptr, nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "DFTINT.NRAD", "MCSCF.SWAPMO", nullptr, nullptr, nullptr,
+    nullptr, "MOR.ERRMETH", nullptr, "MCSCF.READCI", "PERTURB.LEVELSHIFT",
+    nullptr, nullptr, "RT.DELTAT", nullptr, nullptr, nullptr, "MCSCF.PRINTRDMS",
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, "CC.FROZENVIRTUAL",
+    nullptr, nullptr, nullptr, nullptr, "SCF.FIELD", "MOR", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    "GAUXC.GPUMEMFRAC", nullptr, "INTS.RIBUILD4INDEX", nullptr, nullptr,
+    "MCSCF.RAS2ORBITAL", nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    "GAUXC.XCWEIGHTALG", "PBASIS.BASIS", nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr, "PINTS.RICOMBINEBASISTHRESH", nullptr,
+    nullptr, nullptr, "SCF.NEO", "INTS.SSSS", nullptr, "GAUXC", nullptr,
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "PINTS.RI", "PBASIS.DEFINEBASIS", nullptr, nullptr,
+    "INTS.RIMAXQUAL", nullptr, nullptr, "SCF.DIISALG", nullptr, "CC.TTOL",
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, "EOMCC.CVSCONTINUUM",
+    "INTS.BARECOULOMB", nullptr, nullptr, "DYNAMICS.TPB", "MOR.NMODELMAX",
+    nullptr, nullptr, nullptr, "RESPONSE.NEO", "RESPONSE.DOREDUCED",
+    "CC.REBUILDFOCK", "PINTS.RIBUILD4INDEX", nullptr, nullptr, nullptr,
+    "RT.INITTYPE", nullptr, nullptr, nullptr, nullptr, "PERTURB.MAXITER",
+    nullptr, nullptr, nullptr, nullptr, "RESPONSE.BOPS", nullptr, "BASIS",
+    nullptr, nullptr, nullptr, nullptr, nullptr, "RESPONSE.AOPS",
+    "EOMCC.GRAMSCHMIDTREPEAT", nullptr, "PINTS.RICOMBINEBASISTRUNCATE", nullptr,
+    nullptr, nullptr, "MCSCF", nullptr, "INTS.RIGENCONTR", "GAUXC.GPU", nullptr,
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "RT.RESTART", "EOMCC.DAVIDSONSUBSPACEMULTIPLIER",
+    nullptr, nullptr, "RESPONSE.GPLHR_SIGMA", "MCSCF.NDAVIDSONGUESS", nullptr,
+    nullptr, nullptr, nullptr, nullptr, "MISC.MEMBLK", nullptr, nullptr,
+    "EOMCC.DAVIDSONWHENSC", nullptr, nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "SCF.PRINTCONTRACTIONTIMING", nullptr, nullptr,
+    "INTS.RIREPORTERROR", "DFTINT.NMACRO", "EOMCC.HBARTYPE", nullptr, nullptr,
+    nullptr, "RESPONSE.PROPAGATOR", nullptr, nullptr, nullptr, nullptr,
+    "SCF.MAXITER", nullptr, nullptr, "INTS.DIRACCOULOMB", nullptr, nullptr,
+    "SCF.DAMPPARAM", nullptr, nullptr, nullptr, nullptr, nullptr, "SCF.ENETOL",
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    "PERTURB.FROZENVIRTUAL", nullptr, nullptr, nullptr, nullptr,
+    "RESPONSE.DOAPBAMB", nullptr, nullptr, nullptr, nullptr, "QM.JOB", nullptr,
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    nullptr, "MCSCF.CUBE.RES", nullptr, nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, "SCF.GUESS", nullptr, nullptr, "MCSCF.CUBE.MAGANDPHASE",
+    nullptr, "RT.FIELD", "PINTS.DC", nullptr, "SCF.INCFOCK", nullptr, nullptr,
+    nullptr, "BASIS.DEFINEBASIS", "PBASIS.BASISDEF", nullptr, "BASIS.BASIS",
+    "RT.CIPOPULATION", "PINTS.DIRACCOULOMB", nullptr, nullptr, nullptr,
+    "SCF.CUBE.NAME", "INTS.RI", nullptr, "RT.SAVESTEP", nullptr, nullptr,
+    nullptr, nullptr, "RESPONSE.FULLMAT", "GAUXC.PBASISTOL", nullptr,
+    "MOLECULE.CHARGE", nullptr, nullptr, "RT.REALTIMECORRELATIONFUNCSTART",
+    "RT.PRINTCONTRACTIONTIMING", "QM.ATOMICX2C", "RESPONSE.DISTMATFROMROOT",
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, "MCSCF.RAS1ORBITAL",
+    nullptr, nullptr, nullptr, nullptr, "MOR.REFINE", nullptr, nullptr, nullptr,
+    nullptr, "RESPONSE.MAXITER", nullptr, nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "PERTURB.SOI", nullptr, nullptr, nullptr,
+    "GAUXC.RADIALQUAD", nullptr, nullptr, "INTS.RITHRESHOLD", nullptr, nullptr,
+    nullptr, "MCSCF.RAS3ORBITAL", nullptr, nullptr, "GAUXC.PRUNINGSCHEME", "RT",
+    nullptr, "PERTURB", nullptr, "INTS", nullptr, nullptr, nullptr, nullptr,
+    nullptr, "MCSCF.MAXDAVIDSONSPACE", "RESPONSE.TYPE", nullptr,
+    "MCSCF.SAWEIGHTS", nullptr, nullptr, "SCF.CUBE.MAGANDPHASE", "EOMCC.NROOTS",
+    nullptr, "PERTURB.DOGVVPT", nullptr, nullptr, "INTS.GAUGE",
+    "PERTURB.DOITER", "EOMCC.DAVIDSONMAXMACROITER", nullptr, nullptr, nullptr,
+    "PERTURB.DOFULL", "RT.SAVEONEPDM", "DYNAMICS.PERT_VALUE_X", "PINTS.LIBCINT",
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    nullptr, "PERTURB.FROZENCORE", nullptr, "SCF.ALG", nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr, "RT.RESTARTFROM", "INTS.ALG",
+    "DYNAMICS.PERT_VALUE_Y", nullptr, nullptr, nullptr, nullptr, nullptr,
+    "DYNAMICS.NNUCPGRAD", nullptr, nullptr, nullptr, nullptr,
+    "EOMCC.DAVIDSONCONVONGRAMSCHMIDT", nullptr, nullptr, nullptr,
+    "QM.SPINORBITSCALING", nullptr, nullptr, nullptr, nullptr, nullptr,
+    "SCF.NRLEVELSHIFT", nullptr, nullptr, nullptr, "QM.X2CTYPE", nullptr,
+    nullptr, nullptr, "RT.UNITS", "MCSCF.JOBTYPE", "CC", "SCF.DAMPERROR",
+    "PINTS.SSSS", nullptr, nullptr, "PINTS.BREIT", nullptr, "MISC.NSMP",
+    nullptr, nullptr, "MCSCF.CUBE", nullptr, nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr, nullptr, "RESPONSE.TDA", nullptr,
+    nullptr, nullptr, nullptr, nullptr, "DFTINT.INHOUSE", "RT.MAXSTEPS",
+    "MOLECULE.GEOM", nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    "EOMCC.DAVIDSONCHECKEVAL", nullptr, "PINTS.BARECOULOMB",
+    "EOMCC.OSCILLATORSTRENGTH", "MISC.MEM", nullptr, nullptr, "SCF.DIIS",
+    "EOMCC.DAVIDSONCHECKEVEC", nullptr, "PBASIS.BASISTYPE", "DYNAMICS.DELTAT",
+    nullptr, "RT.RTPRINTDEN", nullptr, nullptr, "MCSCF.CUBE.PADDING", nullptr,
+    nullptr, "DYNAMICS.INIT_PERT", nullptr, "QM.SNSOTYPE", nullptr, nullptr,
+    "PINTS.LLLL", nullptr, nullptr, "PINTS.RIREPORTERROR", nullptr,
+    "DYNAMICS.SAVEALLGEOMETRY", nullptr, nullptr, nullptr, nullptr, nullptr,
+    "PINTS.ALG", nullptr, nullptr, nullptr, "INTS.RIMINSHRINK", nullptr,
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    "MOLECULE", nullptr, "PINTS.SCHWARZ", nullptr, nullptr, nullptr, nullptr,
+    nullptr, "MCSCF.GENIVO", nullptr, nullptr, nullptr, nullptr, nullptr,
+    "INTS.FINITENUCLEI", nullptr, nullptr, nullptr, "RT.RESTARTSTEP",
+    "MCSCF.FVORBITAL", nullptr, nullptr, "SCF.SWITCH", nullptr, nullptr,
+    "RESPONSE.PPSPINMAT", "BASIS.BASISTYPE", nullptr, nullptr, "INTS.BREIT",
+    nullptr, nullptr, "MCSCF.CIDIAGALG", nullptr, "EOMCC.DAVIDSONRESIDUALCONV",
+    nullptr, nullptr, "MISC.TIMERUNIT", nullptr, nullptr, "MCSCF.CUBE.POINTS",
+    nullptr, nullptr, nullptr, "EOMCC.SAVEHAMILTONIAN", nullptr,
+    "MCSCF.HESSDIAGSCALE", "SCF.CUBE.RES", nullptr, nullptr, nullptr,
+    "RT.PROT_INTALG", "DYNAMICS.TMAX", nullptr, "EOMCC.DAVIDSONRCHECKESIDUAL",
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    "QM.NUCREFERENCE", nullptr, nullptr, nullptr, "SCF.CUBE.POINTS", nullptr,
+    "RT.INTALG", nullptr, nullptr, nullptr, nullptr, nullptr, "RT.TMAX",
+    nullptr, "MCSCF.NACTO", nullptr, "MCSCF.PRINTMULT", "GAUXC.INTKERNEL",
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    "MCSCF.SCFGRADCONV", nullptr, nullptr, "EOMCC.DAVIDSONEVALCONV",
+    "MCSCF.OSCISTREN", nullptr, "PINTS.RIMINSHRINK", nullptr, nullptr,
+    "RT.PRINTDEN", nullptr, nullptr, "MCSCF.CASORBITAL", nullptr,
+    "MCSCF.ROTATENEGORBS", "DYNAMICS.RESTART", nullptr, nullptr, nullptr,
+    nullptr, nullptr, "MCSCF.INORBITAL", nullptr, nullptr, nullptr, nullptr,
+    "INTS.GRADALG", nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, "RESPONSE", nullptr, nullptr, nullptr,
+    "RESPONSE.PPTDAMAT", nullptr, nullptr, "MISC.DEBUGTIMING", nullptr, nullptr,
+    nullptr, nullptr,
+};
+
+constexpr uint32_t hash(uint32_t seed, std::string_view key) {
+  uint32_t h = 2166136261u ^ seed;
+  for (char c : key) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 16777619u;
+  }
+  return h;
+}
+
+// True for a validated section name or a known SECTION.KEYWORD pair
+inline bool contains(std::string_view key) {
+  const uint16_t seed = DISPLACEMENT[hash(0, key) % BUCKETS];
+  const char *slot = TABLE[hash(seed, key) % SLOTS];
+  return slot && key == slot;
+}
+
+} // namespace schema
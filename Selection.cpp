@@ -0,0 +1,393 @@
+#include "Selection.hpp"
+#include "Elements.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+
+// --- Plan nodes ---
+
+enum class NodeType {
+  ALL, NONE, NOT, AND, OR, ELEMENT, INDEX, COMPARE, WITHIN, FRAGMENT
+};
+
+enum class CompareOp { LT, LE, GT, GE, EQ, NE };
+
+struct Selection::Node {
+  NodeType type;
+  std::vector<std::shared_ptr<Node>> children;
+  std::vector<bool> elements;                     ///< ELEMENT: indexed by Z
+  std::vector<std::pair<size_t, size_t>> ranges;  ///< INDEX: 0-based, closed
+  int axis = 0;                                   ///< COMPARE: 0/1/2 = x/y/z
+  CompareOp op = CompareOp::LT;
+  double value = 0.0; ///< COMPARE threshold or WITHIN radius
+};
+
+// --- Tokenizer ---
+
+namespace {
+
+struct Token {
+  enum Kind { WORD, NUMBER, RANGE, OP, LPAREN, RPAREN, END } kind;
+  std::string text;
+  double number = 0.0;
+  size_t first = 0, last = 0; // RANGE bounds
+  size_t pos = 0;             // Offset in the expression, for errors
+};
+
+std::vector<Token> tokenize(const std::string &s) {
+  std::vector<Token> tokens;
+  size_t i = 0;
+  while (i < s.size()) {
+    char c = s[i];
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      ++i;
+      continue;
+    }
+    Token t;
+    t.pos = i;
+    if (c == '(' || c == ')') {
+      t.kind = c == '(' ? Token::LPAREN : Token::RPAREN;
+      t.text = c;
+      ++i;
+    } else if (c == '<' || c == '>' || c == '=' || c == '!') {
+      t.kind = Token::OP;
+      t.text = c;
+      ++i;
+      if (i < s.size() && s[i] == '=') {
+        t.text += '=';
+        ++i;
+      }
+    } else if (std::isdigit(static_cast<unsigned char>(c)) || c == '.' ||
+               ((c == '-' || c == '+') && i + 1 < s.size() &&
+                (std::isdigit(static_cast<unsigned char>(s[i + 1])) ||
+                 s[i + 1] == '.'))) {
+      char *end = nullptr;
+      t.kind = Token::NUMBER;
+      t.number = std::strtod(s.c_str() + i, &end);
+      if (end == s.c_str() + i) // ".", "-." or "+." with no digits
+        throw std::runtime_error("Unexpected character '" +
+                                 std::string(1, c) + "' at position " +
+                                 std::to_string(i + 1));
+      size_t next = end - s.c_str();
+      t.text = s.substr(i, next - i);
+      // "3-7" is an atom range, not 3 followed by -7
+      bool integral = t.text.find_first_not_of("0123456789") == std::string::npos;
+      if (integral && next + 1 < s.size() && s[next] == '-' &&
+          std::isdigit(static_cast<unsigned char>(s[next + 1]))) {
+        size_t stop = next + 1;
+        while (stop < s.size() && std::isdigit(static_cast<unsigned char>(s[stop])))
+          ++stop;
+        t.kind = Token::RANGE;
+        t.first = std::stoul(t.text);
+        t.last = std::stoul(s.substr(next + 1, stop - next - 1));
+        t.text = s.substr(i, stop - i);
+        next = stop;
+      }
+      i = next;
+    } else if (std::isalpha(static_cast<unsigned char>(c))) {
+      t.kind = Token::WORD;
+      while (i < s.size() && (std::isalnum(static_cast<unsigned char>(s[i])) ||
+                              s[i] == '_'))
+        t.text += static_cast<char>(std::tolower(static_cast<unsigned char>(s[i++])));
+    } else {
+      throw std::runtime_error("Unexpected character '" + std::string(1, c) +
+                               "' at position " + std::to_string(i + 1));
+    }
+    tokens.push_back(t);
+  }
+  Token end;
+  end.kind = Token::END;
+  end.pos = s.size();
+  tokens.push_back(end);
+  return tokens;
+}
+
+// --- Recursive-descent parser ---
+
+class Parser {
+  const std::vector<Token> &tokens_;
+  size_t at_ = 0;
+
+  using NodePtr = std::shared_ptr<Selection::Node>;
+
+  const Token &peek() const { return tokens_[at_]; }
+  const Token &take() { return tokens_[at_++]; }
+
+  bool accept_word(const char *word) {
+    if (peek().kind == Token::WORD && peek().text == word) {
+      ++at_;
+      return true;
+    }
+    return false;
+  }
+
+  [[noreturn]] void fail(const std::string &what) const {
+    const Token &t = peek();
+    throw std::runtime_error(
+        what + " at position " + std::to_string(t.pos + 1) +
+        (t.kind == Token::END ? " (end of expression)" : " ('" + t.text + "')"));
+  }
+
+  static NodePtr make(NodeType type) {
+    auto node = std::make_shared<Selection::Node>();
+    node->type = type;
+    return node;
+  }
+
+  static bool is_keyword(const std::string &w) {
+    return w == "and" || w == "or" || w == "not";
+  }
+
+  NodePtr parse_or() {
+    NodePtr left = parse_and();
+    while (accept_word("or")) {
+      NodePtr node = make(NodeType::OR);
+      node->children = {left, parse_and()};
+      left = node;
+    }
+    return left;
+  }
+
+  NodePtr parse_and() {
+    NodePtr left = parse_factor();
+    while (accept_word("and")) {
+      NodePtr node = make(NodeType::AND);
+      node->children = {left, parse_factor()};
+      left = node;
+    }
+    return left;
+  }
+
+  NodePtr parse_factor() {
+    if (accept_word("not")) {
+      NodePtr node = make(NodeType::NOT);
+      node->children = {parse_factor()};
+      return node;
+    }
+    if (peek().kind == Token::LPAREN) {
+      take();
+      NodePtr inner = parse_or();
+      if (peek().kind != Token::RPAREN)
+        fail("Expected ')'");
+      take();
+      return inner;
+    }
+    if (accept_word("all"))
+      return make(NodeType::ALL);
+    if (accept_word("none"))
+      return make(NodeType::NONE);
+
+    if (accept_word("element")) {
+      NodePtr node = make(NodeType::ELEMENT);
+      node->elements.assign(elements::MAX_Z + 1, false);
+      int count = 0;
+      while (peek().kind == Token::WORD && !is_keyword(peek().text)) {
+        const std::string &sym = peek().text;
+        uint8_t z = elements::lookup_symbol(sym.data(), sym.size());
+        if (z == 0)
+          break;
+        node->elements[z] = true;
+        take();
+        ++count;
+      }
+      if (count == 0)
+        fail("Expected an element symbol");
+      return node;
+    }
+
+    if (accept_word("index") || accept_word("atom")) {
+      NodePtr node = make(NodeType::INDEX);
+      while (peek().kind == Token::NUMBER || peek().kind == Token::RANGE) {
+        const Token &t = peek();
+        size_t first, last;
+        if (t.kind == Token::RANGE) {
+          first = t.first;
+          last = t.last;
+        } else {
+          if (t.number < 1 || t.number != static_cast<size_t>(t.number))
+            fail("Atom numbers are positive integers");
+          first = last = static_cast<size_t>(t.number);
+        }
+        if (first < 1 || last < first)
+          fail("Invalid atom range");
+        node->ranges.push_back({first - 1, last - 1});
+        take();
+      }
+      if (node->ranges.empty())
+        fail("Expected an atom number or range");
+      return node;
+    }
+
+    if (peek().kind == Token::WORD &&
+        (peek().text == "x" || peek().text == "y" || peek().text == "z")) {
+      NodePtr node = make(NodeType::COMPARE);
+      node->axis = take().text[0] - 'x';
+      if (peek().kind != Token::OP)
+        fail("Expected a comparison operator");
+      const std::string op = take().text;
+      if (op == "<") node->op = CompareOp::LT;
+      else if (op == "<=") node->op = CompareOp::LE;
+      else if (op == ">") node->op = CompareOp::GT;
+      else if (op == ">=") node->op = CompareOp::GE;
+      else if (op == "==" || op == "=") node->op = CompareOp::EQ;
+      else if (op == "!=") node->op = CompareOp::NE;
+      else fail("Unknown comparison operator");
+      if (peek().kind != Token::NUMBER)
+        fail("Expected a number");
+      node->value = take().number;
+      return node;
+    }
+
+    if (accept_word("within")) {
+      NodePtr node = make(NodeType::WITHIN);
+      if (peek().kind != Token::NUMBER || peek().number < 0)
+        fail("Expected a distance");
+      node->value = take().number;
+      if (!accept_word("of"))
+        fail("Expected 'of'");
+      node->children = {parse_factor()};
+      return node;
+    }
+
+    if (accept_word("fragment")) {
+      NodePtr node = make(NodeType::FRAGMENT);
+      if (!accept_word("containing") && !accept_word("of"))
+        fail("Expected 'containing' or 'of'");
+      node->children = {parse_factor()};
+      return node;
+    }
+
+    fail("Unexpected token");
+  }
+
+public:
+  explicit Parser(const std::vector<Token> &tokens) : tokens_(tokens) {}
+
+  NodePtr parse() {
+    NodePtr root = parse_or();
+    if (peek().kind != Token::END)
+      fail("Unexpected token");
+    return root;
+  }
+};
+
+// --- Evaluation ---
+
+struct Context {
+  const std::vector<Atom> &atoms;
+  AtomColumns columns;
+  std::vector<uint32_t> fragments; // Built on first use
+
+  explicit Context(const std::vector<Atom> &a) : atoms(a), columns(a) {}
+};
+
+template <typename Pred>
+void scan_column(const std::vector<double> &col, std::vector<uint8_t> &out,
+                 Pred pred) {
+  for (size_t i = 0; i < col.size(); ++i)
+    out[i] = pred(col[i]) ? 1 : 0;
+}
+
+std::vector<uint8_t> eval(const Selection::Node &node, Context &ctx) {
+  const size_t n = ctx.columns.size();
+  std::vector<uint8_t> out(n, 0);
+
+  switch (node.type) {
+  case NodeType::ALL:
+    std::fill(out.begin(), out.end(), 1);
+    break;
+  case NodeType::NONE:
+    break;
+  case NodeType::NOT:
+    out = eval(*node.children[0], ctx);
+    for (auto &v : out)
+      v = !v;
+    break;
+  case NodeType::AND: {
+    out = eval(*node.children[0], ctx);
+    if (std::find(out.begin(), out.end(), 1) == out.end())
+      break; // Short-circuit: nothing left to intersect
+    std::vector<uint8_t> rhs = eval(*node.children[1], ctx);
+    for (size_t i = 0; i < n; ++i)
+      out[i] &= rhs[i];
+    break;
+  }
+  case NodeType::OR: {
+    out = eval(*node.children[0], ctx);
+    std::vector<uint8_t> rhs = eval(*node.children[1], ctx);
+    for (size_t i = 0; i < n; ++i)
+      out[i] |= rhs[i];
+    break;
+  }
+  case NodeType::ELEMENT:
+    for (size_t i = 0; i < n; ++i)
+      out[i] = node.elements[ctx.columns.element[i]] ? 1 : 0;
+    break;
+  case NodeType::INDEX:
+    for (const auto &r : node.ranges)
+      for (size_t i = r.first; i <= r.second && i < n; ++i)
+        out[i] = 1;
+    break;
+  case NodeType::COMPARE: {
+    const std::vector<double> &col = node.axis == 0   ? ctx.columns.x
+                                     : node.axis == 1 ? ctx.columns.y
+                                                      : ctx.columns.z;
+    const double v = node.value;
+    switch (node.op) {
+    case CompareOp::LT: scan_column(col, out, [v](double c) { return c < v; }); break;
+    case CompareOp::LE: scan_column(col, out, [v](double c) { return c <= v; }); break;
+    case CompareOp::GT: scan_column(col, out, [v](double c) { return c > v; }); break;
+    case CompareOp::GE: scan_column(col, out, [v](double c) { return c >= v; }); break;
+    case CompareOp::EQ: scan_column(col, out, [v](double c) { return c == v; }); break;
+    case CompareOp::NE: scan_column(col, out, [v](double c) { return c != v; }); break;
+    }
+    break;
+  }
+  case NodeType::WITHIN: {
+    std::vector<uint8_t> inner = eval(*node.children[0], ctx);
+    if (std::find(inner.begin(), inner.end(), 1) == inner.end())
+      break;
+    // Expand each inner atom through the cell list instead of testing all
+    // N x |inner| pairs
+    CellList grid(ctx.atoms, std::max(node.value, 0.5));
+    std::vector<uint32_t> hits;
+    for (size_t i = 0; i < n; ++i) {
+      if (!inner[i])
+        continue;
+      grid.query(ctx.columns.x[i], ctx.columns.y[i], ctx.columns.z[i],
+                 node.value, hits, ctx.atoms);
+      for (uint32_t j : hits)
+        out[j] = 1;
+    }
+    break;
+  }
+  case NodeType::FRAGMENT: {
+    std::vector<uint8_t> inner = eval(*node.children[0], ctx);
+    if (ctx.fragments.empty())
+      ctx.fragments = find_fragments(ctx.atoms);
+    std::vector<uint8_t> chosen(n, 0); // Fragment ids are < n
+    for (size_t i = 0; i < n; ++i)
+      if (inner[i])
+        chosen[ctx.fragments[i]] = 1;
+    for (size_t i = 0; i < n; ++i)
+      out[i] = chosen[ctx.fragments[i]];
+    break;
+  }
+  }
+  return out;
+}
+
+} // namespace
+
+Selection::Selection(const std::string &expression) : expression_(expression) {
+  std::vector<Token> tokens = tokenize(expression);
+  root_ = Parser(tokens).parse();
+}
+
+std::vector<uint8_t> Selection::evaluate(const std::vector<Atom> &atoms) const {
+  if (atoms.empty())
+    return {};
+  Context ctx(atoms);
+  return eval(*root_, ctx);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Geometry.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Compiled atom selection expression.
+ *
+ * Grammar (keywords are case-insensitive, atom numbers are 1-based):
+ *
+ *     expr    := term ("or" term)*
+ *     term    := factor ("and" factor)*
+ *     factor  := "not" factor | "(" expr ")" | "all" | "none"
+ *              | "element" SYMBOL+             e.g. element O H
+ *              | ("index" | "atom") RANGE+     e.g. atom 12, index 3-7 9
+ *              | ("x" | "y" | "z") OP NUMBER   OP: < <= > >= == !=
+ *              | "within" NUMBER "of" factor   distance in Angstrom
+ *              | "fragment" ("containing" | "of") factor
+ *
+ * An expression compiles once into a plan whose leaves are column scans over
+ * AtomColumns. Distance clauses query a CellList around the inner selection
+ * instead of comparing all pairs, and fragments come from the bond graph.
+ */
+class Selection {
+
+public:
+  struct Node;
+
+  Selection() = delete;
+
+  // Compiles the expression; throws std::runtime_error on syntax errors
+  explicit Selection(const std::string &expression);
+
+  /**
+   * \brief Evaluate the selection.
+   * \returns One flag per atom (1 = selected)
+   */
+  std::vector<uint8_t> evaluate(const std::vector<Atom> &atoms) const;
+
+  const std::string &expression() const { return expression_; }
+
+private:
+  std::string expression_;
+  std::shared_ptr<Node> root_;
+};
@@ -0,0 +1,582 @@
+#include "Spectrum.hpp"
+#include "Fft.hpp"
+#include "Parallel.hpp"
+#include "TextPlot.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <complex>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+static const double HARTREE_EV = 27.211386245988;
+static const double FS_AU = 41.341374575751; ///< a.u. of time per fs
+static const double END_DAMPING = 1e-3;     ///< Window at the end (FFT)
+static const double END_DAMPING_PADE = 0.1; ///< Window at the end (Padé)
+
+// --- Reading ---
+
+static bool read_file(const std::string &path, std::string &out) {
+  FILE *f = std::fopen(path.c_str(), "rb");
+  if (!f)
+    return false;
+  // Sized up front: dipole files of long runs are tens of MB
+  std::fseek(f, 0, SEEK_END);
+  const long size = std::ftell(f);
+  std::fseek(f, 0, SEEK_SET);
+  out.resize(size > 0 ? size : 0);
+  const bool ok = std::fread(&out[0], 1, out.size(), f) == out.size();
+  std::fclose(f);
+  return ok;
+}
+
+// Split a line at commas, or at whitespace if it has none
+static void split_fields(std::string_view line,
+                         std::vector<std::string_view> &fields) {
+  fields.clear();
+  const bool csv = line.find(',') != std::string_view::npos;
+  size_t i = 0;
+  while (i < line.size()) {
+    if (!csv)
+      while (i < line.size() &&
+             std::isspace(static_cast<unsigned char>(line[i])))
+        ++i;
+    size_t j = i;
+    while (j < line.size() &&
+           (csv ? line[j] != ','
+                : !std::isspace(static_cast<unsigned char>(line[j]))))
+      ++j;
+    std::string_view field = line.substr(i, j - i);
+    while (!field.empty() &&
+           std::isspace(static_cast<unsigned char>(field.front())))
+      field.remove_prefix(1);
+    while (!field.empty() &&
+           std::isspace(static_cast<unsigned char>(field.back())))
+      field.remove_suffix(1);
+    if (csv || !field.empty())
+      fields.push_back(field);
+    i = j + (csv ? 1 : 0);
+    if (csv && j == line.size())
+      break;
+  }
+}
+
+// Numbers of a data row separated by commas or whitespace, in one pass;
+// false if anything else is on the line
+static bool parse_row(std::string_view line, std::vector<double> &row) {
+  row.clear();
+  const char *p = line.data(), *end = p + line.size();
+  auto separator = [](char c) {
+    return c == ',' || c == ' ' || c == '\t' || c == '\r';
+  };
+  for (;;) {
+    while (p < end && separator(*p))
+      ++p;
+    if (p == end)
+      return !row.empty();
+    if (*p == '+')
+      ++p;
+    double value;
+    auto result = std::from_chars(p, end, value);
+    if (result.ec != std::errc() ||
+        (result.ptr < end && !separator(*result.ptr)))
+      return false;
+    row.push_back(value);
+    p = result.ptr;
+  }
+}
+
+// Columns named by a header line; false (and nothing set) if it names no
+// time column
+static bool parse_header(const std::vector<std::string_view> &fields,
+                         int &time_col, double &time_scale,
+                         std::array<int, 3> &dipole_col) {
+  // "Time (AU)" or "Dipole X" split at whitespace: units and axes belong to
+  // the name before them
+  std::vector<std::string> names;
+  for (auto field : fields) {
+    std::string name(field);
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    const bool suffix = !name.empty() && (name.front() == '(' ||
+                                          name == "x" || name == "y" ||
+                                          name == "z");
+    if (!names.empty() && suffix)
+      names.back() += " " + name;
+    else
+      names.push_back(name);
+  }
+  int time = -1, found = 0;
+  std::array<int, 3> dipole{};
+  for (size_t c = 0; c < names.size(); ++c) {
+    if (time < 0 && names[c].find("time") != std::string::npos)
+      time = static_cast<int>(c);
+    else if (found < 3 && names[c].find("dipole") != std::string::npos)
+      dipole[found++] = static_cast<int>(c);
+  }
+  const int n = static_cast<int>(names.size());
+  if (time < 0 || (found < 3 && n < 4))
+    return false;
+  time_col = time;
+  time_scale = names[time].find("fs") != std::string::npos ? FS_AU : 1.0;
+  dipole_col = found == 3 ? dipole : std::array<int, 3>{n - 3, n - 2, n - 1};
+  return true;
+}
+
+bool read_dipole_series(const std::string &path, DipoleSeries &series,
+                        std::string &error) {
+  std::string text;
+  if (!read_file(path, text)) {
+    error = "cannot open file";
+    return false;
+  }
+
+  int time_col = -1;
+  double time_scale = 1.0;
+  std::array<int, 3> dipole_col{};
+  std::vector<double> times;
+  for (auto &d : series.dipole)
+    d.clear();
+
+  std::vector<std::string_view> fields; // Of a header
+  std::vector<double> row;
+  const std::string_view all(text);
+  for (size_t pos = 0; pos < all.size();) {
+    size_t eol = all.find('\n', pos);
+    if (eol == std::string_view::npos)
+      eol = all.size();
+    std::string_view line = all.substr(pos, eol - pos);
+    pos = eol + 1;
+    if (line.empty() || line.front() == '#' || !parse_row(line, row)) {
+      // A header before the data names the columns; other text is skipped
+      if (times.empty()) {
+        if (!line.empty() && line.front() == '#')
+          line.remove_prefix(1);
+        split_fields(line, fields);
+        parse_header(fields, time_col, time_scale, dipole_col);
+      }
+      continue;
+    }
+    if (time_col < 0) {
+      if (row.size() < 4)
+        continue;
+      const int n = static_cast<int>(row.size());
+      time_col = 0;
+      dipole_col = {n - 3, n - 2, n - 1};
+    }
+    if (static_cast<size_t>(std::max({time_col, dipole_col[0], dipole_col[1],
+                                      dipole_col[2]})) >= row.size())
+      continue;
+
+    // A restart repeats steps from its checkpoint: the later rows win
+    const double t = row[time_col] * time_scale;
+    if (!times.empty() && t <= times.back()) {
+      const double half_step =
+          times.size() > 1 ? 0.5 * (times[1] - times[0]) : 0.0;
+      const size_t keep =
+          std::lower_bound(times.begin(), times.end(), t - half_step) -
+          times.begin();
+      times.resize(keep);
+      for (auto &d : series.dipole)
+        d.resize(keep);
+    }
+    times.push_back(t);
+    for (int a = 0; a < 3; ++a)
+      series.dipole[a].push_back(row[dipole_col[a]]);
+  }
+
+  if (times.size() < 2) {
+    error = "fewer than two time steps (expected columns: time, then the "
+            "dipole x y z)";
+    return false;
+  }
+  series.t0 = times.front();
+  series.dt = (times.back() - times.front()) / (times.size() - 1);
+  const double first = times[1] - times[0];
+  for (size_t k = 1; k < times.size(); ++k)
+    if (std::fabs(times[k] - times[k - 1] - first) > 0.01 * first) {
+      char message[128];
+      std::snprintf(message, sizeof(message),
+                    "time step changes at t = %g a.u.; the transform needs a "
+                    "constant step",
+                    times[k - 1]);
+      error = message;
+      return false;
+    }
+  return true;
+}
+
+// --- Transforms ---
+
+static SpectrumMethod resolve_method(SpectrumMethod method, size_t steps) {
+  if (method != SpectrumMethod::AUTO)
+    return method;
+  return steps <= PADE_MAX_STEPS ? SpectrumMethod::PADE : SpectrumMethod::FFT;
+}
+
+// S(ω) = -ω Im Σ c_k exp(-iωkΔt) from a zero-padded FFT, interpolated.
+// The real signal is packed into a complex one of half the length
+// (z_k = c_2k + i c_2k+1) and only the bins up to the highest energy are
+// unpacked, straight from the bit-reversed order.
+static std::vector<double> fft_spectrum(const std::vector<double> &signal,
+                                        double dt,
+                                        const std::vector<double> &energies) {
+  const size_t n = fft_size(2 * signal.size()), half = n / 2;
+  std::vector<std::complex<double>> z(half);
+  for (size_t k = 0; k < signal.size(); ++k)
+    reinterpret_cast<double *>(z.data())[k] = signal[k];
+  fft_forward(z.data(), half, fft_twiddles(half).data());
+
+  const double bin = 2.0 * M_PI / (n * dt);
+  auto value = [&](size_t j) {
+    if (j >= half)
+      return 0.0;
+    // X_j = E_j + exp(-2πij/n) O_j with E, O the transforms of the even
+    // and odd samples, recovered from Z_j and Z_{n/2-j}
+    const std::complex<double> zj = z[fft_bin(j, half)];
+    const std::complex<double> zm =
+        std::conj(z[fft_bin((half - j) % half, half)]);
+    const std::complex<double> even = 0.5 * (zj + zm);
+    const std::complex<double> odd =
+        std::complex<double>(0.0, -0.5) * (zj - zm);
+    const std::complex<double> x =
+        even + std::polar(1.0, -2.0 * M_PI * j / n) * odd;
+    return -(j * bin) * x.imag();
+  };
+  std::vector<double> out(energies.size());
+  size_t cached = SIZE_MAX;
+  double low = 0.0, high = 0.0;
+  for (size_t e = 0; e < energies.size(); ++e) {
+    const double x = energies[e] / bin;
+    const size_t j = static_cast<size_t>(x);
+    if (j != cached) {
+      low = value(j);
+      high = value(j + 1);
+      cached = j;
+    }
+    const double f = x - j;
+    out[e] = (1.0 - f) * low + f * high;
+  }
+  return out;
+}
+
+// Solve Σ_j r[n + i - j] x[j] = y[i] for i, j = 1 .. n (r[1 .. 2n-1]) by
+// Levinson recursion in O(n²), as toeplz of Numerical Recipes; false when a
+// leading minor is singular
+static bool toeplitz_solve(const std::vector<double> &r,
+                           const std::vector<double> &y, size_t n,
+                           std::vector<double> &x) {
+  x.assign(n + 1, 0.0);
+  if (r[n] == 0.0)
+    return false;
+  x[1] = y[1] / r[n];
+  if (n == 1)
+    return true;
+  std::vector<double> g(n + 1), h(n + 1);
+  g[1] = r[n - 1] / r[n];
+  h[1] = r[n + 1] / r[n];
+  for (size_t m = 1; m < n; ++m) {
+    const size_t m1 = m + 1;
+    double sxn = -y[m1], sd = -r[n];
+    for (size_t j = 1; j <= m; ++j) {
+      sxn += r[n + m1 - j] * x[j];
+      sd += r[n + m1 - j] * g[m - j + 1];
+    }
+    if (sd == 0.0)
+      return false;
+    x[m1] = sxn / sd;
+    for (size_t j = 1; j <= m; ++j)
+      x[j] -= x[m1] * g[m - j + 1];
+    if (m1 == n)
+      break;
+    double sgn = -r[n - m1], shn = -r[n + m1], sgd = -r[n];
+    for (size_t j = 1; j <= m; ++j) {
+      sgn += r[n + j - m1] * g[j];
+      shn += r[n + m1 - j] * h[j];
+      sgd += r[n + j - m1] * h[m - j + 1];
+    }
+    if (sgd == 0.0)
+      return false;
+    g[m1] = sgn / sgd;
+    h[m1] = shn / sd;
+    const double pp = g[m1], qq = h[m1];
+    for (size_t j = 1, k = m; j <= (m + 1) / 2; ++j, --k) {
+      const double pt1 = g[j], pt2 = g[k], qt1 = h[j], qt2 = h[k];
+      g[j] = pt1 - pp * qt2;
+      g[k] = pt2 - pp * qt1;
+      h[j] = qt1 - qq * pt2;
+      h[k] = qt2 - qq * pt1;
+    }
+  }
+  return true;
+}
+
+// S(ω) from the [M/M] Padé approximant P(z)/Q(z) of Σ c_k z^k, z = exp(-iωΔt)
+static bool pade_spectrum(const std::vector<double> &c, double dt,
+                          const std::vector<double> &energies,
+                          std::vector<double> &out) {
+  const size_t m = (c.size() - 1) / 2;
+  if (m < 2)
+    return false;
+
+  // Σ_{j=1..M} b_j c_{M+i-j} = -c_{M+i} for i = 1 .. M
+  std::vector<double> y(m + 1), b;
+  for (size_t i = 1; i <= m; ++i)
+    y[i] = -c[m + i];
+  if (!toeplitz_solve(c, y, m, b))
+    return false;
+  b[0] = 1.0;
+
+  // Levinson is not pivoted: accept the solution only if it solves the system
+  double residual = 0.0, norm = 0.0;
+  for (size_t i = 1; i <= m; ++i) {
+    double sum = c[m + i];
+    for (size_t j = 1; j <= m; ++j)
+      sum += c[m + i - j] * b[j];
+    residual += sum * sum;
+    norm += c[m + i] * c[m + i];
+  }
+  if (!std::isfinite(residual) || residual > 1e-8 * norm)
+    return false;
+
+  std::vector<double> a(m + 1, 0.0);
+  for (size_t k = 0; k <= m; ++k)
+    for (size_t j = 0; j <= k; ++j)
+      a[k] += b[j] * c[k - j];
+
+  out.resize(energies.size());
+  for (size_t e = 0; e < energies.size(); ++e) {
+    // Horner with the complex products written out (no NaN/inf checks)
+    const double zr = std::cos(energies[e] * dt);
+    const double zi = -std::sin(energies[e] * dt);
+    double pr = a[m], pi = 0.0, qr = b[m], qi = 0.0;
+    for (size_t k = m; k-- > 0;) {
+      const double pr_next = pr * zr - pi * zi + a[k];
+      const double qr_next = qr * zr - qi * zi + b[k];
+      pi = pr * zi + pi * zr;
+      qi = qr * zi + qi * zr;
+      pr = pr_next;
+      qr = qr_next;
+    }
+    out[e] = -energies[e] * (std::complex<double>(pr, pi) /
+                             std::complex<double>(qr, qi)).imag();
+    if (!std::isfinite(out[e]))
+      return false;
+  }
+  return true;
+}
+
+// Damping rate in a.u. for a series of the given length. By default an FFT
+// input is damped to END_DAMPING so truncation does not ring; Padé
+// approximants do not ring and keep narrower lines at END_DAMPING_PADE.
+static double damping_rate(const SpectrumOptions &options, double duration,
+                           SpectrumMethod method) {
+  if (options.damping > 0)
+    return options.damping / HARTREE_EV;
+  if (duration <= 0)
+    return 0.0;
+  const double decay = -std::log(
+      method == SpectrumMethod::PADE ? END_DAMPING_PADE : END_DAMPING);
+  return options.window == SpectrumWindow::GAUSSIAN
+             ? std::sqrt(2.0 * decay) / duration
+             : decay / duration;
+}
+
+// Dipole change from the first sample times the window
+static std::vector<double> damped_signal(const std::vector<double> &dipole,
+                                         double dt,
+                                         const SpectrumOptions &options,
+                                         SpectrumMethod method) {
+  const size_t n = dipole.size();
+  const double gamma = damping_rate(options, dt * (n - 1), method);
+  std::vector<double> signal(n);
+  for (size_t k = 0; k < n; ++k) {
+    const double gt = gamma * dt * k;
+    double window = 1.0;
+    if (options.window == SpectrumWindow::EXPONENTIAL)
+      window = std::exp(-gt);
+    else if (options.window == SpectrumWindow::GAUSSIAN)
+      window = std::exp(-0.5 * gt * gt);
+    signal[k] = (dipole[k] - dipole[0]) * window;
+  }
+  return signal;
+}
+
+std::vector<double> absorption_spectrum(const std::vector<double> &dipole,
+                                        double dt,
+                                        const std::vector<double> &energies,
+                                        const SpectrumOptions &options,
+                                        SpectrumMethod &used) {
+  used = resolve_method(options.method, dipole.size());
+  std::vector<double> spectrum;
+  if (used == SpectrumMethod::PADE &&
+      pade_spectrum(damped_signal(dipole, dt, options, used), dt, energies,
+                    spectrum))
+    return spectrum;
+  used = SpectrumMethod::FFT;
+  return fft_spectrum(damped_signal(dipole, dt, options, used), dt, energies);
+}
+
+// --- Spectrum mode ---
+
+static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Component of a series that moves most: the kick direction
+static int kicked_axis(const DipoleSeries &series) {
+  int axis = 0;
+  double largest = -1.0;
+  for (int a = 0; a < 3; ++a) {
+    const auto &d = series.dipole[a];
+    double change = 0.0;
+    for (double v : d)
+      change = std::max(change, std::fabs(v - d.front()));
+    if (change > largest) {
+      largest = change;
+      axis = a;
+    }
+  }
+  return axis;
+}
+
+// Indices of the strongest local maxima above 5% of the largest
+static std::vector<size_t> find_peaks(const std::vector<double> &values,
+                                      size_t count) {
+  const double top = *std::max_element(values.begin(), values.end());
+  std::vector<size_t> peaks;
+  for (size_t k = 1; k + 1 < values.size(); ++k)
+    if (values[k] > values[k - 1] && values[k] >= values[k + 1] &&
+        values[k] > 0.05 * top)
+      peaks.push_back(k);
+  std::sort(peaks.begin(), peaks.end(),
+            [&](size_t a, size_t b) { return values[a] > values[b]; });
+  if (peaks.size() > count)
+    peaks.resize(count);
+  std::sort(peaks.begin(), peaks.end());
+  return peaks;
+}
+
+int run_spectrum(const std::vector<std::string> &files,
+                 const SpectrumOptions &options) {
+  const auto start = std::chrono::steady_clock::now();
+  const size_t count = files.size();
+  std::vector<DipoleSeries> series(count);
+  std::vector<std::string> errors(count);
+  std::vector<char> ok(count);
+  parallel_for(count, [&](size_t i) {
+    ok[i] = read_dipole_series(files[i], series[i], errors[i]);
+  });
+  for (size_t i = 0; i < count; ++i)
+    if (!ok[i]) {
+      std::cerr << "Cannot read " << files[i] << ": " << errors[i]
+                << std::endl;
+      return 2;
+    }
+  const double read_ms = elapsed_ms(start);
+
+  // One grid for all polarizations, as fine as the finest FFT
+  std::vector<int> axis(count);
+  double step = options.max_energy / HARTREE_EV /
+                static_cast<double>(std::max<size_t>(options.points, 2));
+  for (size_t i = 0; i < count; ++i) {
+    axis[i] = count == 3 ? static_cast<int>(i) : kicked_axis(series[i]);
+    const size_t steps = series[i].dipole[0].size();
+    if (resolve_method(options.method, steps) == SpectrumMethod::FFT)
+      step = std::min(step,
+                      2.0 * M_PI / (fft_size(2 * steps) * series[i].dt));
+  }
+  const double max_energy = options.max_energy / HARTREE_EV;
+  const size_t n_points = std::min<size_t>(
+      static_cast<size_t>(std::ceil(max_energy / step)) + 1, size_t(1) << 20);
+  std::vector<double> energies(n_points);
+  for (size_t e = 0; e < n_points; ++e)
+    energies[e] = e * step;
+
+  std::vector<std::vector<double>> spectra(count);
+  std::vector<SpectrumMethod> used(count);
+  parallel_for(count, [&](size_t i) {
+    spectra[i] = absorption_spectrum(series[i].dipole[axis[i]], series[i].dt,
+                                     energies, options, used[i]);
+    // A kick along -x gives the same spectrum upside down
+    auto extreme = std::minmax_element(spectra[i].begin(), spectra[i].end());
+    if (-*extreme.first > *extreme.second)
+      for (double &v : spectra[i])
+        v = -v;
+  });
+
+  std::vector<double> total(n_points, 0.0);
+  for (const auto &spectrum : spectra)
+    for (size_t e = 0; e < n_points; ++e)
+      total[e] += spectrum[e] / count;
+  const double top = *std::max_element(total.begin(), total.end());
+  const double scale = top > 0 ? 1.0 / top : 1.0;
+  for (double &v : total)
+    v *= scale;
+  for (auto &spectrum : spectra)
+    for (double &v : spectrum)
+      v *= scale;
+
+  // Summary, plot and peaks
+  static const char AXES[] = "xyz";
+  for (size_t i = 0; i < count; ++i)
+    std::fprintf(stderr, "%c: %s (%zu steps, dt %.4g a.u., %s)\n",
+                 AXES[axis[i]], files[i].c_str(), series[i].dipole[0].size(),
+                 series[i].dt,
+                 used[i] == SpectrumMethod::PADE ? "Pade" : "FFT");
+
+  struct winsize ws {};
+  int columns = 80;
+  if (ioctl(STDERR_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 0)
+    columns = ws.ws_col;
+  const int width = std::max(std::min(columns, 120) - 10, 20);
+  // Largest value under each dot column, so narrow lines are not skipped
+  std::vector<double> columns_max(2 * width, 0.0);
+  for (size_t e = 0; e < n_points; ++e) {
+    const size_t x = e * columns_max.size() / n_points;
+    columns_max[x] = std::max(columns_max[x], total[e]);
+  }
+  std::fprintf(stderr, "\nAbsorption (arbitrary units)\n");
+  for (const auto &line : plot_series(columns_max, width, 12))
+    std::fprintf(stderr, "%s\n", line.c_str());
+  char right[32];
+  std::snprintf(right, sizeof(right), "%g eV", options.max_energy);
+  std::fprintf(stderr, "%8s0%*s\n", "", width, right);
+
+  std::fprintf(stderr, "\nPeaks (eV): ");
+  for (size_t k : find_peaks(total, 8))
+    std::fprintf(stderr, " %.3f (%.2f)", energies[k] * HARTREE_EV, total[k]);
+  std::fprintf(stderr, "\n%zu points in %.1f ms (%.1f ms reading)\n", n_points,
+               elapsed_ms(start), read_ms);
+
+  // Table for scripts and plotting tools
+  if (!isatty(STDOUT_FILENO)) {
+    std::string out = "# energy_eV total";
+    for (size_t i = 0; i < count; ++i) {
+      out += ' ';
+      out += AXES[axis[i]];
+    }
+    out += '\n';
+    char buf[64];
+    for (size_t e = 0; e < n_points; ++e) {
+      std::snprintf(buf, sizeof(buf), "%.6f %.6e", energies[e] * HARTREE_EV,
+                    total[e]);
+      out += buf;
+      for (size_t i = 0; i < count; ++i) {
+        std::snprintf(buf, sizeof(buf), " %.6e", spectra[i][e]);
+        out += buf;
+      }
+      out += '\n';
+    }
+    std::fwrite(out.data(), 1, out.size(), stdout);
+  }
+  return 0;
+}
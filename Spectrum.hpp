@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Induced dipole of one real-time run, sampled at a constant step
+struct DipoleSeries {
+  double t0 = 0.0; ///< Time of the first sample (a.u.)
+  double dt = 0.0; ///< Time step (a.u.)
+  std::array<std::vector<double>, 3> dipole; ///< x, y, z (a.u.)
+};
+
+enum class SpectrumWindow {
+  NONE,
+  EXPONENTIAL, ///< exp(-γt): Lorentzian lines
+  GAUSSIAN,    ///< exp(-(γt)²/2): Gaussian lines
+};
+
+enum class SpectrumMethod {
+  AUTO, ///< Padé up to PADE_MAX_STEPS, FFT beyond
+  FFT,
+  PADE,
+};
+
+struct SpectrumOptions {
+  SpectrumWindow window = SpectrumWindow::EXPONENTIAL;
+  SpectrumMethod method = SpectrumMethod::AUTO;
+  double max_energy = 30.0; ///< eV
+  double damping = 0.0;     ///< γ in eV; 0 picks one from the run length
+  size_t points = 2000;     ///< Energies up to max_energy (at least)
+};
+
+// Longest series AUTO transforms with Padé approximants (O(N²) solve)
+constexpr size_t PADE_MAX_STEPS = 10000;
+
+/**
+ * \brief Read the dipole time series a real-time job wrote as a CSV or
+ *        whitespace-separated table.
+ *
+ * With a header, the column named "time" (fs when the name says so, a.u.
+ * otherwise) and the first three columns naming "dipole" are used; without
+ * one, the first column is the time and the last three the dipole. Rows that
+ * go back in time (a restart repeating steps) replace the earlier ones.
+ *
+ * \returns false with `error` set if the file cannot be read, has fewer than
+ *          two steps or a step that is not constant
+ */
+bool read_dipole_series(const std::string &path, DipoleSeries &series,
+                        std::string &error);
+
+/**
+ * \brief Absorption spectrum ω Im α(ω) of one polarization, up to a constant
+ *        factor, after a delta-kick.
+ *
+ * The dipole change from the first sample is damped by the window and
+ * transformed either by a zero-padded FFT (interpolated onto `energies`) or by
+ * Padé approximants after Bruner et al., JCTC 12, 3741 (2016), which resolve
+ * lines far below 2π/T from short runs.
+ *
+ * \param [in]  energies Output grid in hartree, ascending from 0
+ * \param [out] used     Method actually applied (Padé falls back to FFT when
+ *                       its Toeplitz solve fails)
+ */
+std::vector<double> absorption_spectrum(const std::vector<double> &dipole,
+                                        double dt,
+                                        const std::vector<double> &energies,
+                                        const SpectrumOptions &options,
+                                        SpectrumMethod &used);
+
+/**
+ * \brief Transform the dipole files of a real-time job and plot the spectrum.
+ *
+ * Three files are taken as kicks along x, y and z (in that order) and their
+ * diagonal responses averaged; any other count uses the component of each
+ * file that changes most. Files are transformed on separate threads. The
+ * plot and strongest peaks go to stderr, and when stdout is not a terminal
+ * the spectrum is written to it as a table.
+ *
+ * \returns Exit status: 0 on success, 2 if a file cannot be read
+ */
+int run_spectrum(const std::vector<std::string> &files,
+                 const SpectrumOptions &options);
@@ -0,0 +1,253 @@
+#include "TextPlot.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+BrailleCanvas::BrailleCanvas(int width, int height)
+    : width_(std::max(width, 1)), height_(std::max(height, 1)),
+      dots_(static_cast<size_t>(dots_x()) * dots_y(), 0) {}
+
+void BrailleCanvas::set(int x, int y, uint8_t ink) {
+  if (x >= 0 && x < dots_x() && y >= 0 && y < dots_y())
+    dots_[static_cast<size_t>(y) * dots_x() + x] = ink;
+}
+
+void BrailleCanvas::line(int x0, int y0, int x1, int y1, uint8_t ink) {
+  // Bresenham
+  const int dx = std::abs(x1 - x0), dy = -std::abs(y1 - y0);
+  const int sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+  for (int err = dx + dy;;) {
+    set(x0, y0, ink);
+    if (x0 == x1 && y0 == y1)
+      break;
+    const int e2 = 2 * err;
+    if (e2 >= dy) {
+      err += dy;
+      x0 += sx;
+    }
+    if (e2 <= dx) {
+      err += dx;
+      y0 += sy;
+    }
+  }
+}
+
+std::string BrailleCanvas::row(int r,
+                               const std::vector<std::string> *colors) const {
+  // Dot (column, row) of a cell -> bit of U+2800 + bits
+  static const unsigned BIT[4][2] = {
+      {0x01, 0x08}, {0x02, 0x10}, {0x04, 0x20}, {0x40, 0x80}};
+  std::string out;
+  out.reserve(3 * width_);
+  uint8_t current = 0; // Color in effect, 0 for the default
+  for (int cx = 0; cx < width_; ++cx) {
+    unsigned bits = 0;
+    uint8_t ink = 0;
+    for (int dy = 0; dy < 4; ++dy)
+      for (int dx = 0; dx < 2; ++dx)
+        if (uint8_t d = dots_[static_cast<size_t>(r * 4 + dy) * dots_x() +
+                              cx * 2 + dx]) {
+          bits |= BIT[dy][dx];
+          ink = std::max(ink, d);
+        }
+    // Blank cells keep the current color: only dots show it
+    if (colors && ink > 0 && ink != current) {
+      if (ink <= colors->size()) {
+        out += (*colors)[ink - 1];
+        current = ink;
+      } else if (current) {
+        out += "\033[0m";
+        current = 0;
+      }
+    }
+    const unsigned cp = 0x2800 + bits;
+    out += static_cast<char>(0xE0 | (cp >> 12));
+    out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (cp & 0x3F));
+  }
+  if (current)
+    out += "\033[0m";
+  return out;
+}
+
+// --- Plots ---
+
+// Canvas rows behind an axis carrying the top and bottom values, each
+// right-aligned in `label_width` characters (7 columns with the default)
+static std::vector<std::string>
+framed(const BrailleCanvas &canvas, int height, const char *top,
+       const char *bottom, const std::vector<std::string> *colors = nullptr,
+       int label_width = 5) {
+  std::vector<std::string> lines;
+  for (int r = 0; r < height; ++r) {
+    char label[16];
+    std::snprintf(label, sizeof(label), "%*s ", label_width,
+                  r == 0 ? top : r == height - 1 ? bottom : "");
+    std::string line = label;
+    line += r == 0 ? "┐" : r == height - 1 ? "┘" : "│";
+    line += canvas.row(r, colors);
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+// Columns of a series of n points across `dots` dot columns
+static int column_of(size_t i, size_t n, int dots) {
+  return n > 1 ? static_cast<int>(i * (dots - 1) / (n - 1)) : 0;
+}
+
+std::vector<std::string> plot_log_series(const std::vector<double> &values,
+                                         int width, int height,
+                                         double threshold) {
+  width = std::max(width, 4);
+  height = std::max(height, 2);
+  BrailleCanvas canvas(width, height);
+
+  // Axis spans whole decades around the data and the threshold
+  double lo = INFINITY, hi = -INFINITY;
+  for (double v : values)
+    if (v > 0) {
+      lo = std::min(lo, std::log10(v));
+      hi = std::max(hi, std::log10(v));
+    }
+  if (!std::isfinite(lo)) {
+    lo = threshold > 0 ? std::log10(threshold) : -8.0;
+    hi = lo;
+  }
+  if (threshold > 0) {
+    lo = std::min(lo, std::log10(threshold));
+    hi = std::max(hi, std::log10(threshold));
+  }
+  lo = std::floor(lo);
+  hi = std::max(std::ceil(hi), lo + 1);
+
+  const int dots_y = canvas.dots_y();
+  auto row_of = [&](double v) {
+    double t = (std::log10(v) - lo) / (hi - lo);
+    return std::clamp(static_cast<int>(std::lround((1.0 - t) * (dots_y - 1))),
+                      0, dots_y - 1);
+  };
+  if (threshold > 0)
+    for (int x = 0; x < canvas.dots_x(); x += 3)
+      canvas.set(x, row_of(threshold));
+
+  int prev_x = -1, prev_y = 0;
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (!(values[i] > 0))
+      continue;
+    const int x = column_of(i, values.size(), canvas.dots_x());
+    const int y = row_of(values[i]);
+    if (prev_x >= 0)
+      canvas.line(prev_x, prev_y, x, y);
+    else
+      canvas.set(x, y);
+    prev_x = x;
+    prev_y = y;
+  }
+
+  char top[16], bottom[16];
+  std::snprintf(top, sizeof(top), "%5.0e", std::pow(10.0, hi));
+  std::snprintf(bottom, sizeof(bottom), "%5.0e", std::pow(10.0, lo));
+  return framed(canvas, height, top, bottom);
+}
+
+std::vector<std::string> plot_series(const std::vector<double> &values,
+                                     int width, int height) {
+  return plot_overlay({values}, width, height, {});
+}
+
+std::vector<std::string>
+plot_overlay(const std::vector<std::vector<double>> &series, int width,
+             int height, const std::vector<std::string> &colors) {
+  width = std::max(width, 4);
+  height = std::max(height, 2);
+  BrailleCanvas canvas(width, height);
+
+  double lo = 0.0, hi = 0.0;
+  for (const auto &values : series)
+    for (double v : values)
+      if (std::isfinite(v)) {
+        lo = std::min(lo, v);
+        hi = std::max(hi, v);
+      }
+  if (hi <= lo)
+    hi = lo + 1.0;
+
+  const int dots_y = canvas.dots_y();
+  auto row_of = [&](double v) {
+    double t = (v - lo) / (hi - lo);
+    return std::clamp(static_cast<int>(std::lround((1.0 - t) * (dots_y - 1))),
+                      0, dots_y - 1);
+  };
+  for (size_t s = 0; s < series.size() && s < 255; ++s) {
+    const auto &values = series[s];
+    const uint8_t ink = static_cast<uint8_t>(s + 1);
+    int prev_x = -1, prev_y = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (!std::isfinite(values[i]))
+        continue;
+      const int x = column_of(i, values.size(), canvas.dots_x());
+      const int y = row_of(values[i]);
+      if (prev_x >= 0)
+        canvas.line(prev_x, prev_y, x, y, ink);
+      else
+        canvas.set(x, y, ink);
+      prev_x = x;
+      prev_y = y;
+    }
+  }
+
+  char top[16], bottom[16];
+  // Room for a sign, as in plot_ranges: "-0.012" would push its row right
+  std::snprintf(top, sizeof(top), "%6.2g", hi);
+  std::snprintf(bottom, sizeof(bottom), "%6.2g", lo);
+  return framed(canvas, height, top, bottom,
+                colors.empty() ? nullptr : &colors, 6);
+}
+
+std::vector<std::string> plot_ranges(const std::vector<double> &lo,
+                                     const std::vector<double> &hi, int width,
+                                     int height) {
+  width = std::max(width, 4);
+  height = std::max(height, 2);
+  BrailleCanvas canvas(width, height);
+  const size_t n = std::min(lo.size(), hi.size());
+
+  double bottom = 0.0, top = 0.0;
+  for (size_t i = 0; i < n; ++i)
+    if (std::isfinite(lo[i]) && std::isfinite(hi[i])) {
+      bottom = std::min(bottom, lo[i]);
+      top = std::max(top, hi[i]);
+    }
+  if (top <= bottom)
+    top = bottom + 1.0;
+
+  const int dots_y = canvas.dots_y();
+  auto row_of = [&](double v) {
+    double t = (v - bottom) / (top - bottom);
+    return std::clamp(static_cast<int>(std::lround((1.0 - t) * (dots_y - 1))),
+                      0, dots_y - 1);
+  };
+  // Each column is a vertical bar, joined to the previous one at their
+  // midpoints so sparse data still reads as a line
+  int prev_x = -1, prev_mid = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (!std::isfinite(lo[i]) || !std::isfinite(hi[i]))
+      continue;
+    const int x = column_of(i, n, canvas.dots_x());
+    const int y_hi = row_of(hi[i]), y_lo = row_of(lo[i]);
+    const int mid = (y_hi + y_lo) / 2;
+    canvas.line(x, y_hi, x, y_lo);
+    if (prev_x >= 0)
+      canvas.line(prev_x, prev_mid, x, mid);
+    prev_x = x;
+    prev_mid = mid;
+  }
+
+  char top_label[16], bottom_label[16];
+  // Room for a sign: the range spans 0, so the bottom is often negative
+  std::snprintf(top_label, sizeof(top_label), "%6.2g", top);
+  std::snprintf(bottom_label, sizeof(bottom_label), "%6.2g", bottom);
+  return framed(canvas, height, top_label, bottom_label, nullptr, 6);
+}
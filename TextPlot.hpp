@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Dot canvas printed with braille cells (2 x 4 dots per character),
+ *        for plots in the terminal and the info panel.
+ */
+class BrailleCanvas {
+  int width_, height_;        ///< In characters
+  std::vector<uint8_t> dots_; ///< Row-major ink per dot, 0 for none
+
+public:
+  BrailleCanvas(int width, int height);
+
+  int dots_x() const { return 2 * width_; }
+  int dots_y() const { return 4 * height_; }
+
+  // y = 0 is the top row; dots outside the canvas are ignored. The ink
+  // (1-255) selects the color of the cell when rows are printed in color.
+  void set(int x, int y, uint8_t ink = 1);
+  void line(int x0, int y0, int x1, int y1, uint8_t ink = 1);
+
+  // UTF-8 text of one character row; with `colors`, each cell is drawn in
+  // colors[ink - 1] of its highest ink and the row ends with a reset
+  std::string row(int r,
+                  const std::vector<std::string> *colors = nullptr) const;
+};
+
+/**
+ * \brief Plot a series on a log scale, spread across the width.
+ *
+ * Non-positive and NaN values are skipped. The axis spans whole decades, and
+ * a dotted line marks `threshold` (if positive).
+ *
+ * \returns `height` lines of a 7-column axis label and `width` cells
+ */
+std::vector<std::string> plot_log_series(const std::vector<double> &values,
+                                         int width, int height,
+                                         double threshold);
+
+/**
+ * \brief Plot a series on a linear scale from min(0, values) to the maximum,
+ *        spread across the width.
+ *
+ * \returns `height` lines of an 8-column axis label and `width` cells
+ */
+std::vector<std::string> plot_series(const std::vector<double> &values,
+                                     int width, int height);
+
+/**
+ * \brief Plot several series over each other on one linear scale, series i
+ *        in colors[i] (ANSI escapes; a cell shared by two shows the later).
+ *
+ * \returns `height` lines of an 8-column axis label and `width` cells
+ */
+std::vector<std::string>
+plot_overlay(const std::vector<std::vector<double>> &series, int width,
+             int height, const std::vector<std::string> &colors);
+
+/**
+ * \brief Plot min/max decimated data: column i spans lo[i] to hi[i] on a
+ *        linear scale that includes 0, spread across the width.
+ *
+ * \returns `height` lines of an 8-column axis label and `width` cells
+ */
+std::vector<std::string> plot_ranges(const std::vector<double> &lo,
+                                     const std::vector<double> &hi, int width,
+                                     int height);
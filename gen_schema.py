@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""Generate Schema.hpp from the allowedKeywords lists in input/*.cxx.
+
+Each CQ<NAME>_VALID handler in the vendored ChronusQ sources holds the
+keywords its section accepts. They are collected here and laid out in a
+hash-and-displace perfect hash table, so the linter answers "is SECTION.KEY
+known?" with two hashes and one string compare. The comment after a keyword
+in the list (e.g. "// string: fine, ultrafine, ...") is kept as its doc
+string for the language server's hover text.
+
+Usage: ./gen_schema.py [input_dir] > Schema.hpp
+"""
+
+import glob
+import os
+import re
+import sys
+
+# Sections each handler validates (handlers that take the section as an
+# argument are called for several)
+HANDLER_SECTIONS = {
+    "BASIS": ["BASIS", "PBASIS"],
+    "CUBE": ["SCF.CUBE", "MCSCF.CUBE"],
+    "INTS": ["INTS", "PINTS"],
+}
+
+
+def fnv1a(seed, text):
+    h = (2166136261 ^ seed) & 0xFFFFFFFF
+    for c in text.encode():
+        h ^= c
+        h = (h * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def collect(input_dir):
+    sections, docs = {}, {}
+    handler = re.compile(r"void\s+CQ(\w+)_VALID\s*\(")
+    for path in sorted(glob.glob(os.path.join(input_dir, "*.cxx"))):
+        name, collecting, keywords, notes = None, False, [], {}
+        for line in open(path):
+            code, _, comment = line.partition("//")
+            comment = comment.split("//", 1)[0].strip()
+            m = handler.search(code)
+            if m:
+                name = m.group(1)
+            if "allowedKeywords = {" in code:
+                collecting, keywords = True, []
+                continue
+            if collecting:
+                found = re.findall(r'"([A-Z0-9_]+)"', code)
+                keywords += found
+                if len(found) == 1 and comment:
+                    notes[found[0]] = comment
+                if "};" in code:
+                    collecting = False
+                    for section in HANDLER_SECTIONS.get(name, [name]):
+                        sections[section] = sorted(set(keywords))
+                        docs[section] = dict(notes)
+                    notes = {}
+    return sections, docs
+
+
+def c_string(text):
+    return '"%s"' % text.replace("\\", "\\\\").replace('"', '\\"')
+
+
+def build_table(keys):
+    """Hash-and-displace: bucket by seed 0, then find a seed per bucket
+    (largest buckets first) that sends all of its keys to free slots."""
+    n_buckets = max(1, len(keys) // 4)
+    n_slots = 1
+    while n_slots < 2 * len(keys):
+        n_slots *= 2
+    buckets = [[] for _ in range(n_buckets)]
+    for key in keys:
+        buckets[fnv1a(0, key) % n_buckets].append(key)
+    seeds = [0] * n_buckets
+    slots = [None] * n_slots
+    for b in sorted(range(n_buckets), key=lambda b: -len(buckets[b])):
+        if not buckets[b]:
+            continue
+        for seed in range(1, 1 << 16):
+            pos = [fnv1a(seed, key) % n_slots for key in buckets[b]]
+            if len(set(pos)) == len(pos) and all(slots[p] is None for p in pos):
+                for p, key in zip(pos, buckets[b]):
+                    slots[p] = key
+                seeds[b] = seed
+                break
+        else:
+            sys.exit("no displacement found for bucket %d" % b)
+    return seeds, slots
+
+
+def main():
+    input_dir = sys.argv[1] if len(sys.argv) > 1 else "input"
+    sections, docs = collect(input_dir)
+    # "SCF.CUBE" is both a section and a keyword of SCF
+    keys = sorted(set(sections) | {
+        s + "." + k for s, kws in sections.items() for k in kws})
+    seeds, slots = build_table(keys)
+
+    out = []
+    out.append("#pragma once\n")
+    out.append("// Generated by gen_schema.py from the allowedKeywords lists in")
+    out.append("// input/*.cxx -- do not edit by hand.\n")
+    out.append("#include <cstddef>\n#include <cstdint>\n#include <string_view>\n")
+    out.append("namespace schema {\n")
+    out.append("struct Section {\n  const char *name;\n"
+               "  const char *const *keywords;\n  size_t count;\n"
+               "  const char *const *docs; // Parallel to keywords, \"\" if none\n"
+               "};\n")
+    for name in sorted(sections):
+        ident = "KW_" + name.replace(".", "_")
+        out.append("inline constexpr const char *%s[] = {" % ident)
+        for kw in sections[name]:
+            out.append('    "%s",' % kw)
+        out.append("};")
+        out.append("inline constexpr const char *DOC_%s[] = {" % ident[3:])
+        for kw in sections[name]:
+            out.append("    %s," % c_string(docs[name].get(kw, "")))
+        out.append("};")
+    out.append("\ninline constexpr Section SECTIONS[] = {")
+    for name in sorted(sections):
+        ident = "KW_" + name.replace(".", "_")
+        out.append('    {"%s", %s, sizeof(%s) / sizeof(%s[0]), DOC_%s},'
+                   % (name, ident, ident, ident, ident[3:]))
+    out.append("};\n")
+    out.append("// Section names and SECTION.KEYWORD pairs, %d keys in %d slots"
+               % (len(keys), len(slots)))
+    out.append("constexpr size_t BUCKETS = %d;" % len(seeds))
+    out.append("constexpr size_t SLOTS = %d;\n" % len(slots))
+    out.append("inline constexpr uint16_t DISPLACEMENT[BUCKETS] = {")
+    for i in range(0, len(seeds), 12):
+        out.append("    " + ", ".join(str(s) for s in seeds[i:i + 12]) + ",")
+    out.append("};\n")
+    out.append("inline constexpr const char *TABLE[SLOTS] = {")
+    line = "   "
+    for key in slots:
+        item = ' "%s",' % key if key else " nullptr,"
+        if len(line) + len(item) > 80:
+            out.append(line)
+            line = "   "
+        line += item
+    out.append(line)
+    out.append("};\n")
+    out.append("""constexpr uint32_t hash(uint32_t seed, std::string_view key) {
+  uint32_t h = 2166136261u ^ seed;
+  for (char c : key) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 16777619u;
+  }
+  return h;
+}
+
+// True for a validated section name or a known SECTION.KEYWORD pair
+inline bool contains(std::string_view key) {
+  const uint16_t seed = DISPLACEMENT[hash(0, key) % BUCKETS];
+  const char *slot = TABLE[hash(seed, key) % SLOTS];
+  return slot && key == slot;
+}
+""")
+    out.append("} // namespace schema")
+    print("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -93,7 +93,7 @@ fi
 cd "$SCRIPT_DIR"
 
 # Compile the binary
-g++ -std=c++17 -O2 -o qsee_exe qsee.cpp Input.cpp -lm
+g++ -std=c++17 -O2 -pthread -o qsee_exe qsee.cpp Input.cpp InputFile.cpp Render.cpp Raster.cpp Geometry.cpp GeometryCheck.cpp Octree.cpp Picking.cpp Selection.cpp Labels.cpp Lint.cpp Directive.cpp Estimate.cpp DftGrid.cpp Lsp.cpp Index.cpp ScfMonitor.cpp TextPlot.cpp Fft.cpp Spectrum.cpp Broaden.cpp RtField.cpp Fleet.cpp GeometryLog.cpp -lm
 
 if [[ -f "qsee_exe" ]]; then
     echo -e "${GREEN}  ✓ Compiled successfully${NC}"
@@ -102,6 +102,15 @@ else
     exit 1
 fi
 
+# libqsee: parser and off-screen renderer behind the C API in qsee.h
+LIB_SOURCES="CApi.cpp InputFile.cpp Input.cpp Directive.cpp Estimate.cpp Render.cpp Raster.cpp Geometry.cpp"
+LIB_BUILD="$(mktemp -d)"
+(cd "$LIB_BUILD" && g++ -std=c++17 -O2 -pthread -fPIC -fvisibility=hidden -fvisibility-inlines-hidden -c $(printf "$SCRIPT_DIR/%s " $LIB_SOURCES))
+ar rcs libqsee.a "$LIB_BUILD"/*.o
+g++ -shared -pthread -o libqsee.so "$LIB_BUILD"/*.o
+rm -rf "$LIB_BUILD"
+echo -e "${GREEN}  ✓ Built libqsee.a and libqsee.so${NC}"
+
 # =============================================================================
 # Step 3: Install binary and supporting files to ~/bin/qsee_bin/
 # =============================================================================
@@ -109,11 +118,11 @@ echo -e "${YELLOW}[3/4] Installing to $BIN_DIR...${NC}"
 
 mkdir -p "$BIN_DIR"
 
-# Copy the compiled binary
-cp qsee_exe "$BIN_DIR/"
+# Copy the compiled binary and library
+cp qsee_exe libqsee.a libqsee.so "$BIN_DIR/"
 
 # Copy source files (optional, for reference/recompilation)
-cp qsee.cpp Input.cpp Input.hpp "$BIN_DIR/" 2>/dev/null || true
+cp qsee.cpp Input.cpp Input.hpp InputFile.cpp InputFile.hpp Render.cpp Render.hpp CApi.cpp qsee.h Elements.hpp Raster.cpp Raster.hpp Geometry.cpp Geometry.hpp GeometryCheck.cpp GeometryCheck.hpp Octree.cpp Octree.hpp Picking.cpp Picking.hpp Selection.cpp Selection.hpp Labels.cpp Labels.hpp Lint.cpp Lint.hpp Directive.cpp Directive.hpp Estimate.cpp Estimate.hpp DftGrid.cpp DftGrid.hpp Lsp.cpp Lsp.hpp Index.cpp Index.hpp ScfMonitor.cpp ScfMonitor.hpp TextPlot.cpp TextPlot.hpp Fft.cpp Fft.hpp Spectrum.cpp Spectrum.hpp Broaden.cpp Broaden.hpp RtField.cpp RtField.hpp Fleet.cpp Fleet.hpp GeometryLog.cpp GeometryLog.hpp Schema.hpp Parallel.hpp "$BIN_DIR/" 2>/dev/null || true
 
 echo -e "${GREEN}  ✓ Files installed to $BIN_DIR${NC}"
 
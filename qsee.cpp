@@ -1,73 +1,47 @@
+#include "Broaden.hpp"
+#include "DftGrid.hpp"
+#include "Directive.hpp"
+#include "Elements.hpp"
+#include "Estimate.hpp"
+#include "Fleet.hpp"
+#include "Geometry.hpp"
+#include "GeometryCheck.hpp"
+#include "GeometryLog.hpp"
+#include "Index.hpp"
 #include "Input.hpp"
+#include "InputFile.hpp"
+#include "Labels.hpp"
+#include "Lint.hpp"
+#include "Lsp.hpp"
+#include "Octree.hpp"
+#include "Parallel.hpp"
+#include "Picking.hpp"
+#include "Raster.hpp"
+#include "Render.hpp"
+#include "RtField.hpp"
+#include "ScfMonitor.hpp"
+#include "Selection.hpp"
+#include "Spectrum.hpp"
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <cctype>
 #include <cmath>
 #include <csignal>
 #include <cstdint>
-#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
-#include <sstream>
+#include <memory>
 #include <string>
 #include <thread>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
 #include <unordered_map>
 #include <vector>
 
-// --- Data Structures ---
-struct Atom {
-  std::string element;
-  double x, y, z;
-};
-
-struct Vec3 {
-  double x, y, z;
-};
-
-// Modular input parameter structure (ready for future descriptions)
-struct InputParameter {
-  std::string section;     // e.g., "QM", "BASIS", "SCF"
-  std::string key;         // e.g., "reference", "basis"
-  std::string value;       // e.g., "GBLYP", "6-31G(D)"
-  std::string description; // For future use: explanation of parameter
-};
-
-// Complete input file data
-struct InputFileData {
-  std::string filename;
-  std::string title;         // From comment at top
-  std::string chronusq_line; // The chronusq: directive
-  int charge = 0;
-  int multiplicity = 1;
-  std::vector<Atom> atoms;
-  std::vector<InputParameter> parameters;
-
-  // Get element composition string (e.g., "H5" or "C6H12O6")
-  std::string get_formula() const {
-    std::unordered_map<std::string, int> counts;
-    for (const auto &atom : atoms) {
-      counts[atom.element]++;
-    }
-    // Standard order: C, H, then alphabetical
-    std::string formula;
-    if (counts.count("C")) {
-      formula += "C" + (counts["C"] > 1 ? std::to_string(counts["C"]) : "");
-      counts.erase("C");
-    }
-    if (counts.count("H")) {
-      formula += "H" + (counts["H"] > 1 ? std::to_string(counts["H"]) : "");
-      counts.erase("H");
-    }
-    std::vector<std::string> others;
-    for (const auto &[elem, count] : counts) {
-      others.push_back(elem);
-    }
-    std::sort(others.begin(), others.end());
-    for (const auto &elem : others) {
-      formula += elem + (counts[elem] > 1 ? std::to_string(counts[elem]) : "");
-    }
-    return formula;
-  }
-};
-
 // --- Globals for signal handling ---
 volatile sig_atomic_t running = 1;
 
@@ -94,204 +68,389 @@ std::string base64_encode(const std::vector<uint8_t> &data) {
   return out;
 }
 
-// --- Element colors (RGB) ---
-struct Color {
-  uint8_t r, g, b;
-};
+// Sprite mode bakes occlusion into a few shading levels per element
+const int AO_LEVELS = 4;
 
-Color get_element_color(const std::string &element) {
-  static std::unordered_map<std::string, Color> colors = {
-      {"H", {255, 255, 255}}, // White
-      {"C", {144, 144, 144}}, // Grey
-      {"N", {48, 80, 248}},   // Blue
-      {"O", {255, 13, 13}},   // Red
-      {"S", {255, 255, 48}},  // Yellow
-      {"P", {255, 128, 0}},   // Orange
-      {"F", {144, 224, 80}},  // Green
-      {"Cl", {31, 240, 31}},  // Green
-      {"Br", {166, 41, 41}},  // Brown
-  };
-  auto it = colors.find(element);
-  if (it != colors.end())
-    return it->second;
-  return {200, 200, 200}; // Default grey
+int ao_level(float ao) {
+  return std::min(AO_LEVELS - 1, static_cast<int>(ao * AO_LEVELS));
 }
 
-// --- File parsing ---
-InputFileData parse_inp_file(const std::string &filename) {
-  InputFileData data;
-  data.filename = filename;
-
-  // 1. Manually scan for Title (first meaningful comment)
-  {
-    std::ifstream file(filename);
-    if (file.is_open()) {
-      std::string line;
-      bool found_title = false;
-      while (std::getline(file, line)) {
-        size_t start = line.find_first_not_of(" \t");
-        if (start == std::string::npos)
-          continue;
-        line = line.substr(start);
-
-        if (line[0] == '#') {
-          if (line.length() > 1) {
-            std::string comment = line.substr(1);
-            size_t cstart = comment.find_first_not_of(" \t");
-            if (cstart != std::string::npos) {
-              data.title = comment.substr(cstart);
-              found_title = true;
-              break; // Found it
-            }
-          }
-        } else if (line[0] == '[') {
-          break; // Hit a section, stop looking for title
-        }
+float ao_level_value(int level) { return (level + 0.5f) / AO_LEVELS; }
+
+// --- Per-atom opacity ---
+// SPEC is a comma-separated list of KEY=ALPHA entries, where KEY is either an
+// element symbol ("H=0.3") or a 1-based atom number or range ("1-20=0.2").
+// Later entries override earlier ones.
+bool apply_opacity_spec(const std::string &spec,
+                        const std::vector<Atom> &atoms,
+                        std::vector<float> &opacity) {
+  std::vector<std::string> entries;
+  Input::split(entries, spec, ",");
+  for (auto &entry : entries) {
+    size_t eq = entry.find('=');
+    if (eq == std::string::npos) {
+      std::cerr << "Invalid opacity entry (expected KEY=ALPHA): " << entry
+                << std::endl;
+      return false;
+    }
+    std::string key = entry.substr(0, eq);
+    std::string value = entry.substr(eq + 1);
+    Input::trim(key);
+    Input::trim(value);
+
+    float alpha;
+    try {
+      alpha = std::stof(value);
+    } catch (const std::exception &) {
+      std::cerr << "Invalid opacity value: " << value << std::endl;
+      return false;
+    }
+    alpha = std::min(1.0f, std::max(0.0f, alpha));
+
+    if (!key.empty() && std::isdigit(static_cast<unsigned char>(key[0]))) {
+      size_t dash = key.find('-');
+      size_t first, last;
+      try {
+        first = std::stoul(key.substr(0, dash));
+        last = dash == std::string::npos ? first
+                                         : std::stoul(key.substr(dash + 1));
+      } catch (const std::exception &) {
+        std::cerr << "Invalid atom range: " << key << std::endl;
+        return false;
+      }
+      if (first < 1 || last < first) {
+        std::cerr << "Invalid atom range: " << key << std::endl;
+        return false;
       }
+      for (size_t i = first - 1; i < std::min(last, atoms.size()); ++i)
+        opacity[i] = alpha;
+    } else {
+      uint8_t z = elements::lookup_symbol(key.data(), key.size());
+      if (z == 0) {
+        std::cerr << "Unknown element in opacity spec: " << key << std::endl;
+        return false;
+      }
+      for (size_t i = 0; i < atoms.size(); ++i)
+        if (atoms[i].element == z)
+          opacity[i] = alpha;
     }
   }
+  return true;
+}
 
-  // 2. Use Robust Input Parser
-  try {
-    Input input(filename);
-    input.parse();
-
-    // Retrieve simple properties
-    if (input.containsData("MOLECULE.CHARGE"))
-      data.charge = input.getData<int>("MOLECULE.CHARGE");
-    if (input.containsData("MOLECULE.MULT"))
-      data.multiplicity = input.getData<int>("MOLECULE.MULT");
-
-    // Geometry
-    std::string geom_str;
-    if (input.containsData("MOLECULE.GEOM")) {
-      geom_str = input.getData<std::string>("MOLECULE.GEOM");
-    } else if (input.containsData("GEOMETRY")) { // Fallback/Alternative
-      geom_str = input.getData<std::string>("GEOMETRY");
-    }
-
-    if (!geom_str.empty()) {
-      std::istringstream iss(geom_str);
-      std::string line;
-      while (std::getline(iss, line)) {
-        std::istringstream ls(line);
-        Atom atom;
-        if (ls >> atom.element >> atom.x >> atom.y >> atom.z) {
-          data.atoms.push_back(atom);
-        }
-      }
-    }
+// --- Picked atoms ---
+// Info-panel lines for the current picks: each atom (in input coordinates,
+// i.e. with the centering offset added back) followed by the distance,
+// angle or dihedral they define
+std::vector<std::string> describe_picks(const std::vector<Atom> &atoms,
+                                        const std::vector<uint32_t> &picks,
+                                        const Vec3 &origin) {
+  std::vector<std::string> lines;
+  char buf[128];
+  for (size_t k = 0; k < picks.size(); ++k) {
+    const Atom &a = atoms[picks[k]];
+    std::snprintf(buf, sizeof(buf), "%zu: #%u %-2s %8.4f %8.4f %8.4f", k + 1,
+                  picks[k] + 1, elements::get(a.element).symbol,
+                  a.x + origin.x, a.y + origin.y, a.z + origin.z);
+    lines.push_back(buf);
+  }
+  auto at = [&](size_t k) -> const Atom & { return atoms[picks[k]]; };
+  if (picks.size() >= 2) {
+    std::snprintf(buf, sizeof(buf), "Distance 1-2:     %.4f A",
+                  measure_distance(at(0), at(1)));
+    lines.push_back(buf);
+  }
+  if (picks.size() >= 3) {
+    std::snprintf(buf, sizeof(buf), "Angle 1-2-3:      %.2f deg",
+                  measure_angle(at(0), at(1), at(2)));
+    lines.push_back(buf);
+  }
+  if (picks.size() == 4) {
+    std::snprintf(buf, sizeof(buf), "Dihedral 1-2-3-4: %.2f deg",
+                  measure_dihedral(at(0), at(1), at(2), at(3)));
+    lines.push_back(buf);
+  }
+  return lines;
+}
 
-    // Populate Parameters for Display
-    for (const auto &kv : input.getDict()) {
-      std::string full_key = kv.first;
-      std::string value = kv.second;
+// --- Labels ---
+enum class LabelMode { NONE, INDEX, SYMBOL, BOTH };
 
-      // Skip Geometry blob in parameters list to avoid clutter
-      if (full_key == "MOLECULE.GEOM" || full_key == "GEOMETRY")
-        continue;
+std::string atom_label(const Atom &atom, size_t index, LabelMode mode) {
+  switch (mode) {
+  case LabelMode::INDEX: return std::to_string(index + 1);
+  case LabelMode::SYMBOL: return elements::get(atom.element).symbol;
+  case LabelMode::BOTH:
+    return elements::get(atom.element).symbol + std::to_string(index + 1);
+  default: return "";
+  }
+}
 
-      InputParameter param;
-      size_t dot_pos = full_key.find('.');
-      if (dot_pos != std::string::npos) {
-        param.section = full_key.substr(0, dot_pos);
-        param.key = full_key.substr(dot_pos + 1);
-      } else {
-        param.section = "GLOBAL";
-        param.key = full_key;
-      }
-      param.value = value;
-      data.parameters.push_back(param);
-    }
+/**
+ * \brief Blit atom and measurement labels into a premultiplied frame.
+ *
+ * Pick distances are placed first, then atoms from nearest to farthest. An
+ * atom whose center is already covered by a nearer disc gets no label, and
+ * each label tries the four sides of its atom until it finds a spot that
+ * overlaps neither an earlier label nor a nearer atom.
+ *
+ * \param [in] near_to_far Drawn atoms ordered from the viewer outward
+ * \returns True if anything was drawn
+ */
+bool draw_labels(std::vector<uint8_t> &rgba, int width, int height,
+                 const GlyphAtlas &atlas, OccupancyGrid &occupancy,
+                 const std::vector<Atom> &atoms, const ViewTransform &view,
+                 const std::vector<uint32_t> &near_to_far,
+                 const std::vector<uint32_t> &picks, LabelMode mode,
+                 int atom_radius) {
+  const Color text_color = {235, 235, 235};
+  const Color measure_color = {255, 215, 0};
+  const int h = atlas.line_height();
+  bool drawn = false;
+  occupancy.reset(width, height);
+
+  auto try_place = [&](int x, int y, const std::string &text,
+                       const Color &color) {
+    const int w = atlas.text_width(text);
+    if (x < 0 || y < 0 || x + w > width || y + h > height ||
+        !occupancy.is_free(x, y, x + w, y + h,
+                           OccupancyGrid::LABEL | OccupancyGrid::DISC))
+      return false;
+    occupancy.mark(x, y, x + w, y + h, OccupancyGrid::LABEL);
+    atlas.draw(rgba, width, height, x, y, text, color);
+    drawn = true;
+    return true;
+  };
 
-  } catch (const std::exception &e) {
-    std::cerr << "Parser Error: " << e.what() << std::endl;
+  char buf[32];
+  for (size_t k = 1; k < picks.size(); ++k) {
+    const Atom &a = atoms[picks[k - 1]], &b = atoms[picks[k]];
+    Vec3 pa = view.project(a.x, a.y, a.z), pb = view.project(b.x, b.y, b.z);
+    std::snprintf(buf, sizeof(buf), "%.2f", measure_distance(a, b));
+    const int w = atlas.text_width(buf);
+    const int mx = (int)std::lround((pa.x + pb.x) / 2) - w / 2;
+    const int my = (int)std::lround((pa.y + pb.y) / 2) - h / 2;
+    if (!try_place(mx, my, buf, measure_color))
+      try_place(mx, my - h, buf, measure_color);
   }
 
-  return data;
+  if (mode == LabelMode::NONE)
+    return drawn;
+
+  // Discs are marked by their inscribed square so labels may graze edges
+  const int r = atom_radius, inner = (int)(atom_radius * 0.7);
+  for (uint32_t i : near_to_far) {
+    const Atom &atom = atoms[i];
+    Vec3 p = view.project(atom.x, atom.y, atom.z);
+    const int x = (int)std::lround(p.x), y = (int)std::lround(p.y);
+    if (!occupancy.is_free(x, y, x + 1, y + 1, OccupancyGrid::DISC))
+      continue; // Hidden behind a nearer atom
+
+    const std::string text = atom_label(atom, i, mode);
+    const int w = atlas.text_width(text);
+    try_place(x + r + 1, y - h / 2, text, text_color) ||
+        try_place(x - r - 1 - w, y - h / 2, text, text_color) ||
+        try_place(x - w / 2, y - r - 1 - h, text, text_color) ||
+        try_place(x - w / 2, y + r + 1, text, text_color);
+    occupancy.mark(x - inner, y - inner, x + inner + 1, y + inner + 1,
+                   OccupancyGrid::DISC);
+  }
+  return drawn;
 }
 
-// --- 3D Math ---
-Vec3 rotate_x(const Vec3 &v, double angle) {
-  double c = std::cos(angle);
-  double s = std::sin(angle);
-  return {v.x, v.y * c - v.z * s, v.y * s + v.z * c};
+// --- External fields ---
+/**
+ * \brief Parse the [RT] FIELD block of an input and describe it for the info
+ *        panel, sampled over MAXSTEPS x DELTAT (or TMAX / DELTAT steps).
+ *
+ * \param [out] fields The fields that could be read
+ */
+std::vector<std::string> describe_field(const InputFileData &data, int width,
+                                        std::vector<RtField> &fields) {
+  const std::string value = data.get_parameter("RT", "FIELD");
+  if (value.empty())
+    return {};
+  std::vector<std::string> errors;
+  fields = parse_rt_fields(value, errors);
+
+  const double dt = std::atof(data.get_parameter("RT", "DELTAT").c_str());
+  double steps = std::atof(data.get_parameter("RT", "MAXSTEPS").c_str());
+  if (steps <= 0 && dt > 0)
+    steps = std::floor(
+        (std::atof(data.get_parameter("RT", "TMAX").c_str()) + dt / 4) / dt);
+  std::vector<std::string> lines;
+  for (const auto &error : errors)
+    lines.push_back("! " + error);
+  for (const auto &line : describe_rt_fields(fields, dt,
+                                             (size_t)std::max(steps, 0.0),
+                                             width))
+    lines.push_back(line);
+  return lines;
 }
 
-Vec3 rotate_y(const Vec3 &v, double angle) {
-  double c = std::cos(angle);
-  double s = std::sin(angle);
-  return {v.x * c + v.z * s, v.y, -v.x * s + v.z * c};
+/**
+ * \brief Draw the polarization of each field as an arrow from the molecule's
+ *        center; one pointing along the view axis is a ring with a dot
+ *        (towards the viewer) or a cross (away).
+ */
+void draw_field_arrows(std::vector<uint8_t> &rgba, int width, int height,
+                       const ViewTransform &view,
+                       const std::vector<RtField> &fields, double length,
+                       double thickness) {
+  const Color color = {230, 80, 230};
+  const Vec3 c = view.project(0, 0, 0);
+  for (const RtField &f : fields) {
+    const auto &a = f.amplitude;
+    const double norm = std::sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+    if (norm == 0.0)
+      continue;
+    const Vec3 r = view.rotate(a[0] / norm, a[1] / norm, a[2] / norm);
+    const double dx = r.x * length, dy = -r.y * length;
+    const double shown = std::sqrt(dx * dx + dy * dy);
+    const double head = std::min(0.3 * shown, 6.0 * thickness);
+    if (shown < 2.0 * head || shown < 4.0 * thickness) {
+      const double ring = 4.0 * thickness;
+      draw_circle_outline_aa(rgba, width, height, c.x, c.y, ring, color,
+                             thickness);
+      if (r.z > 0) {
+        draw_line_aa(rgba, width, height, c.x, c.y, c.x, c.y, color,
+                     1.5 * thickness);
+      } else {
+        const double d = ring * 0.7;
+        draw_line_aa(rgba, width, height, c.x - d, c.y - d, c.x + d, c.y + d,
+                     color, thickness);
+        draw_line_aa(rgba, width, height, c.x - d, c.y + d, c.x + d, c.y - d,
+                     color, thickness);
+      }
+      continue;
+    }
+    const double tx = c.x + dx, ty = c.y + dy;
+    const double ux = -dx / shown, uy = -dy / shown; // Back along the shaft
+    draw_line_aa(rgba, width, height, c.x, c.y, tx, ty, color, thickness);
+    for (double side : {-1.0, 1.0}) {
+      const double cs = std::cos(0.45), sn = side * std::sin(0.45);
+      draw_line_aa(rgba, width, height, tx, ty,
+                   tx + head * (ux * cs - uy * sn),
+                   ty + head * (ux * sn + uy * cs), color, thickness);
+    }
+  }
 }
 
-Vec3 rotate_z(const Vec3 &v, double angle) {
-  double c = std::cos(angle);
-  double s = std::sin(angle);
-  return {v.x * c - v.y * s, v.x * s + v.y * c, v.z};
+// --- Keyboard input ---
+// Non-canonical, no-echo input so keys act immediately. ISIG stays on, so
+// Ctrl+C still raises SIGINT.
+struct termios saved_termios;
+bool raw_input = false;
+
+void enable_raw_input() {
+  if (!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &saved_termios) != 0)
+    return;
+  struct termios raw = saved_termios;
+  raw.c_lflag &= ~(ICANON | ECHO);
+  raw.c_cc[VMIN] = 0; // read() returns immediately when nothing is pending
+  raw.c_cc[VTIME] = 0;
+  raw_input = tcsetattr(STDIN_FILENO, TCSANOW, &raw) == 0;
 }
 
-// Camera view modes
-enum class ViewMode { ISOMETRIC, XY, XZ, YZ };
-
-// Apply initial camera rotation based on view mode
-Vec3 apply_camera_view(const Vec3 &v, ViewMode mode) {
-  switch (mode) {
-  case ViewMode::XY:
-    // Looking down Z-axis (no rotation needed)
-    return v;
-  case ViewMode::XZ:
-    // Looking down Y-axis (rotate -90° around X)
-    return rotate_x(v, -M_PI / 2.0);
-  case ViewMode::YZ:
-    // Looking down X-axis (rotate 90° around Y)
-    return rotate_y(v, M_PI / 2.0);
-  case ViewMode::ISOMETRIC:
-  default:
-    // 3/4 view: rotate to see from (1, 1, 1) direction
-    // First tilt down ~35.26° (arctan(1/√2)), then rotate 45° around Y
-    Vec3 tilted = rotate_x(v, -M_PI / 5.5); // ~32° down tilt
-    return rotate_y(tilted, M_PI / 4.0);    // 45° Y rotation
-  }
+void restore_input() {
+  if (raw_input)
+    tcsetattr(STDIN_FILENO, TCSANOW, &saved_termios);
+  raw_input = false;
 }
 
-// --- Circle drawing (Bresenham's algorithm) ---
-void draw_circle_outline(std::vector<uint8_t> &rgba, int width, int height,
-                         int cx, int cy, int radius, const Color &color) {
-  auto set_pixel = [&](int x, int y) {
-    if (x >= 0 && x < width && y >= 0 && y < height) {
-      int idx = (y * width + x) * 4;
-      rgba[idx] = color.r;
-      rgba[idx + 1] = color.g;
-      rgba[idx + 2] = color.b;
-      rgba[idx + 3] = 255;
-    }
-  };
+enum class Key {
+  UP, DOWN, LEFT, RIGHT, ZOOM_IN, ZOOM_OUT, RESET, QUIT,
+  CLICK,      // Left mouse button press at (x, y)
+  CLEAR_PICKS // Right click or 'c'
+};
 
-  // Draw 8 symmetric points
-  auto plot_circle_points = [&](int x, int y) {
-    set_pixel(cx + x, cy + y);
-    set_pixel(cx - x, cy + y);
-    set_pixel(cx + x, cy - y);
-    set_pixel(cx - x, cy - y);
-    set_pixel(cx + y, cy + x);
-    set_pixel(cx - y, cy + x);
-    set_pixel(cx + y, cy - x);
-    set_pixel(cx - y, cy - x);
-  };
+struct InputEvent {
+  Key key;
+  int x = 0, y = 0; // Mouse position (1-based cells, or pixels in 1016 mode)
+};
 
-  int x = 0, y = radius;
-  int d = 3 - 2 * radius;
+// Set once the terminal confirms SGR-pixel mouse reporting (mode 1016)
+bool mouse_pixels = false;
 
-  while (x <= y) {
-    plot_circle_points(x, y);
-    if (d < 0) {
-      d = d + 4 * x + 6;
-    } else {
-      d = d + 4 * (x - y) + 10;
-      y--;
+// SGR mouse reports (1006) with pixel coordinates where supported (1016).
+// The DECRQM query at the end makes the terminal report whether 1016 took.
+void enable_mouse() {
+  std::cout << "\033[?1000h\033[?1006h\033[?1016h\033[?1016$p" << std::flush;
+}
+
+void disable_mouse() {
+  std::cout << "\033[?1016l\033[?1006l\033[?1000l" << std::flush;
+}
+
+// Drain all pending input without blocking
+std::vector<InputEvent> read_input() {
+  std::vector<InputEvent> events;
+  if (!raw_input)
+    return events;
+  std::string in;
+  char buf[256];
+  ssize_t n;
+  while ((n = read(STDIN_FILENO, buf, sizeof(buf))) > 0)
+    in.append(buf, n);
+
+  for (size_t i = 0; i < in.size(); ++i) {
+    if (in[i] == '\033' && i + 2 < in.size() && in[i + 1] == '[') {
+      // SGR mouse: ESC [ < button ; x ; y (M = press, m = release)
+      if (in[i + 2] == '<') {
+        size_t end = in.find_first_of("Mm", i + 3);
+        if (end == std::string::npos)
+          break;
+        int button = 0, x = 0, y = 0;
+        if (std::sscanf(in.c_str() + i + 3, "%d;%d;%d", &button, &x, &y) ==
+                3 &&
+            in[end] == 'M') {
+          if (button == 0)
+            events.push_back({Key::CLICK, x, y});
+          else if (button == 2)
+            events.push_back({Key::CLEAR_PICKS});
+          else if (button == 64)
+            events.push_back({Key::ZOOM_IN});
+          else if (button == 65)
+            events.push_back({Key::ZOOM_OUT});
+        }
+        i = end;
+        continue;
+      }
+      // DECRQM reply: ESC [ ? mode ; value $ y
+      if (in[i + 2] == '?') {
+        size_t end = in.find('y', i + 3);
+        if (end == std::string::npos)
+          break;
+        int mode = 0, value = 0;
+        if (std::sscanf(in.c_str() + i + 3, "%d;%d", &mode, &value) == 2 &&
+            mode == 1016)
+          mouse_pixels = value == 1;
+        i = end;
+        continue;
+      }
+      // Arrow keys: ESC [ A/B/C/D
+      switch (in[i + 2]) {
+      case 'A': events.push_back({Key::UP}); break;
+      case 'B': events.push_back({Key::DOWN}); break;
+      case 'C': events.push_back({Key::RIGHT}); break;
+      case 'D': events.push_back({Key::LEFT}); break;
+      }
+      i += 2;
+      continue;
+    }
+    switch (in[i]) {
+    case '+': case '=': events.push_back({Key::ZOOM_IN}); break;
+    case '-': case '_': events.push_back({Key::ZOOM_OUT}); break;
+    case '0': events.push_back({Key::RESET}); break;
+    case 'k': events.push_back({Key::UP}); break;
+    case 'j': events.push_back({Key::DOWN}); break;
+    case 'h': events.push_back({Key::LEFT}); break;
+    case 'l': events.push_back({Key::RIGHT}); break;
+    case 'c': events.push_back({Key::CLEAR_PICKS}); break;
+    case 'q': case 'Q': events.push_back({Key::QUIT}); break;
     }
-    x++;
   }
+  return events;
 }
 
 // --- Kitty Graphics Protocol ---
@@ -317,6 +476,58 @@ void clear_graphics() {
   std::cout << "\033_Ga=d,d=i,i=1;\033\\" << std::flush;
 }
 
+// --- Sprite compositing (terminal-side) ---
+// Instead of sending a full frame, each element's sphere is uploaded once as
+// its own image and every frame only re-places those images. Re-issuing a=p
+// with the same (image id, placement id) pair moves an existing placement, so
+// nothing has to be deleted between frames.
+const int SPRITE_IMAGE_ID_BASE = 100;
+
+// Query the pixel size of one terminal cell; returns false if the terminal
+// does not report pixel dimensions (placements need them for X/Y offsets)
+bool get_cell_pixel_size(int &cell_w, int &cell_h) {
+  struct winsize ws {};
+  if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) != 0 || ws.ws_col == 0 ||
+      ws.ws_row == 0 || ws.ws_xpixel == 0 || ws.ws_ypixel == 0)
+    return false;
+  cell_w = ws.ws_xpixel / ws.ws_col;
+  cell_h = ws.ws_ypixel / ws.ws_row;
+  return cell_w > 0 && cell_h > 0;
+}
+
+// Transmit an image without displaying it (a=t)
+void upload_sprite(const std::vector<uint8_t> &rgba, int width, int height,
+                   int image_id) {
+  std::cout << "\033_Ga=t,f=32,s=" << width << ",v=" << height
+            << ",i=" << image_id << ",q=2;" << base64_encode(rgba)
+            << "\033\\";
+}
+
+// Place (or move) a previously uploaded sprite so that its top-left corner
+// lands at pixel (px, py) relative to the image origin at (row 1, col_offset)
+void place_sprite(int image_id, int placement_id, int px, int py, int z,
+                  int col_offset, int cell_w, int cell_h) {
+  px = std::max(px, 0);
+  py = std::max(py, 0);
+  // C=1 keeps the cursor where it is so placements don't scroll the screen
+  std::cout << "\033[" << 1 + py / cell_h << ";" << col_offset + px / cell_w
+            << "H\033_Ga=p,i=" << image_id << ",p=" << placement_id
+            << ",X=" << px % cell_w << ",Y=" << py % cell_h << ",z=" << z
+            << ",C=1,q=2;\033\\";
+}
+
+void delete_placement(int image_id, int placement_id) {
+  std::cout << "\033_Ga=d,d=i,i=" << image_id << ",p=" << placement_id
+            << ",q=2;\033\\";
+}
+
+void clear_sprites(int count) {
+  // Uppercase I also frees the stored image data
+  for (int i = 0; i < count; ++i)
+    std::cout << "\033_Ga=d,d=I,i=" << SPRITE_IMAGE_ID_BASE + i << ";\033\\";
+  std::cout << std::flush;
+}
+
 // --- Terminal text styling ---
 namespace style {
 const std::string RESET = "\033[0m";
@@ -328,6 +539,7 @@ const std::string GREEN = "\033[32m";
 const std::string MAGENTA = "\033[35m";
 const std::string WHITE = "\033[97m";
 const std::string BLUE = "\033[34m";
+const std::string RED = "\033[31m";
 } // namespace style
 
 // --- Info display ---
@@ -336,7 +548,12 @@ void print_at(int row, int col, const std::string &text) {
   std::cout << "\033[" << row << ";" << col << "H" << text;
 }
 
-void display_info_panel(const InputFileData &data, int image_cols) {
+void display_info_panel(const InputFileData &data, int image_cols,
+                        const std::string &status = "",
+                        const std::vector<std::string> &picks = {},
+                        const std::vector<GeometryIssue> &geometry = {},
+                        const std::vector<std::string> &scf = {},
+                        const std::vector<std::string> &field = {}) {
   // Text goes on LEFT, image goes on RIGHT
   // image_cols tells us where the image starts (approximately)
   // We print text from column 1 up to image_cols - 2
@@ -397,6 +614,25 @@ void display_info_panel(const InputFileData &data, int image_cols) {
   print_at(row, 1,
            "\033[K    Multiplicity: " + std::to_string(data.multiplicity));
   row++;
+  print_at(row, 1,
+           "\033[K    Geometry:     " +
+               (geometry.empty() ? style::GREEN + "OK"
+                                 : style::RED + std::to_string(geometry.size()) +
+                                       " problem" +
+                                       (geometry.size() > 1 ? "s" : "")) +
+               style::RESET);
+  row++;
+  const size_t max_geometry_lines = 4;
+  for (size_t i = 0; i < geometry.size() && i < max_geometry_lines; ++i) {
+    std::string line = i + 1 == max_geometry_lines && geometry.size() > i + 1
+                           ? "! ... and " + std::to_string(geometry.size() - i) +
+                                 " more (qsee --lint)"
+                           : "! " + geometry[i].message;
+    print_at(row, 1,
+             "\033[K" + style::RED + "    " + line.substr(0, text_width - 4) +
+                 style::RESET);
+    row++;
+  }
   row++; // blank line
 
   // Parameters section header
@@ -412,8 +648,10 @@ void display_info_panel(const InputFileData &data, int image_cols) {
   // Group parameters by section
   std::unordered_map<std::string, std::vector<const InputParameter *>> sections;
   for (const auto &param : data.parameters) {
-    // Skip MOLECULE section items as we show them above
-    if (param.section != "MOLECULE") {
+    // Skip MOLECULE section items as we show them above, and a field the
+    // FIELD section below plots
+    if (param.section != "MOLECULE" &&
+        !(param.section == "RT" && param.key == "FIELD" && !field.empty())) {
       sections[param.section].push_back(&param);
     }
   }
@@ -457,27 +695,840 @@ void display_info_panel(const InputFileData &data, int image_cols) {
     }
   }
 
+  // Projected size of the job
+  const JobEstimate &est = data.estimate;
+  char cost[32];
+  std::snprintf(cost, sizeof(cost), "%.3g", est.relative_cost);
+  print_at(row, 1,
+           "\033[K" + style::BOLD + style::WHITE + " ⏱  ESTIMATE" +
+               style::RESET);
+  row++;
+  std::vector<std::string> estimate_lines = {
+      "Basis fns: " + std::to_string(est.basis_functions) +
+          (est.cartesian ? " cart" : " sph") + ", dim " +
+          std::to_string(est.dimension) + (est.complex ? " complex" : " real"),
+      "Memory:    " + format_bytes(est.total_bytes) + " (ERI " +
+          format_bytes(est.integral_bytes) + ")",
+      "Cost:      " + est.scaling + ", " + cost + "x water SCF"};
+  for (const auto &note : est.notes)
+    estimate_lines.push_back("! " + note);
+  for (const auto &line : estimate_lines) {
+    print_at(row, 1,
+             "\033[K" + (line[0] == '!' ? style::RED : style::CYAN) +
+                 "    " + line.substr(0, text_width - 4) + style::RESET);
+    row++;
+  }
+  row++;
+
+  // External field of an RT job
+  if (!field.empty()) {
+    print_at(row, 1,
+             "\033[K" + style::BOLD + style::MAGENTA + " ⚡ FIELD" +
+                 style::RESET);
+    row++;
+    for (const auto &line : field) {
+      print_at(row, 1,
+               "\033[K" + (line[0] == '!' ? style::RED : style::CYAN) +
+                   "    " + line + style::RESET);
+      row++;
+    }
+    row++;
+  }
+
+  // Convergence of a followed output file (-monitor)
+  if (!scf.empty()) {
+    print_at(row, 1,
+             "\033[K" + style::BOLD + style::WHITE + " 📈 SCF" + style::RESET);
+    row++;
+    for (const auto &line : scf) {
+      print_at(row, 1, "\033[K" + style::CYAN + "    " + line + style::RESET);
+      row++;
+    }
+    row++;
+  }
+
+  if (!picks.empty()) {
+    print_at(row, 1,
+             "\033[K" + style::BOLD + style::YELLOW + " ⌖  SELECTION" +
+                 style::RESET);
+    row++;
+    for (const auto &line : picks) {
+      print_at(row, 1, "\033[K    " + line.substr(0, text_width));
+      row++;
+    }
+    row++;
+  }
+
+  if (!status.empty()) {
+    print_at(row, 1, "\033[K" + style::DIM + " " + status + style::RESET);
+    row++;
+  }
+
   // Exit instructions
   print_at(row, 1,
-           "\033[K" + style::DIM + " Press Ctrl+C to exit" + style::RESET);
+           "\033[K" + style::DIM +
+               " +/- zoom, arrows pan, click pick, c clear, q exit" +
+               style::RESET);
+
+  std::cout << std::flush;
+}
+
+// --- Viewports ---
+// Everything one camera view needs per frame, kept between frames so the
+// buffers are reused
+struct Viewport {
+  ViewMode mode = ViewMode::ISOMETRIC;
+  int x0 = 0, y0 = 0; // Offset of the pane in the displayed image
+  HierarchicalDepth depth_pyramid;
+  std::vector<uint32_t> visible;
+  std::vector<ProjectedAtom> projected;
+  PickGrid pick_grid; // Holds the last drawn frame
+  OitBuffers oit; // Translucent atoms go through weighted blended OIT
+  OccupancyGrid label_grid;
+  std::vector<uint32_t> near_to_far;
+  std::vector<uint8_t> rgba; // Premultiplied
+  bool labeled = false;
+};
+
+// --- Comparison grid ---
+struct GridCell {
+  InputFileData data;
+  std::vector<std::string> summary;     // Caption lines
+  std::vector<ProjectedAtom> projected; // Per-frame scratch
+  std::vector<uint8_t> rgba;            // Premultiplied tile
+};
+
+/**
+ * \brief Show several inputs side by side with synchronized rotation.
+ *
+ * Files are parsed concurrently, then every frame each tile is projected
+ * and rasterized on its own worker and the tiles are uploaded as one image.
+ * All molecules share one scale so their sizes compare directly.
+ *
+ * \param [in] tile Edge length of one tile in pixels
+ */
+int run_grid(const std::vector<std::string> &files, ViewMode view_mode,
+             int tile, bool antialias, int supersample, bool use_ao) {
+  std::vector<GridCell> cells(files.size());
+  parallel_for(files.size(), [&](size_t i) {
+    cells[i].data = parse_inp_file(files[i]);
+    if (use_ao)
+      compute_ambient_occlusion(cells[i].data.atoms);
+  });
+
+  const GlyphAtlas atlas(std::max(1, tile / 256));
+  const int max_chars = (tile - 4) / atlas.advance();
+  double max_extent = 0.0;
+  for (size_t i = 0; i < cells.size(); ++i) {
+    GridCell &cell = cells[i];
+    std::vector<Atom> &atoms = cell.data.atoms;
+    if (atoms.empty()) {
+      std::cerr << "No atoms found in " << files[i] << std::endl;
+      return 1;
+    }
 
+    // Each molecule is centered in its own tile
+    double cx = 0, cy = 0, cz = 0;
+    for (const auto &atom : atoms) {
+      cx += atom.x;
+      cy += atom.y;
+      cz += atom.z;
+    }
+    cx /= atoms.size();
+    cy /= atoms.size();
+    cz /= atoms.size();
+    for (auto &atom : atoms) {
+      atom.x -= cx;
+      atom.y -= cy;
+      atom.z -= cz;
+      max_extent = std::max(max_extent, std::sqrt(atom.x * atom.x +
+                                                  atom.y * atom.y +
+                                                  atom.z * atom.z));
+    }
+
+    // Caption: index and formula, then charge, multiplicity, reference
+    // and basis
+    std::string reference = cell.data.get_parameter("QM", "REFERENCE");
+    std::string basis = cell.data.get_parameter("BASIS", "BASIS");
+    cell.summary = {
+        std::to_string(i + 1) + " " + cell.data.get_formula(),
+        "q" + std::to_string(cell.data.charge) + " m" +
+            std::to_string(cell.data.multiplicity) +
+            (reference.empty() ? "" : " " + reference) +
+            (basis.empty() ? "" : " " + basis)};
+    for (auto &line : cell.summary)
+      if ((int)line.size() > max_chars)
+        line = line.substr(0, std::max(0, max_chars - 1)) + "~";
+    std::cerr << "[" << i + 1 << "] " << files[i] << ": "
+              << cell.data.get_formula() << std::endl;
+  }
+
+  // Near-square layout; the caption takes the bottom of each tile
+  const int cols = (int)std::ceil(std::sqrt((double)cells.size()));
+  const int rows = (int)((cells.size() + cols - 1) / cols);
+  const int caption = 2 * atlas.line_height();
+  const int view_h = std::max(16, tile - caption);
+  const int atom_radius = std::max(2, (int)std::lround(tile * 12 / 256.0));
+  const int padding = (int)std::lround(tile * 10 / 256.0);
+  const double viewport_radius =
+      std::min(tile, view_h) / 2.0 - atom_radius - padding;
+  const double scale =
+      (max_extent > 0.001) ? (viewport_radius / max_extent) : 80.0;
+
+  const double rotation_speed = M_PI / 3.0;
+  const auto frame_duration = std::chrono::milliseconds(1000 / 30);
+  double angle = 0.0, zoom = 1.0;
+  auto last_time = std::chrono::steady_clock::now();
+
+  std::signal(SIGINT, signal_handler);
+  std::signal(SIGTERM, signal_handler);
+
+  std::cout << "\033[?1049h"; // Enter alternate screen
+  std::cout << "\033[?25l";   // Hide cursor
+  std::cout << "\033[2J";     // Clear screen
   std::cout << std::flush;
+  enable_raw_input();
+
+  const int frame_w = cols * tile, frame_h = rows * tile;
+  std::vector<uint8_t> frame;
+  const Color caption_color = {200, 200, 200};
+  const Color divider = {90, 90, 90};
+
+  while (running) {
+    std::cout << "\033[H" << std::flush;
+    auto frame_start = std::chrono::steady_clock::now();
+    double dt =
+        std::chrono::duration<double>(frame_start - last_time).count();
+    last_time = frame_start;
+    angle = std::fmod(angle + rotation_speed * dt, 2.0 * M_PI);
+
+    for (const InputEvent &event : read_input()) {
+      if (event.key == Key::QUIT)
+        running = 0;
+      else if (event.key == Key::ZOOM_IN)
+        zoom *= 1.25;
+      else if (event.key == Key::ZOOM_OUT)
+        zoom = std::max(0.05, zoom / 1.25);
+      else if (event.key == Key::RESET)
+        zoom = 1.0;
+    }
+
+    const ViewTransform view =
+        make_view(view_mode, angle, scale * zoom, tile / 2.0, view_h / 2.0);
+    parallel_for(cells.size(), [&](size_t i) {
+      GridCell &cell = cells[i];
+      std::vector<uint8_t> &rgba = cell.rgba;
+      rasterize_atoms(cell.data.atoms, view, tile, view_h, atom_radius,
+                      antialias, supersample, use_ao, cell.projected, rgba);
+      rgba.resize((size_t)tile * tile * 4, 0); // Caption rows
+      for (size_t k = 0; k < cell.summary.size(); ++k)
+        atlas.draw(rgba, tile, tile, 2, view_h + (int)k * atlas.line_height(),
+                   cell.summary[k], caption_color);
+    });
+
+    frame.assign((size_t)frame_w * frame_h * 4, 0);
+    for (size_t i = 0; i < cells.size(); ++i) {
+      const int x0 = (int)(i % cols) * tile, y0 = (int)(i / cols) * tile;
+      for (int y = 0; y < tile; ++y)
+        std::memcpy(&frame[((size_t)(y0 + y) * frame_w + x0) * 4],
+                    &cells[i].rgba[(size_t)y * tile * 4], (size_t)tile * 4);
+    }
+    for (int c = 1; c < cols; ++c)
+      for (int y = 0; y < frame_h; ++y)
+        blend_pixel(&frame[((size_t)y * frame_w + c * tile) * 4], divider, 255);
+    for (int r = 1; r < rows; ++r)
+      for (int x = 0; x < frame_w; ++x)
+        blend_pixel(&frame[((size_t)r * tile * frame_w + x) * 4], divider, 255);
+    unpremultiply_alpha(frame);
+    display_frame(frame, frame_w, frame_h, 1);
+
+    auto elapsed = std::chrono::steady_clock::now() - frame_start;
+    if (elapsed < frame_duration)
+      std::this_thread::sleep_for(frame_duration - elapsed);
+  }
+
+  // Cleanup
+  restore_input();
+  clear_graphics();
+  std::cout << "\033[?25h";   // Show cursor
+  std::cout << "\033[?1049l"; // Exit alternate screen
+  std::cout << std::flush;
+  std::cerr << "Exited cleanly." << std::endl;
+
+  return 0;
+}
+
+// --- Job estimates ---
+
+/**
+ * \brief Print the projected memory and cost of every .inp file under a
+ *        directory (or of one file) as a JSON array, one object per line.
+ *
+ * Files are parsed and estimated on all cores and printed in path order.
+ */
+int run_estimate(const std::string &path) {
+  std::vector<std::string> files;
+  if (!collect_input_files(path, files)) {
+    std::cerr << "Cannot estimate " << path << ": no such file or directory"
+              << std::endl;
+    return 2;
+  }
+  std::vector<std::string> objects(files.size());
+  parallel_for(files.size(), [&](size_t i) {
+    InputFileData data = parse_inp_file(files[i]);
+    objects[i] = estimate_json(data.estimate, files[i], data.atoms.size());
+  });
+  std::cout << "[";
+  for (size_t i = 0; i < objects.size(); ++i)
+    std::cout << (i ? ",\n " : "\n ") << objects[i];
+  std::cout << "\n]" << std::endl;
+  return 0;
+}
+
+// --- DFT grids ---
+
+// GAUXC section settings of an input, defaulted as CQGauXCOptions does
+DftGridOptions dft_grid_options(const InputFileData &data) {
+  DftGridOptions options;
+  auto set = [&](const char *key, std::string &field) {
+    std::string value = data.get_parameter("GAUXC", key);
+    if (!value.empty())
+      field = value;
+  };
+  set("GRID", options.grid);
+  set("PRUNINGSCHEME", options.pruning);
+  set("RADIALQUAD", options.radial);
+  set("XCWEIGHTALG", options.weights);
+  std::string batch = data.get_parameter("GAUXC", "BATCHSIZE");
+  if (!batch.empty())
+    options.batch_size = std::max(1L, std::atol(batch.c_str()));
+  return options;
+}
+
+// Build the molecular grid of one input and print its statistics
+int run_dft_grid(const std::string &path) {
+  InputFileData data = parse_inp_file(path);
+  if (data.atoms.empty()) {
+    std::cerr << "No atoms found in " << path << std::endl;
+    return 1;
+  }
+  const DftGridOptions options = dft_grid_options(data);
+  const DftGrid grid = build_dft_grid(data.atoms, options);
+  std::cout << path << ": " << data.get_formula() << "\n"
+            << describe_dft_grid(grid, data.atoms, options);
+  return 0;
+}
+
+// --- Fleet dashboard ---
+const int DASHBOARD_IMAGE_ID_BASE = 1000;
+
+/**
+ * \brief Watch the jobs under the given directories and redraw a table of
+ *        their progress as their outputs grow, one thread for all of them.
+ *
+ * Each job takes two rows, with a thumbnail of its molecule beside them when
+ * the terminal reports its cell size. Thumbnails are uploaded the first time
+ * their job scrolls into view. When stdout is not a terminal the table is
+ * printed once.
+ *
+ * \returns Exit status: 0 on success, 2 if no inputs were found
+ */
+int run_dashboard(const std::vector<std::string> &paths) {
+  const std::vector<std::string> inputs = find_job_inputs(paths);
+  if (inputs.empty()) {
+    std::cerr << "No .inp files found" << std::endl;
+    return 2;
+  }
+  Fleet fleet;
+  for (const auto &input : inputs)
+    fleet.add_job(input);
+  fleet.refresh();
+  std::vector<FleetJob> &jobs = fleet.jobs;
+
+  if (!isatty(STDOUT_FILENO)) {
+    for (const FleetJob &job : jobs)
+      for (const auto &line : describe_job(job, 100))
+        std::cout << line << "\n";
+    return 0;
+  }
+
+  std::signal(SIGINT, signal_handler);
+  std::signal(SIGTERM, signal_handler);
+  std::cout << "\033[?1049h\033[?25l\033[2J" << std::flush;
+  enable_raw_input();
+  if (raw_input)
+    fleet.add_wakeup(STDIN_FILENO);
+
+  int cell_w = 0, cell_h = 0;
+  const bool thumbnails = get_cell_pixel_size(cell_w, cell_h);
+  const int thumb_cols = thumbnails ? 4 : 0;
+  const int text_col = thumbnails ? thumb_cols + 2 : 1;
+  std::vector<char> uploaded(jobs.size(), 0);
+  std::vector<int> placed_row(jobs.size(), 0); // 0: not placed
+  std::vector<uint8_t> rgba;
+
+  // Output changes redraw at most this often; keys redraw at once, and
+  // ages and ETAs move on every second even when nothing is written
+  const auto redraw_interval = std::chrono::milliseconds(100);
+  const auto refresh_interval = std::chrono::seconds(1);
+  size_t top = 0;
+  bool dirty = true, keyed = true;
+  auto last_draw = std::chrono::steady_clock::now();
+  while (running) {
+    for (const InputEvent &event : read_input()) {
+      if (event.key == Key::QUIT)
+        running = 0;
+      else if (event.key == Key::UP && top > 0)
+        --top;
+      else if (event.key == Key::DOWN)
+        ++top;
+      keyed = true;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (running && (keyed || now - last_draw >= refresh_interval ||
+                    (dirty && now - last_draw >= redraw_interval))) {
+      struct winsize ws {};
+      int rows = 24, cols = 80;
+      if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_row > 0) {
+        rows = ws.ws_row;
+        cols = ws.ws_col;
+      }
+      const size_t visible = (size_t)std::max(1, (rows - 3) / 2);
+      top = std::min(top, jobs.size() > visible ? jobs.size() - visible : 0);
+
+      size_t counts[6] = {};
+      uint64_t bytes = 0;
+      for (const FleetJob &job : jobs) {
+        ++counts[(int)job.status()];
+        bytes += job.follower->bytes_read;
+      }
+      std::string screen = "\033[H\033[K" + style::BOLD + style::WHITE +
+                           " " + std::to_string(jobs.size()) + " jobs" +
+                           style::RESET;
+      const std::pair<JobStatus, std::string> summary[] = {
+          {JobStatus::SCF, " SCF"},       {JobStatus::RT, " RT"},
+          {JobStatus::CONVERGED, " post-SCF"}, {JobStatus::DONE, " done"},
+          {JobStatus::FAILED, " failed"}, {JobStatus::WAITING, " waiting"}};
+      for (const auto &[status, name] : summary)
+        if (counts[(int)status])
+          screen += "  " + std::to_string(counts[(int)status]) + name;
+      screen += "\n\033[K\n";
+
+      for (size_t k = 0; k < jobs.size(); ++k) {
+        const bool shown = k >= top && k < top + visible;
+        if (!shown) {
+          if (placed_row[k])
+            delete_placement(DASHBOARD_IMAGE_ID_BASE + (int)k, 1);
+          placed_row[k] = 0;
+          continue;
+        }
+        const FleetJob &job = jobs[k];
+        const int row = 3 + 2 * (int)(k - top);
+        const JobStatus status = job.status();
+        const std::string &color =
+            status == JobStatus::FAILED ? style::RED
+            : status == JobStatus::DONE ? style::GREEN
+            : status == JobStatus::WAITING ? style::DIM
+                                           : style::CYAN;
+        const auto lines = describe_job(job, std::max(20, cols - text_col));
+        screen += "\033[" + std::to_string(row) + ";1H\033[K\033[" +
+                  std::to_string(row) + ";" + std::to_string(text_col) + "H" +
+                  color + lines[0] + style::RESET;
+        screen += "\033[" + std::to_string(row + 1) + ";1H\033[K\033[" +
+                  std::to_string(row + 1) + ";" + std::to_string(text_col) +
+                  "H" + style::DIM + lines[1] + style::RESET;
+
+        if (thumbnails && !job.data.atoms.empty()) {
+          const int image_id = DASHBOARD_IMAGE_ID_BASE + (int)k;
+          if (!uploaded[k]) {
+            const int w = thumb_cols * cell_w, h = 2 * cell_h;
+            render_still(job.data.atoms, w, h, StillOptions(), rgba);
+            upload_sprite(rgba, w, h, image_id);
+            uploaded[k] = 1;
+          }
+          // Placed again (same placement id, so moved) after scrolling
+          if (placed_row[k] != row) {
+            std::cout << screen;
+            screen.clear();
+            place_sprite(image_id, 1, 0, (row - 1) * cell_h, 0, 1, cell_w,
+                         cell_h);
+            placed_row[k] = row;
+          }
+        }
+      }
+      for (int row = 3 + 2 * (int)visible; row < rows; ++row)
+        screen += "\033[" + std::to_string(row) + ";1H\033[K";
+      char footer[128];
+      std::snprintf(footer, sizeof(footer),
+                    " %zu-%zu of %zu, %.1f MB read; j/k scroll, q exit",
+                    std::min(top + 1, jobs.size()),
+                    std::min(top + visible, jobs.size()), jobs.size(),
+                    bytes / 1e6);
+      screen += "\033[" + std::to_string(rows) + ";1H\033[K" + style::DIM +
+                footer + style::RESET;
+      std::cout << screen << std::flush;
+      dirty = keyed = false;
+      last_draw = now;
+    }
+
+    // Sleep until an output or the keyboard has something, at most until
+    // the next redraw is due
+    const auto due =
+        last_draw + (dirty ? redraw_interval : refresh_interval) - now;
+    const int timeout = (int)std::max<long long>(
+        0, std::chrono::duration_cast<std::chrono::milliseconds>(due).count());
+    if (running && fleet.wait(timeout) > 0)
+      dirty = true;
+  }
+
+  restore_input();
+  for (size_t k = 0; k < jobs.size(); ++k)
+    if (uploaded[k])
+      std::cout << "\033_Ga=d,d=I,i=" << DASHBOARD_IMAGE_ID_BASE + k
+                << ";\033\\";
+  std::cout << "\033[?25h\033[?1049l" << std::flush;
+  std::cerr << "Exited cleanly." << std::endl;
+  return 0;
+}
+
+// --- Output logs ---
+static bool has_log_extension(const std::string &path) {
+  for (const char *ext : {".out", ".log"})
+    if (path.size() > 4 && path.compare(path.size() - 4, 4, ext) == 0)
+      return true;
+  return false;
+}
+
+/**
+ * \brief Geometry `frame` of an output log (1-based, negative counting from
+ *        the end, 0 for the last one) with the parameters of the input next
+ *        to it (same stem, .inp) when there is one.
+ *
+ * The last geometry is found by scanning backward from the end of the log;
+ * any other frame indexes the whole log first.
+ */
+static bool load_log_geometry(const std::string &path, long frame,
+                              InputFileData &data) {
+  GeometryLog log(path);
+  if (!log.ok()) {
+    std::cerr << log.error() << std::endl;
+    return false;
+  }
+  std::vector<Atom> atoms;
+  std::string where;
+  if (frame == 0) {
+    if (!log.last(atoms)) {
+      std::cerr << "No geometry found in " << path << std::endl;
+      return false;
+    }
+    where = "Last geometry";
+  } else {
+    const long count = (long)log.frame_count();
+    const long index = frame > 0 ? frame - 1 : count + frame;
+    if (index < 0 || index >= count || !log.frame(index, atoms)) {
+      std::cerr << path << " holds " << count << " geometries; no frame "
+                << frame << std::endl;
+      return false;
+    }
+    where = "Frame " + std::to_string(index + 1) + " of " +
+            std::to_string(count);
+  }
+
+  const std::string input = path.substr(0, path.size() - 4) + ".inp";
+  if (access(input.c_str(), R_OK) == 0)
+    data = parse_inp_file(input);
+  data.filename = path;
+  data.title = data.title.empty() ? where : where + " · " + data.title;
+  data.atoms = std::move(atoms);
+  return true;
 }
 
 // --- Main ---
 int main(int argc, char *argv[]) {
   if (argc < 2) {
-    std::cerr << "Usage: " << argv[0] << " <input.inp> [-xy|-xz|-yz]"
+    std::cerr << "Usage: " << argv[0]
+              << " <input.inp> [more.inp ...] [-xy|-xz|-yz|-quad] [-sprites] [-noaa] [-ss2|-ss4] "
+                 "[-size N] [-ao] [-opacity SPEC] [-zoom F] [-occlude] "
+                 "[-show EXPR] [-ghost EXPR] [-highlight EXPR] "
+                 "[-labels index|symbol|both] [-monitor FILE]"
+              << std::endl;
+    std::cerr << "       " << argv[0] << " <output.out|.log> [-frame N] "
+                 "[viewer options]"
+              << std::endl;
+    std::cerr << "       " << argv[0] << " --lint <dir|file.inp>" << std::endl;
+    std::cerr << "  --lint : Check every .inp under a directory against the "
+                 "ChronusQ keyword schema"
+              << std::endl;
+    std::cerr << "       " << argv[0] << " --estimate <dir|file.inp>"
+              << std::endl;
+    std::cerr << "  --estimate : Print projected memory and cost of each job "
+                 "as JSON"
+              << std::endl;
+    std::cerr << "       " << argv[0] << " --dft-grid <file.inp>" << std::endl;
+    std::cerr << "  --dft-grid : Build the DFT integration grid of the GAUXC "
+                 "settings and report point and batch counts"
+              << std::endl;
+    std::cerr << "       " << argv[0] << " --index <dir>" << std::endl;
+    std::cerr << "  --index : Index the keys, formula, charge and atom count "
+                 "of every .inp under a directory (incremental)"
+              << std::endl;
+    std::cerr << "       " << argv[0] << " --query <dir> <expr>" << std::endl;
+    std::cerr << "  --query : List indexed files matching e.g. "
+                 "\"BASIS.BASIS = 6-31G(D) and atoms > 20\""
+              << std::endl;
+    std::cerr << "       " << argv[0] << " --monitor <output> [input.inp]"
+              << std::endl;
+    std::cerr << "  --monitor : Follow a growing ChronusQ output and plot SCF "
+                 "convergence as it runs"
+              << std::endl;
+    std::cerr << "       " << argv[0]
+              << " --spectrum <dipole files...> [-window exp|gauss|none] "
+                 "[-method auto|fft|pade] [-emax eV] [-gamma eV]"
+              << std::endl;
+    std::cerr << "  --spectrum : Absorption spectrum of a real-time job from "
+                 "its dipole time series (one file per kick direction)"
+              << std::endl;
+    std::cerr << "       " << argv[0]
+              << " --broaden <outputs...> [-shape lorentz|gauss] [-fwhm eV] "
+                 "[-emin eV] [-emax eV] [-points N]"
+              << std::endl;
+    std::cerr << "  --broaden : Broaden the excitation energies and oscillator "
+                 "strengths of response outputs into overlaid spectra"
+              << std::endl;
+    std::cerr << "       " << argv[0] << " --dashboard <dirs|files.inp...>"
+              << std::endl;
+    std::cerr << "  --dashboard : Watch many running jobs at once: status, "
+                 "last SCF energy or RT step and ETA per job"
+              << std::endl;
+    std::cerr << "       " << argv[0] << " --lsp" << std::endl;
+    std::cerr << "  --lsp : Language server for .inp files (diagnostics, "
+                 "completion, hover) over stdin/stdout"
+              << std::endl;
+    std::cerr << "       " << argv[0] << " --bench-directive [N]" << std::endl;
+    std::cerr << "  --bench-directive : Time the chronusq: directive parser "
+                 "against the regex cascade it replaces (N rounds)"
               << std::endl;
     std::cerr << "  -xy : View the XY plane (camera along Z-axis)" << std::endl;
     std::cerr << "  -xz : View the XZ plane (camera along Y-axis)" << std::endl;
     std::cerr << "  -yz : View the YZ plane (camera along X-axis)" << std::endl;
     std::cerr << "  (default: isometric 3/4 view)" << std::endl;
+    std::cerr << "  more .inp files : Compare inputs in a grid (-size sets "
+                 "the tile size, default 160)"
+              << std::endl;
+    std::cerr << "  -quad : Show the XY, XZ, YZ and isometric views at once "
+                 "(2x2 grid)"
+              << std::endl;
+    std::cerr << "  -sprites : Upload one sphere per element and only send "
+                 "placements each frame (low bandwidth, e.g. over SSH)"
+              << std::endl;
+    std::cerr << "  -noaa : Disable anti-aliasing (hard-edged circles)"
+              << std::endl;
+    std::cerr << "  -ss2, -ss4 : Supersample each frame 2x2 / 4x4 and "
+                 "box-filter it down"
+              << std::endl;
+    std::cerr << "  -size N : Render an N x N pixel image (default: 256)"
+              << std::endl;
+    std::cerr << "  -ao : Shade atoms by precomputed ambient occlusion "
+                 "(depth cues for dense structures)"
+              << std::endl;
+    std::cerr << "  -opacity SPEC : Draw atoms translucent, e.g. "
+                 "\"H=0.3\" or \"1-20=0.2,O=0.5\" (repeatable)"
+              << std::endl;
+    std::cerr << "  -zoom F : Initial zoom factor (+/- and arrow keys adjust "
+                 "zoom and pan while running)"
+              << std::endl;
+    std::cerr << "  -occlude : Also cull atoms hidden behind nearer ones, "
+                 "treating atoms as solid discs"
+              << std::endl;
+    std::cerr << "  -show EXPR : Only draw atoms matching a selection, e.g. "
+                 "\"within 5 of atom 12\""
+              << std::endl;
+    std::cerr << "  -ghost EXPR : Draw matching atoms faint, e.g. "
+                 "\"element H or z > 3\""
+              << std::endl;
+    std::cerr << "  -highlight EXPR : Ring matching atoms, e.g. "
+                 "\"fragment containing atom 40\""
+              << std::endl;
+    std::cerr << "  -dftgrid : Draw the DFT integration grid (GAUXC settings) "
+                 "as a point cloud behind the atoms"
+              << std::endl;
+    std::cerr << "  -labels MODE : Label atoms by index, symbol or both "
+                 "(picked distances are always labeled)"
+              << std::endl;
+    std::cerr << "  -monitor FILE : Plot the SCF convergence of a running "
+                 "job's output in the info panel"
+              << std::endl;
+    std::cerr << "  -frame N : View the Nth geometry of an output log "
+                 "(negative counts from the end; default: the last)"
+              << std::endl;
     return 1;
   }
 
+  // Non-viewer modes
+  if (std::string(argv[1]) == "--lint") {
+    if (argc < 3) {
+      std::cerr << "Usage: " << argv[0] << " --lint <dir|file.inp>"
+                << std::endl;
+      return 2;
+    }
+    return run_lint(argv[2]);
+  }
+  if (std::string(argv[1]) == "--estimate") {
+    if (argc < 3) {
+      std::cerr << "Usage: " << argv[0] << " --estimate <dir|file.inp>"
+                << std::endl;
+      return 2;
+    }
+    return run_estimate(argv[2]);
+  }
+  if (std::string(argv[1]) == "--dft-grid") {
+    if (argc < 3) {
+      std::cerr << "Usage: " << argv[0] << " --dft-grid <file.inp>"
+                << std::endl;
+      return 2;
+    }
+    return run_dft_grid(argv[2]);
+  }
+  if (std::string(argv[1]) == "--index") {
+    if (argc < 3) {
+      std::cerr << "Usage: " << argv[0] << " --index <dir>" << std::endl;
+      return 2;
+    }
+    return run_index(argv[2]);
+  }
+  if (std::string(argv[1]) == "--query") {
+    if (argc < 4) {
+      std::cerr << "Usage: " << argv[0] << " --query <dir> <expr>"
+                << std::endl;
+      return 2;
+    }
+    return run_query(argv[2], argv[3]);
+  }
+  if (std::string(argv[1]) == "--monitor") {
+    if (argc < 3) {
+      std::cerr << "Usage: " << argv[0] << " --monitor <output> [input.inp]"
+                << std::endl;
+      return 2;
+    }
+    return run_monitor(argv[2], argc > 3 ? argv[3] : "");
+  }
+  if (std::string(argv[1]) == "--spectrum") {
+    std::vector<std::string> files;
+    SpectrumOptions options;
+    bool valid = true;
+    for (int i = 2; i < argc; ++i) {
+      std::string arg = argv[i];
+      if (arg == "-window" && i + 1 < argc) {
+        std::string value = argv[++i];
+        if (value == "exp")
+          options.window = SpectrumWindow::EXPONENTIAL;
+        else if (value == "gauss")
+          options.window = SpectrumWindow::GAUSSIAN;
+        else if (value == "none")
+          options.window = SpectrumWindow::NONE;
+        else
+          valid = false;
+      } else if (arg == "-method" && i + 1 < argc) {
+        std::string value = argv[++i];
+        if (value == "auto")
+          options.method = SpectrumMethod::AUTO;
+        else if (value == "fft")
+          options.method = SpectrumMethod::FFT;
+        else if (value == "pade")
+          options.method = SpectrumMethod::PADE;
+        else
+          valid = false;
+      } else if (arg == "-emax" && i + 1 < argc) {
+        options.max_energy = std::atof(argv[++i]);
+        valid = valid && options.max_energy > 0;
+      } else if (arg == "-gamma" && i + 1 < argc) {
+        options.damping = std::atof(argv[++i]);
+        valid = valid && options.damping > 0;
+      } else if (arg.size() > 1 && arg[0] == '-') {
+        valid = false;
+      } else {
+        files.push_back(arg);
+      }
+    }
+    if (files.empty() || !valid) {
+      std::cerr << "Usage: " << argv[0]
+                << " --spectrum <dipole files...> [-window exp|gauss|none] "
+                   "[-method auto|fft|pade] [-emax eV] [-gamma eV]"
+                << std::endl;
+      return 2;
+    }
+    return run_spectrum(files, options);
+  }
+  if (std::string(argv[1]) == "--broaden") {
+    std::vector<std::string> files;
+    BroadenOptions options;
+    bool valid = true;
+    for (int i = 2; i < argc; ++i) {
+      std::string arg = argv[i];
+      if (arg == "-shape" && i + 1 < argc) {
+        std::string value = argv[++i];
+        if (value == "lorentz")
+          options.shape = LineShape::LORENTZIAN;
+        else if (value == "gauss")
+          options.shape = LineShape::GAUSSIAN;
+        else
+          valid = false;
+      } else if (arg == "-fwhm" && i + 1 < argc) {
+        options.fwhm = std::atof(argv[++i]);
+        valid = valid && options.fwhm > 0;
+      } else if (arg == "-emin" && i + 1 < argc) {
+        options.min_energy = std::atof(argv[++i]);
+      } else if (arg == "-emax" && i + 1 < argc) {
+        options.max_energy = std::atof(argv[++i]);
+      } else if (arg == "-points" && i + 1 < argc) {
+        options.points = std::strtoul(argv[++i], nullptr, 10);
+        valid = valid && options.points >= 2;
+      } else if (arg.size() > 1 && arg[0] == '-') {
+        valid = false;
+      } else {
+        files.push_back(arg);
+      }
+    }
+    if (files.empty() || !valid) {
+      std::cerr << "Usage: " << argv[0]
+                << " --broaden <outputs...> [-shape lorentz|gauss] "
+                   "[-fwhm eV] [-emin eV] [-emax eV] [-points N]"
+                << std::endl;
+      return 2;
+    }
+    return run_broaden(files, options);
+  }
+  if (std::string(argv[1]) == "--dashboard") {
+    if (argc < 3) {
+      std::cerr << "Usage: " << argv[0] << " --dashboard <dirs|files.inp...>"
+                << std::endl;
+      return 2;
+    }
+    return run_dashboard(std::vector<std::string>(argv + 2, argv + argc));
+  }
+  if (std::string(argv[1]) == "--lsp")
+    return run_lsp();
+  if (std::string(argv[1]) == "--bench-directive")
+    return run_directive_bench(argc > 2 ? std::atoi(argv[2]) : 200);
+
   // Parse command line for view mode
   ViewMode view_mode = ViewMode::ISOMETRIC;
+  bool use_sprites = false;
+  bool antialias = true;
+  int supersample = 1;
+  int image_size = 256;
+  bool use_ao = false;
+  std::vector<std::string> opacity_specs;
+  double initial_zoom = 1.0;
+  bool occlusion_culling = false;
+  bool show_dft_grid = false;
+  std::string show_expr, ghost_expr, highlight_expr, monitor_path;
+  LabelMode label_mode = LabelMode::NONE;
+  bool quad_view = false;
+  bool size_set = false;
+  std::vector<std::string> grid_files; // Further .inp files: grid mode
+  long log_frame = 0; // Geometry of an output log, 0 for the last
   for (int i = 2; i < argc; ++i) {
     std::string arg = argv[i];
     if (arg == "-xy" || arg == "xy")
@@ -486,10 +1537,71 @@ int main(int argc, char *argv[]) {
       view_mode = ViewMode::XZ;
     else if (arg == "-yz" || arg == "yz")
       view_mode = ViewMode::YZ;
+    else if (arg == "-quad" || arg == "quad")
+      quad_view = true;
+    else if (arg == "-sprites" || arg == "sprites")
+      use_sprites = true;
+    else if (arg == "-noaa" || arg == "noaa")
+      antialias = false;
+    else if (arg == "-ss2" || arg == "ss2")
+      supersample = 2;
+    else if (arg == "-ss4" || arg == "ss4")
+      supersample = 4;
+    else if ((arg == "-size" || arg == "size") && i + 1 < argc) {
+      image_size = std::max(32, std::atoi(argv[++i]));
+      size_set = true;
+    }
+    else if (arg == "-ao" || arg == "ao")
+      use_ao = true;
+    else if ((arg == "-opacity" || arg == "opacity") && i + 1 < argc)
+      opacity_specs.push_back(argv[++i]);
+    else if ((arg == "-zoom" || arg == "zoom") && i + 1 < argc)
+      initial_zoom = std::max(0.05, std::atof(argv[++i]));
+    else if (arg == "-occlude" || arg == "occlude")
+      occlusion_culling = true;
+    else if (arg == "-dftgrid" || arg == "dftgrid")
+      show_dft_grid = true;
+    else if ((arg == "-show" || arg == "show") && i + 1 < argc)
+      show_expr = argv[++i];
+    else if ((arg == "-ghost" || arg == "ghost") && i + 1 < argc)
+      ghost_expr = argv[++i];
+    else if ((arg == "-highlight" || arg == "highlight") && i + 1 < argc)
+      highlight_expr = argv[++i];
+    else if ((arg == "-monitor" || arg == "monitor") && i + 1 < argc)
+      monitor_path = argv[++i];
+    else if ((arg == "-frame" || arg == "frame") && i + 1 < argc)
+      log_frame = std::atol(argv[++i]);
+    else if ((arg == "-labels" || arg == "labels") && i + 1 < argc) {
+      std::string mode = argv[++i];
+      if (mode == "index")
+        label_mode = LabelMode::INDEX;
+      else if (mode == "symbol")
+        label_mode = LabelMode::SYMBOL;
+      else if (mode == "both")
+        label_mode = LabelMode::BOTH;
+      else {
+        std::cerr << "Unknown label mode: " << mode << std::endl;
+        return 1;
+      }
+    } else if (arg.size() > 4 && arg.compare(arg.size() - 4, 4, ".inp") == 0)
+      grid_files.push_back(arg);
+  }
+
+  // Several inputs: compare them side by side instead
+  if (!grid_files.empty()) {
+    grid_files.insert(grid_files.begin(), argv[1]);
+    return run_grid(grid_files, view_mode, size_set ? image_size : 160,
+                    antialias, supersample, use_ao);
   }
 
-  // Parse input file
-  InputFileData input_data = parse_inp_file(argv[1]);
+  // Parse input file, or pick a geometry out of an output log
+  InputFileData input_data;
+  if (has_log_extension(argv[1])) {
+    if (!load_log_geometry(argv[1], log_frame, input_data))
+      return 1;
+  } else {
+    input_data = parse_inp_file(argv[1]);
+  }
   if (input_data.atoms.empty()) {
     std::cerr << "No atoms found in input file." << std::endl;
     return 1;
@@ -501,14 +1613,84 @@ int main(int argc, char *argv[]) {
   std::cerr << "Loaded " << atoms.size() << " atoms ("
             << input_data.get_formula() << ")" << std::endl;
 
+  // Sanity check once, on input coordinates; shown in the info panel
+  const std::vector<GeometryIssue> geometry_issues = check_geometry(atoms);
+  if (!geometry_issues.empty())
+    std::cerr << "Geometry: " << geometry_issues.size() << " problems, first: "
+              << geometry_issues.front().message << std::endl;
+
+  std::vector<float> opacity(atoms.size(), 1.0f);
+  for (const auto &spec : opacity_specs)
+    if (!apply_opacity_spec(spec, atoms, opacity))
+      return 1;
+
+  // Selections are evaluated once, on input coordinates, before centering
+  std::vector<uint8_t> shown(atoms.size(), 1), highlighted;
+  std::string selection_status;
+  try {
+    if (!show_expr.empty()) {
+      shown = Selection(show_expr).evaluate(atoms);
+      selection_status = ", " + std::to_string(std::count(
+                                    shown.begin(), shown.end(), 1)) +
+                         " shown";
+    }
+    if (!ghost_expr.empty()) {
+      std::vector<uint8_t> ghosted = Selection(ghost_expr).evaluate(atoms);
+      for (size_t i = 0; i < atoms.size(); ++i)
+        if (ghosted[i])
+          opacity[i] = std::min(opacity[i], 0.2f);
+    }
+    if (!highlight_expr.empty()) {
+      std::vector<uint8_t> mask = Selection(highlight_expr).evaluate(atoms);
+      for (size_t i = 0; i < atoms.size(); ++i)
+        if (mask[i])
+          highlighted.push_back((uint32_t)i);
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "Selection Error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  const bool any_translucent =
+      std::any_of(opacity.begin(), opacity.end(), [](float a) { return a < 1.0f; });
+
   // Setup signal handler for clean exit
   std::signal(SIGINT, signal_handler);
   std::signal(SIGTERM, signal_handler);
 
-  // Rendering parameters
-  const int width = 256;
-  const int height = 256;
-  const int atom_radius = 12;
+  // One-time occlusion pass; the factors travel with the atoms
+  if (use_ao)
+    compute_ambient_occlusion(atoms);
+
+  // DFT grid as a point cloud (Angstrom), thinned to a drawable size. Built
+  // on the input coordinates, so it is centered with the atoms below.
+  std::vector<DftGridPoint> grid_cloud;
+  if (show_dft_grid) {
+    const DftGridOptions options = dft_grid_options(input_data);
+    const DftGrid grid = build_dft_grid(atoms, options);
+    const size_t max_dots = 40000;
+    const size_t stride = grid.points.size() / max_dots + 1;
+    const double angstrom = 0.52917721092;
+    for (size_t i = 0; i < grid.points.size(); i += stride) {
+      DftGridPoint p = grid.points[i];
+      p.x *= angstrom;
+      p.y *= angstrom;
+      p.z *= angstrom;
+      grid_cloud.push_back(p);
+    }
+    std::cerr << options.grid << " grid: " << grid.points.size()
+              << " points in " << grid.batches.size() << " batches, built in "
+              << grid.seconds << " s" << std::endl;
+  }
+
+  // Rendering parameters (atom size and padding scale with the image so
+  // smaller images look the same, just with fewer bytes per frame). In the
+  // quad layout each pane is half the image.
+  const int pane_size = quad_view ? image_size / 2 : image_size;
+  const int width = pane_size;
+  const int height = pane_size;
+  const int atom_radius = std::max(2, (int)std::lround(pane_size * 12 / 256.0));
+  const int padding = (int)std::lround(pane_size * 10 / 256.0);
 
   // Animation parameters
   // 1 rotation per 6 seconds = π/3 rad/s
@@ -533,6 +1715,11 @@ int main(int argc, char *argv[]) {
     atom.y -= cy;
     atom.z -= cz;
   }
+  for (auto &p : grid_cloud) {
+    p.x -= cx;
+    p.y -= cy;
+    p.z -= cz;
+  }
 
   // Calculate bounding box to determine proper scale
   // We need to find the max extent considering rotation (so use max of all
@@ -549,9 +1736,49 @@ int main(int argc, char *argv[]) {
 
   // Scale to fit in viewport with padding for atom radius
   // viewport_radius = half of smallest dimension minus padding
-  double viewport_radius = (std::min(width, height) / 2.0) - atom_radius - 10;
+  double viewport_radius =
+      (std::min(width, height) / 2.0) - atom_radius - padding;
   double scale = (max_extent > 0.001) ? (viewport_radius / max_extent) : 80.0;
 
+  // Spatial index for view culling, built once over the centered atoms
+  Octree octree(atoms);
+
+  // Interactive view state
+  double zoom = initial_zoom;
+  double pan_x = 0.0, pan_y = 0.0; // View-space offset in Angstrom
+
+  // Picking: the grid holds the last drawn frame, so clicks resolve against
+  // what the user actually saw. Up to four picks give distance, angle and
+  // dihedral.
+  std::vector<uint32_t> picks;
+
+  // Sprite mode needs the cell size to turn pixel positions into placements
+  int cell_w = 0, cell_h = 0;
+  if (use_sprites && quad_view) {
+    std::cerr << "Sprites are placed in a single view; -quad renders full "
+                 "frames instead."
+              << std::endl;
+    use_sprites = false;
+  }
+  if (use_sprites && !get_cell_pixel_size(cell_w, cell_h)) {
+    std::cerr << "Terminal does not report its pixel size; "
+                 "falling back to full-frame rendering."
+              << std::endl;
+    use_sprites = false;
+  }
+
+  // One sprite per distinct (element, occlusion level)
+  auto sprite_key = [&](const Atom &atom) {
+    return atom.element * AO_LEVELS + (use_ao ? ao_level(atom.ao) : 0);
+  };
+  std::array<int, (elements::MAX_Z + 1) * AO_LEVELS> sprite_ids;
+  sprite_ids.fill(-1);
+  int sprite_count = 0;
+  for (const auto &atom : atoms) {
+    if (sprite_ids[sprite_key(atom)] < 0)
+      sprite_ids[sprite_key(atom)] = SPRITE_IMAGE_ID_BASE + sprite_count++;
+  }
+
   double angle = 0.0;
   auto last_time = std::chrono::steady_clock::now();
 
@@ -562,6 +1789,80 @@ int main(int argc, char *argv[]) {
   std::cout << "\033[H";      // Move to home position
   std::cout << std::flush;
 
+  if (use_sprites) {
+    const int sprite_size = 2 * atom_radius + 1;
+    for (int key = 0; key < (int)sprite_ids.size(); ++key) {
+      if (sprite_ids[key] < 0)
+        continue;
+      std::vector<uint8_t> sprite(sprite_size * sprite_size * 4, 0);
+      Color color =
+          get_element_color(static_cast<uint8_t>(key / AO_LEVELS));
+      if (use_ao)
+        color = shade_color(color, ao_level_value(key % AO_LEVELS));
+      if (antialias) {
+        draw_circle_outline_aa(sprite, sprite_size, sprite_size,
+                               atom_radius + 0.5, atom_radius + 0.5,
+                               atom_radius, color);
+        unpremultiply_alpha(sprite);
+      } else {
+        draw_circle_outline(sprite, sprite_size, sprite_size, atom_radius,
+                            atom_radius, atom_radius, color);
+      }
+      upload_sprite(sprite, sprite_size, sprite_size, sprite_ids[key]);
+    }
+    std::cout << std::flush;
+  }
+
+  // Glyphs are rasterized once; labels are blitted from the atlas
+  const GlyphAtlas atlas(std::max(1, image_size / 256));
+
+  // Per-view scratch state, reused across frames: one viewport normally,
+  // four (XY, XZ, YZ, isometric in a 2x2 grid) in the quad layout
+  std::vector<Viewport> viewports;
+  if (quad_view) {
+    const ViewMode modes[4] = {ViewMode::XY, ViewMode::XZ, ViewMode::YZ,
+                               ViewMode::ISOMETRIC};
+    for (int k = 0; k < 4; ++k) {
+      viewports.emplace_back();
+      viewports.back().mode = modes[k];
+      viewports.back().x0 = (k % 2) * width;
+      viewports.back().y0 = (k / 2) * height;
+    }
+  } else {
+    viewports.emplace_back();
+    viewports.back().mode = view_mode;
+  }
+  std::vector<uint8_t> frame; // Quad composite
+
+  // Display frame at right side of screen
+  // Assuming 40 columns for text on left, image starts at column 42
+  const int text_columns = 42;
+
+  // Output of a running job, followed frame by frame
+  std::unique_ptr<OutputFollower> monitor;
+  ScfLog scf_log;
+  const double scf_tolerance =
+      scf_accuracy(input_data.get_parameter("SCF", "ACCURACY"));
+  if (!monitor_path.empty())
+    monitor = std::make_unique<OutputFollower>(monitor_path);
+
+  // External field of an RT job, sampled once: the input does not change
+  std::vector<RtField> fields;
+  const std::vector<std::string> field_lines =
+      describe_field(input_data, text_columns - 8, fields);
+
+  // Sprite placements of atoms culled this frame must be deleted explicitly
+  std::vector<uint8_t> placed(atoms.size(), 0), placed_now(atoms.size(), 0);
+
+  enable_raw_input();
+
+  // Mapping clicks to image pixels needs the cell size
+  int mouse_cell_w = 0, mouse_cell_h = 0;
+  const bool picking =
+      raw_input && get_cell_pixel_size(mouse_cell_w, mouse_cell_h);
+  if (picking)
+    enable_mouse();
+
   while (running) {
     // Home cursor (don't clear screen - causes flickering)
     std::cout << "\033[H" << std::flush;
@@ -578,53 +1879,291 @@ int main(int argc, char *argv[]) {
     if (angle > 2.0 * M_PI)
       angle -= 2.0 * M_PI;
 
-    // Create frame buffer (transparent background)
-    std::vector<uint8_t> rgba(width * height * 4, 0);
+    // Apply pending zoom / pan keys
+    const double pan_step = 0.1 * viewport_radius / (scale * zoom);
+    for (const InputEvent &event : read_input()) {
+      switch (event.key) {
+      case Key::ZOOM_IN: zoom *= 1.25; break;
+      case Key::ZOOM_OUT: zoom = std::max(0.05, zoom / 1.25); break;
+      case Key::LEFT: pan_x += pan_step; break;
+      case Key::RIGHT: pan_x -= pan_step; break;
+      case Key::UP: pan_y -= pan_step; break;
+      case Key::DOWN: pan_y += pan_step; break;
+      case Key::RESET: zoom = initial_zoom; pan_x = pan_y = 0.0; break;
+      case Key::QUIT: running = 0; break;
+      case Key::CLEAR_PICKS: picks.clear(); break;
+      case Key::CLICK: {
+        if (!picking)
+          break;
+        // Image is anchored at (row 1, column text_columns)
+        double px, py;
+        if (mouse_pixels) {
+          px = event.x - 1 - (text_columns - 1) * mouse_cell_w;
+          py = event.y - 1;
+        } else {
+          px = (event.x - text_columns + 0.5) * mouse_cell_w;
+          py = (event.y - 0.5) * mouse_cell_h;
+        }
+        // Resolve the click against the pane it landed in
+        const Viewport *target = &viewports[0];
+        for (const Viewport &vp : viewports)
+          if (px >= vp.x0 && px < vp.x0 + width && py >= vp.y0 &&
+              py < vp.y0 + height)
+            target = &vp;
+        long hit = target->pick_grid.pick(px - target->x0, py - target->y0);
+        if (hit < 0)
+          break;
+        auto it = std::find(picks.begin(), picks.end(), (uint32_t)hit);
+        if (it != picks.end())
+          picks.erase(it); // Clicking a picked atom deselects it
+        else {
+          if (picks.size() == 4)
+            picks.erase(picks.begin());
+          picks.push_back((uint32_t)hit);
+        }
+        break;
+      }
+      }
+    }
 
-    // Transform and project atoms
-    struct ProjectedAtom {
-      int x, y;
-      double z;
-      Color color;
+    // Camera view, animation rotation (around Y-axis), zoom and pan. In the
+    // quad layout only the isometric pane spins; the axis panes stay put.
+    const double view_scale = scale * zoom;
+    auto viewport_transform = [&](const Viewport &vp) {
+      const bool spin = !quad_view || vp.mode == ViewMode::ISOMETRIC;
+      return make_view(vp.mode, spin ? angle : 0.0, view_scale,
+                       width / 2.0 + pan_x * view_scale,
+                       height / 2.0 - pan_y * view_scale);
     };
-    std::vector<ProjectedAtom> projected;
 
-    for (const auto &atom : atoms) {
-      Vec3 pos = {atom.x, atom.y, atom.z};
+    // Cull, project, sort and (unless sprites are placed instead) rasterize
+    // one viewport into vp.rgba. Viewports share only read-only state, so
+    // the quad layout renders them on separate threads.
+    auto render_viewport = [&](Viewport &vp) {
+      const ViewTransform view = viewport_transform(vp);
+      std::vector<ProjectedAtom> &projected = vp.projected;
+
+      // Cull whole octree nodes outside the image (and optionally hidden
+      // behind nearer atoms) before touching individual atoms
+      octree.collect_visible(atoms, view, width, height, atom_radius,
+                             occlusion_culling ? &vp.depth_pyramid : nullptr,
+                             vp.visible);
+
+      // Transform and project atoms
+      projected.clear();
+      projected.reserve(vp.visible.size());
+      for (uint32_t i : vp.visible) {
+        if (!shown[i])
+          continue;
+        const Atom &atom = atoms[i];
 
-      // Apply initial camera view transformation
-      Vec3 viewed = apply_camera_view(pos, view_mode);
+        // Orthographic projection (simple x, y mapping, Y flipped)
+        Vec3 p = view.project(atom.x, atom.y, atom.z);
+        if (p.x + atom_radius < 0 || p.x - atom_radius > width ||
+            p.y + atom_radius < 0 || p.y - atom_radius > height)
+          continue;
 
-      // Apply animation rotation (around Y-axis)
-      Vec3 rotated = rotate_y(viewed, angle);
+        Color color = get_element_color(atom.element);
+        if (use_ao)
+          color = shade_color(color, atom.ao);
+        projected.push_back({p.x, p.y, p.z, color, i});
+      }
 
-      // Orthographic projection (simple x, y mapping)
-      int screen_x = static_cast<int>(width / 2.0 + rotated.x * scale);
-      int screen_y =
-          static_cast<int>(height / 2.0 - rotated.y * scale); // Flip Y
+      if (picking)
+        vp.pick_grid.build(projected, width, height, atom_radius);
+
+      // Sort by depth (back to front)
+      std::sort(projected.begin(), projected.end(),
+                [](const ProjectedAtom &a, const ProjectedAtom &b) {
+                  return a.z < b.z; // Draw far atoms first
+                });
+
+      if (use_sprites)
+        return;
+
+      // Create frame buffer (transparent background), at the supersampled
+      // resolution if requested
+      const int ss = supersample;
+      std::vector<uint8_t> &rgba = vp.rgba;
+      rgba.assign((size_t)width * ss * height * ss * 4, 0);
+
+      // Grid points first, one faint pixel each in the owning atom's color
+      for (const DftGridPoint &g : grid_cloud) {
+        Vec3 p = view.project(g.x, g.y, g.z);
+        const int x = (int)(p.x * ss), y = (int)(p.y * ss);
+        if (x < 0 || y < 0 || x >= width * ss || y >= height * ss)
+          continue;
+        blend_pixel(&rgba[((size_t)y * width * ss + x) * 4],
+                    get_element_color(atoms[g.atom].element), 60);
+      }
 
-      projected.push_back(
-          {screen_x, screen_y, rotated.z, get_element_color(atom.element)});
-    }
+      // Draw atoms
+      if (!any_translucent || projected.empty()) {
+        for (const auto &p : projected) {
+          if (antialias)
+            draw_circle_outline_aa(rgba, width * ss, height * ss, p.x * ss,
+                                   p.y * ss, atom_radius * ss, p.color, ss);
+          else
+            draw_circle_outline(rgba, width * ss, height * ss, (int)p.x * ss,
+                                (int)p.y * ss, atom_radius * ss, p.color);
+        }
+      } else {
+        // Opaque atoms draw normally and record depth; translucent ones
+        // accumulate in any order and are resolved in one pass
+        vp.oit.reset(width * ss, height * ss);
+        const double z_far = projected.front().z;
+        const double z_range =
+            std::max(1e-6, projected.back().z - projected.front().z);
+        for (const auto &p : projected) {
+          const float alpha = opacity[p.index];
+          const float z = static_cast<float>(p.z);
+          if (alpha >= 1.0f) {
+            // Hard-edged (-noaa) rings keep the pixels the translucent path
+            // would, so both hide what is behind them the same way
+            for_each_ring_fragment(
+                width * ss, height * ss, p.x * ss, p.y * ss, atom_radius * ss,
+                ss, [&](int x, int y, double coverage) {
+                  if (!antialias)
+                    coverage = coverage >= 0.5 ? 1.0 : 0.0;
+                  if (coverage <= 0.0)
+                    return;
+                  blend_pixel(&rgba[((size_t)y * width * ss + x) * 4],
+                              p.color, (int)(coverage * 255 + 0.5));
+                  vp.oit.write_depth(x, y, z);
+                });
+          } else if (alpha > 0.0f) {
+            const float far = 1.0f - static_cast<float>((p.z - z_far) / z_range);
+            for_each_ring_fragment(
+                width * ss, height * ss, p.x * ss, p.y * ss, atom_radius * ss,
+                ss, [&](int x, int y, double coverage) {
+                  if (!antialias)
+                    coverage = coverage >= 0.5 ? 1.0 : 0.0;
+                  if (coverage > 0.0)
+                    vp.oit.add(x, y, p.color, alpha * (float)coverage, z,
+                               far);
+                });
+          }
+        }
+        composite_oit(vp.oit, rgba);
+      }
+
+      // Ring atoms matched by -highlight, then the picks on top
+      const Color selected = {0, 200, 255};
+      for (uint32_t i : highlighted) {
+        if (!shown[i])
+          continue;
+        Vec3 p = view.project(atoms[i].x, atoms[i].y, atoms[i].z);
+        draw_circle_outline_aa(rgba, width * ss, height * ss, p.x * ss,
+                               p.y * ss, (atom_radius + 2) * ss, selected,
+                               1.5 * ss);
+      }
 
-    // Sort by depth (back to front)
-    std::sort(projected.begin(), projected.end(),
-              [](const ProjectedAtom &a, const ProjectedAtom &b) {
-                return a.z < b.z; // Draw far atoms first
-              });
+      // Highlight picked atoms with a wider ring
+      const Color highlight = {255, 215, 0};
+      for (uint32_t i : picks) {
+        Vec3 p = view.project(atoms[i].x, atoms[i].y, atoms[i].z);
+        draw_circle_outline_aa(rgba, width * ss, height * ss, p.x * ss,
+                               p.y * ss, (atom_radius + 3) * ss, highlight,
+                               2.0 * ss);
+      }
 
-    // Draw atoms
-    for (const auto &p : projected) {
-      draw_circle_outline(rgba, width, height, p.x, p.y, atom_radius, p.color);
-    }
+      // Field polarization over everything else
+      if (!fields.empty()) {
+        ViewTransform supersampled = view;
+        supersampled.scale *= ss;
+        supersampled.ox *= ss;
+        supersampled.oy *= ss;
+        draw_field_arrows(rgba, width * ss, height * ss, supersampled, fields,
+                          0.35 * std::min(width, height) * ss, 2.0 * ss);
+      }
+
+      if (ss > 1) {
+        std::vector<uint8_t> filtered;
+        downsample_box(rgba, width, height, ss, filtered);
+        rgba.swap(filtered);
+      }
+
+      // Labels go on at the final resolution so glyphs stay crisp
+      vp.labeled = false;
+      if (label_mode != LabelMode::NONE || picks.size() >= 2) {
+        vp.near_to_far.clear();
+        for (auto it = projected.rbegin(); it != projected.rend(); ++it)
+          vp.near_to_far.push_back((uint32_t)it->index);
+        vp.labeled = draw_labels(rgba, width, height, atlas, vp.label_grid,
+                                 atoms, view, vp.near_to_far, picks,
+                                 label_mode, atom_radius);
+      }
+    };
 
-    // Display frame at right side of screen
-    // Assuming 40 columns for text on left, image starts at column 42
-    int text_columns = 42;
-    display_frame(rgba, width, height, text_columns);
+    if (quad_view) {
+      // Panes on the shared pool, this thread included
+      parallel_for(viewports.size(),
+                   [&](size_t k) { render_viewport(viewports[k]); });
+
+      // Copy the panes into one 2x2 image, title them and draw the dividers
+      const int frame_w = 2 * width, frame_h = 2 * height;
+      frame.assign((size_t)frame_w * frame_h * 4, 0);
+      const Color divider = {90, 90, 90};
+      const Color title = {160, 160, 160};
+      for (const Viewport &vp : viewports) {
+        for (int y = 0; y < height; ++y)
+          std::memcpy(&frame[((size_t)(vp.y0 + y) * frame_w + vp.x0) * 4],
+                      &vp.rgba[(size_t)y * width * 4], (size_t)width * 4);
+        atlas.draw(frame, frame_w, frame_h, vp.x0 + 2, vp.y0 + 2,
+                   view_mode_name(vp.mode), title);
+      }
+      for (int i = 0; i < frame_w; ++i) {
+        blend_pixel(&frame[((size_t)height * frame_w + i) * 4], divider, 255);
+        blend_pixel(&frame[((size_t)i * frame_w + width) * 4], divider, 255);
+      }
+      unpremultiply_alpha(frame);
+      display_frame(frame, frame_w, frame_h, text_columns);
+    } else {
+      Viewport &vp = viewports[0];
+      render_viewport(vp);
+      const std::vector<ProjectedAtom> &projected = vp.projected;
+      if (use_sprites) {
+        // Depth rank doubles as z-index so nearer atoms stack on top
+        for (size_t rank = 0; rank < projected.size(); ++rank) {
+          const auto &p = projected[rank];
+          place_sprite(sprite_ids[sprite_key(atoms[p.index])],
+                       (int)p.index + 1, (int)p.x - atom_radius,
+                       (int)p.y - atom_radius, (int)rank, text_columns,
+                       cell_w, cell_h);
+          placed_now[p.index] = 1;
+        }
+        for (size_t i = 0; i < atoms.size(); ++i) {
+          if (placed[i] && !placed_now[i])
+            delete_placement(sprite_ids[sprite_key(atoms[i])], (int)i + 1);
+          placed[i] = placed_now[i];
+          placed_now[i] = 0;
+        }
+        std::cout << std::flush;
+      } else {
+        if (antialias || supersample > 1 || any_translucent ||
+            !picks.empty() || !highlighted.empty() || vp.labeled ||
+            !grid_cloud.empty() || !fields.empty())
+          unpremultiply_alpha(vp.rgba);
+        display_frame(vp.rgba, width, height, text_columns);
+      }
+    }
 
     // Display info panel on left side
-    display_info_panel(input_data, text_columns);
+    size_t in_view = 0;
+    for (const Viewport &vp : viewports)
+      in_view = std::max(in_view, vp.projected.size());
+    std::string status = "Zoom " + std::to_string((int)std::lround(zoom * 100)) +
+                         "%, " + std::to_string(in_view) + "/" +
+                         std::to_string(atoms.size()) + " atoms in view" +
+                         selection_status;
+    std::vector<std::string> scf_lines;
+    if (monitor) {
+      monitor->poll(scf_log); // Only the bytes appended since the last frame
+      scf_lines = describe_scf(scf_log, text_columns - 8, scf_tolerance);
+    }
+    display_info_panel(input_data, text_columns, status,
+                       describe_picks(atoms, picks, {cx, cy, cz}),
+                       geometry_issues, scf_lines, field_lines);
 
     // Frame timing
     auto frame_end = std::chrono::steady_clock::now();
@@ -635,7 +2174,13 @@ int main(int argc, char *argv[]) {
   }
 
   // Cleanup
-  clear_graphics();
+  if (picking)
+    disable_mouse();
+  restore_input();
+  if (use_sprites)
+    clear_sprites(sprite_count);
+  else
+    clear_graphics();
   std::cout << "\033[?25h"; // Show cursor
   std::cout
       << "\033[?1049l"; // Exit alternate screen (restores original terminal)
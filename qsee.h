@@ -0,0 +1,116 @@
+#ifndef QSEE_H
+#define QSEE_H
+
+/*
+ * libqsee: parse ChronusQ input files and render them off-screen from C (or
+ * anything with a C FFI) without spawning the viewer.
+ *
+ * Link with -lqsee (libqsee.a or libqsee.so, built by install.sh) and the C++
+ * runtime (-lstdc++ -lm -pthread when linking the static library from C).
+ *
+ * A qsee_file is immutable once opened, so one handle can be queried and
+ * rendered from several threads at once. Strings returned by the library
+ * belong to the handle and stay valid until qsee_close(). Parser warnings go
+ * to stderr, as they do in the viewer.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The shared library is built with hidden visibility; only these functions
+ * are exported */
+#if defined(__GNUC__)
+#define QSEE_EXPORT __attribute__((visibility("default")))
+#else
+#define QSEE_EXPORT
+#endif
+
+/* Bumped when a declaration below changes incompatibly */
+#define QSEE_API_VERSION 1
+
+typedef struct qsee_file qsee_file;
+
+typedef enum {
+  QSEE_VIEW_ISOMETRIC = 0,
+  QSEE_VIEW_XY = 1, /* Camera along Z */
+  QSEE_VIEW_XZ = 2, /* Camera along Y */
+  QSEE_VIEW_YZ = 3  /* Camera along X */
+} qsee_view;
+
+/*
+ * Frame settings. Fields are only ever appended; `size` tells the library
+ * which ones the caller knows about, so always start from
+ * qsee_render_defaults().
+ */
+typedef struct {
+  size_t size;           /* sizeof(qsee_render_options) */
+  qsee_view view;
+  double angle;          /* Turntable rotation in radians */
+  double zoom;           /* 1 fills the frame */
+  int antialias;         /* Nonzero for anti-aliased outlines (default) */
+  int supersample;       /* 1, 2 or 4 samples per pixel edge */
+  int ambient_occlusion; /* Nonzero to shade buried atoms darker */
+} qsee_render_options;
+
+/* QSEE_API_VERSION of the library actually loaded */
+QSEE_EXPORT int qsee_api_version(void);
+
+/* Message of the last failed call on this thread, "" if none; valid until
+ * the next call that fails */
+QSEE_EXPORT const char *qsee_last_error(void);
+
+/* Parse an input file; NULL if it cannot be read (see qsee_last_error) */
+QSEE_EXPORT qsee_file *qsee_open(const char *path);
+QSEE_EXPORT void qsee_close(qsee_file *file);
+
+/* --- Molecule --- */
+QSEE_EXPORT size_t qsee_atom_count(const qsee_file *file);
+
+/* Atomic number (0 if unknown) and position in Angstrom of atom `index`
+ * (0-based). Either output may be NULL. Returns 0, or -1 if out of range. */
+QSEE_EXPORT int qsee_atom(const qsee_file *file, size_t index, int *z,
+                          double xyz[3]);
+
+QSEE_EXPORT int qsee_charge(const qsee_file *file);
+QSEE_EXPORT int qsee_multiplicity(const qsee_file *file);
+/* e.g. "CH4O" */
+QSEE_EXPORT const char *qsee_formula(const qsee_file *file);
+/* First comment line */
+QSEE_EXPORT const char *qsee_title(const qsee_file *file);
+
+/* --- Keys --- */
+
+/* Value of SECTION.KEY, case-insensitive, after the chronusq: directive is
+ * applied; NULL if unset. Keys outside any section use section "GLOBAL". */
+QSEE_EXPORT const char *qsee_get(const qsee_file *file, const char *section,
+                                 const char *key);
+
+/* All keys in file order: count, then each by index. Outputs may be NULL.
+ * Returns 0, or -1 if out of range. */
+QSEE_EXPORT size_t qsee_key_count(const qsee_file *file);
+QSEE_EXPORT int qsee_key(const qsee_file *file, size_t index,
+                         const char **section, const char **key,
+                         const char **value);
+
+/* --- Rendering --- */
+QSEE_EXPORT void qsee_render_defaults(qsee_render_options *options);
+
+/*
+ * Render the molecule into a caller-supplied buffer of `height` rows of
+ * `stride` bytes (at least 4 * width), as 8-bit RGBA with straight alpha on
+ * a transparent background. `options` may be NULL for the defaults.
+ * Returns 0, or -1 on a bad argument (see qsee_last_error).
+ */
+QSEE_EXPORT int qsee_render(const qsee_file *file,
+                            const qsee_render_options *options, uint8_t *rgba,
+                            int width, int height, size_t stride);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* QSEE_H */